@@ -310,10 +310,7 @@ void BestPractices::PreCallRecordCmdEndRenderPass(VkCommandBuffer commandBuffer,
     }
 
     // Add Deferred Queue
-    cb_state->queue_submit_functions.insert(cb_state->queue_submit_functions.end(),
-                                            cb_state->queue_submit_functions_after_render_pass.begin(),
-                                            cb_state->queue_submit_functions_after_render_pass.end());
-    cb_state->queue_submit_functions_after_render_pass.clear();
+    cb_state->queue_submit_functions.Splice(cb_state->queue_submit_functions_after_render_pass);
 }
 
 void BestPractices::PreCallRecordCmdEndRenderPass2(VkCommandBuffer commandBuffer, const VkSubpassEndInfo* pSubpassInfo,
@@ -326,10 +323,7 @@ void BestPractices::PreCallRecordCmdEndRenderPass2(VkCommandBuffer commandBuffer
     }
 
     // Add Deferred Queue
-    cb_state->queue_submit_functions.insert(cb_state->queue_submit_functions.end(),
-                                            cb_state->queue_submit_functions_after_render_pass.begin(),
-                                            cb_state->queue_submit_functions_after_render_pass.end());
-    cb_state->queue_submit_functions_after_render_pass.clear();
+    cb_state->queue_submit_functions.Splice(cb_state->queue_submit_functions_after_render_pass);
 }
 
 void BestPractices::PreCallRecordCmdEndRenderPass2KHR(VkCommandBuffer commandBuffer, const VkSubpassEndInfoKHR* pSubpassInfo,
@@ -0,0 +1,133 @@
+/* Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace vvl {
+
+// Simple bump allocator. Memory is only given back all at once, objects placed in the arena are never destroyed by it.
+//
+// Reset() rewinds the arena but keeps the blocks the largest recent cycle needed, so an owner that fills the arena with about
+// the same amount of data every cycle (e.g. a command buffer re-recorded each frame) stops allocating after the first cycle,
+// and one that alternates between big and small cycles doesn't keep regrowing. The number of blocks kept decays towards
+// what the cycles actually use, so a single huge cycle doesn't pin its blocks forever. Blocks made for oversized requests
+// are freed.
+class BumpArena {
+  public:
+    static constexpr size_t kDefaultBlockSize = 4096;
+
+    explicit BumpArena(size_t block_size = kDefaultBlockSize) : block_size_(block_size) {}
+    BumpArena(const BumpArena &) = delete;
+    BumpArena &operator=(const BumpArena &) = delete;
+
+    void *Allocate(size_t size, size_t alignment) {
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        uintptr_t aligned = AlignUp(cursor_, alignment);
+        if (aligned + size > end_) {
+            // Oversized requests get a block of their own so the current block can keep being used
+            const size_t needed = size + alignment - 1;
+            if (needed > block_size_) {
+                auto &block = large_blocks_.emplace_back(new std::byte[needed]);
+                large_block_bytes_ += needed;
+                return reinterpret_cast<void *>(AlignUp(reinterpret_cast<uintptr_t>(block.get()), alignment));
+            }
+            NextBlock();
+            aligned = AlignUp(cursor_, alignment);
+        }
+        cursor_ = aligned + size;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // Rewinds to the first block. A cycle that used more blocks than are kept raises the count right away, a smaller one
+    // lowers it by a quarter of the difference, rounded up.
+    // A cycle that allocated nothing (e.g. back to back resets) doesn't trim anything.
+    void Reset() {
+        if (used_blocks_ > 0) {
+            if (used_blocks_ >= kept_blocks_) {
+                kept_blocks_ = used_blocks_;
+            } else {
+                kept_blocks_ -= (kept_blocks_ - used_blocks_ + kKeptBlocksDecay - 1) / kKeptBlocksDecay;
+            }
+            blocks_.resize(kept_blocks_);
+        }
+        large_blocks_.clear();
+        large_block_bytes_ = 0;
+        used_blocks_ = 0;
+        cursor_ = 0;
+        end_ = 0;
+    }
+
+    // Frees every block
+    void Release() {
+        blocks_.clear();
+        kept_blocks_ = 0;
+        Reset();
+    }
+
+    // Includes the blocks made for oversized requests
+    size_t BytesReserved() const { return blocks_.size() * block_size_ + large_block_bytes_; }
+
+  private:
+    static constexpr size_t kKeptBlocksDecay = 4;
+
+    static uintptr_t AlignUp(uintptr_t value, size_t alignment) {
+        return (value + (alignment - 1)) & ~(uintptr_t(alignment) - 1);
+    }
+
+    void NextBlock() {
+        if (used_blocks_ == blocks_.size()) {
+            blocks_.emplace_back(new std::byte[block_size_]);
+        }
+        cursor_ = reinterpret_cast<uintptr_t>(blocks_[used_blocks_++].get());
+        end_ = cursor_ + block_size_;
+    }
+
+    const size_t block_size_;
+    std::vector<std::unique_ptr<std::byte[]>> blocks_;
+    std::vector<std::unique_ptr<std::byte[]>> large_blocks_;
+    size_t large_block_bytes_ = 0;
+    size_t used_blocks_ = 0;
+    // Decaying maximum of the blocks used per cycle, blocks_ is trimmed to it on Reset()
+    size_t kept_blocks_ = 0;
+    uintptr_t cursor_ = 0;
+    uintptr_t end_ = 0;
+};
+
+// Deleter for objects placed in a BumpArena, only the destructor is run, the memory is reclaimed with the arena
+template <typename T>
+struct ArenaDeleter {
+    void operator()(T *object) const { object->~T(); }
+};
+
+// unique_ptr to an object placed in a BumpArena, the arena must outlive it
+template <typename T>
+using ArenaUniquePtr = std::unique_ptr<T, ArenaDeleter<T>>;
+
+template <typename T, typename... Args>
+ArenaUniquePtr<T> MakeArenaUnique(BumpArena &arena, Args &&...args) {
+    return ArenaUniquePtr<T>(new (arena.Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...));
+}
+
+}  // namespace vvl
@@ -0,0 +1,174 @@
+/* Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "containers/bump_arena.h"
+
+namespace vvl {
+
+template <typename Signature>
+class CallbackStream;
+
+// Append-only, ordered list of callables whose storage lives in a BumpArena.
+// Works like std::vector<std::function<Signature>> for emplace_back/iterate/clear, but recording a callback only bumps a
+// pointer instead of heap allocating when the captures don't fit in the std::function small buffer. Callables that are
+// trivially destructible (the common case of capturing handles and integers) are stored as plain records, no destructor
+// is run for them on clear().
+//
+// clear() only destroys the callables, the memory is reclaimed when the owner resets the arena.
+template <typename R, typename... Args>
+class CallbackStream<R(Args...)> {
+  public:
+    class Callback {
+      public:
+        R operator()(Args... args) const { return invoke_(storage_, std::forward<Args>(args)...); }
+
+      private:
+        friend class CallbackStream;
+        R (*invoke_)(void *storage, Args... args);
+        void (*copy_to_)(const void *storage, CallbackStream &dst);
+        void (*destroy_)(void *storage);  // nullptr if trivially destructible
+        void *storage_;
+        Callback *next_;
+    };
+
+    class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Callback;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Callback *;
+        using reference = const Callback &;
+
+        const_iterator() = default;
+        explicit const_iterator(const Callback *callback) : callback_(callback) {}
+        reference operator*() const { return *callback_; }
+        pointer operator->() const { return callback_; }
+        const_iterator &operator++() {
+            callback_ = callback_->next_;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        bool operator==(const const_iterator &other) const { return callback_ == other.callback_; }
+        bool operator!=(const const_iterator &other) const { return callback_ != other.callback_; }
+
+      private:
+        const Callback *callback_ = nullptr;
+    };
+    using iterator = const_iterator;
+
+    explicit CallbackStream(BumpArena &arena) : arena_(&arena) {}
+    CallbackStream(const CallbackStream &) = delete;
+    CallbackStream &operator=(const CallbackStream &) = delete;
+    ~CallbackStream() { clear(); }
+
+    template <typename F>
+    void emplace_back(F &&func) {
+        using Fn = std::decay_t<F>;
+        static_assert(std::is_invocable_r_v<R, Fn &, Args...>, "callable does not match the stream signature");
+        void *storage = arena_->Allocate(sizeof(Fn), alignof(Fn));
+        new (storage) Fn(std::forward<F>(func));
+
+        Callback *callback = new (arena_->Allocate(sizeof(Callback), alignof(Callback))) Callback();
+        callback->invoke_ = &Invoke<Fn>;
+        callback->copy_to_ = &CopyTo<Fn>;
+        callback->destroy_ = std::is_trivially_destructible_v<Fn> ? nullptr : &Destroy<Fn>;
+        callback->storage_ = storage;
+        callback->next_ = nullptr;
+
+        if (tail_) {
+            tail_->next_ = callback;
+        } else {
+            head_ = callback;
+        }
+        tail_ = callback;
+        ++size_;
+    }
+
+    // Copies every callback of other to the end of this stream, other is left untouched
+    void Append(const CallbackStream &other) {
+        assert(&other != this);
+        for (const Callback *callback = other.head_; callback; callback = callback->next_) {
+            callback->copy_to_(callback->storage_, *this);
+        }
+    }
+
+    // Moves every callback of other to the end of this stream without copying, both streams must share the same arena
+    void Splice(CallbackStream &other) {
+        assert(&other != this && other.arena_ == arena_);
+        if (!other.head_) return;
+        if (tail_) {
+            tail_->next_ = other.head_;
+        } else {
+            head_ = other.head_;
+        }
+        tail_ = other.tail_;
+        size_ += other.size_;
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+
+    void clear() {
+        for (Callback *callback = head_; callback; callback = callback->next_) {
+            if (callback->destroy_) {
+                callback->destroy_(callback->storage_);
+            }
+        }
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+    }
+
+    const_iterator begin() const { return const_iterator(head_); }
+    const_iterator end() const { return const_iterator(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+  private:
+    template <typename Fn>
+    static R Invoke(void *storage, Args... args) {
+        return (*static_cast<Fn *>(storage))(std::forward<Args>(args)...);
+    }
+    template <typename Fn>
+    static void CopyTo(const void *storage, CallbackStream &dst) {
+        dst.emplace_back(*static_cast<const Fn *>(storage));
+    }
+    template <typename Fn>
+    static void Destroy(void *storage) {
+        static_cast<Fn *>(storage)->~Fn();
+    }
+
+    BumpArena *arena_;
+    Callback *head_ = nullptr;
+    Callback *tail_ = nullptr;
+    size_t size_ = 0;
+};
+
+}  // namespace vvl
@@ -663,6 +663,9 @@ class small_container {
         return it;
     }
 
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
     bool contains(const Key &key) const {
         for (int i = 0; i < N; ++i) {
             if (small_data_allocated[i] && helper.compare_equal(small_data[i], key)) {
@@ -678,6 +681,36 @@ class small_container {
 
     typename inner_container_type::size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
 
+    iterator find(const Key &key) {
+        iterator it;
+        it.parent = this;
+        for (int i = 0; i < N; ++i) {
+            if (small_data_allocated[i] && helper.compare_equal(small_data[i], key)) {
+                it.index = i;
+                return it;
+            }
+        }
+        it.index = N;
+        // check size() first to avoid hashing key unnecessarily.
+        it.it = inner_cont.size() > 0 ? inner_cont.find(key) : inner_cont.end();
+        return it;
+    }
+
+    const_iterator find(const Key &key) const {
+        const_iterator it;
+        it.parent = this;
+        for (int i = 0; i < N; ++i) {
+            if (small_data_allocated[i] && helper.compare_equal(small_data[i], key)) {
+                it.index = i;
+                return it;
+            }
+        }
+        it.index = N;
+        // check size() first to avoid hashing key unnecessarily.
+        it.it = inner_cont.size() > 0 ? inner_cont.find(key) : inner_cont.end();
+        return it;
+    }
+
     std::pair<iterator, bool> insert(const value_type &value) {
         for (int i = 0; i < N; ++i) {
             if (small_data_allocated[i] && helper.compare_equal(small_data[i], value)) {
@@ -788,6 +821,9 @@ template <typename Key, typename T, int N = 1>
 class small_unordered_map : public small_container<Key, typename vvl::unordered_map<Key, T>::value_type, vvl::unordered_map<Key, T>,
                                                    value_type_helper_map<vvl::unordered_map<Key, T>>, N> {
   public:
+    using key_type = Key;
+    using mapped_type = T;
+
     T &operator[](const Key &key) {
         for (int i = 0; i < N; ++i) {
             if (this->small_data_allocated[i] && this->helper.compare_equal(this->small_data[i], key)) {
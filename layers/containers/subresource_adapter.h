@@ -755,6 +755,15 @@ class BothRangeMap {
         }
     }
 
+    void clear() {
+        if (SmallMode()) {
+            small_map_->clear();
+        } else {
+            assert(BigMode());
+            big_map_->clear();
+        }
+    }
+
     inline bool SmallMode() const { return BothRangeMapMode::kSmall == mode_; }
     inline bool BigMode() const { return BothRangeMapMode::kBig == mode_; }
     inline bool Tristate() const { return BothRangeMapMode::kTristate == mode_; }
@@ -797,13 +797,16 @@ bool CoreChecks::PreCallValidateGetDescriptorSetLayoutSupportKHR(VkDevice device
     return PreCallValidateGetDescriptorSetLayoutSupport(device, pCreateInfo, pSupport, error_obj);
 }
 
-// Validate that the state of this set is appropriate for the given bindings and dynamic_offsets at Draw time
+// Validate that the state of this set is appropriate for the given bindings at Draw time
 //  This includes validating that all descriptors in the given bindings are updated,
-//  that any update buffers are valid, and that any dynamic offsets are within the bounds of their buffers.
+//  and that any update buffers are valid.
+//  Dynamic offsets are not looked at here, they are range checked when bound in vkCmdBindDescriptorSets.
 // Return true if state is acceptable, or false and write an error message into error string
-bool CoreChecks::ValidateDrawState(const DescriptorSet &descriptor_set, uint32_t set_index, const BindingVariableMap &bindings,
-                                   const std::vector<uint32_t> &dynamic_offsets, const vvl::CommandBuffer &cb_state,
-                                   const Location &loc, const vvl::DrawDispatchVuid &vuids) const {
+bool CoreChecks::ValidateDrawState(const DescriptorSet &descriptor_set, uint32_t set_index,
+                                   vvl::span<const DescriptorRequirementTable::Binding> bindings,
+                                   vvl::StateObject::IdType requirements_id, const vvl::CommandBuffer &cb_state,
+                                   const Location &loc, const vvl::DrawDispatchVuid &vuids,
+                                   std::optional<uint64_t> validated_change_count) const {
     bool result = false;
     VkFramebuffer framebuffer = cb_state.activeFramebuffer ? cb_state.activeFramebuffer->VkHandle() : VK_NULL_HANDLE;
     // NOTE: GPU-AV needs non-const state objects to do lazy updates of descriptor state of only the dynamically used
@@ -812,23 +815,48 @@ bool CoreChecks::ValidateDrawState(const DescriptorSet &descriptor_set, uint32_t
     const vvl::DescriptorValidator desc_val(const_cast<CoreChecks &>(*this), const_cast<vvl::CommandBuffer &>(cb_state),
                                             const_cast<DescriptorSet &>(descriptor_set), set_index, framebuffer, loc);
 
-    for (const auto &binding_pair : bindings) {
-        const auto *binding = descriptor_set.GetBinding(binding_pair.first);
+    // Another command buffer may have already validated the command buffer independent bindings of this set
+    const DescriptorSet::DrawValidationKey validation_key{requirements_id, set_index, descriptor_set.GetChangeCount(),
+                                                         cb_state.unprotected};
+    const bool independent_validated = descriptor_set.HasValidatedDrawState(validation_key);
+    bool independent_skip = false;
+
+    std::vector<vvl::IndexRange> ranges;
+    for (const auto &binding_requirement : bindings) {
+        const vvl::DescriptorBindingInfo &binding_info = binding_requirement.info;
+        const auto *binding = descriptor_set.GetBinding(binding_info.first);
         if (!binding) {  //  End at construction is the condition for an invalid binding.
             auto set = descriptor_set.Handle();
             result |= LogError(vuids.descriptor_buffer_bit_set_08114, set, loc, "%s %s is invalid.", FormatHandle(set).c_str(),
-                               binding_pair.second.variable->DescribeDescriptor().c_str());
+                               binding_info.second[0].variable->DescribeDescriptor().c_str());
             return result;
         }
 
-        if (descriptor_set.SkipBinding(*binding, binding_pair.second.variable->is_dynamic_accessed)) {
+        if (descriptor_set.SkipBinding(*binding, binding_requirement.is_dynamic_accessed)) {
+            continue;
+        }
+        const bool independent = DescriptorSet::IsCommandBufferIndependent(binding->descriptor_class);
+        if (independent && independent_validated) {
             continue;
         }
-        vvl::DescriptorBindingInfo binding_info;
-        binding_info.first = binding_pair.first;
-        binding_info.second.emplace_back(binding_pair.second);
+        ranges.clear();
+        binding->GetDirtyRanges(validated_change_count, ranges);
+        if (ranges.empty()) {
+            continue;
+        }
+        bool binding_skip = false;
+        for (const auto &range : ranges) {
+            binding_skip |= desc_val.ValidateBinding(binding_info, *binding, range);
+        }
+        result |= binding_skip;
+        if (independent) {
+            independent_skip |= binding_skip;
+        }
+    }
 
-        result |= desc_val.ValidateBinding(binding_info, *binding);
+    // Only a full pass can vouch for every descriptor of the set
+    if (!validated_change_count && !independent_validated && !independent_skip) {
+        descriptor_set.SetValidatedDrawState(validation_key);
     }
     return result;
 }
@@ -1431,99 +1459,99 @@ vvl::DecodedTemplateUpdate::DecodedTemplateUpdate(const ValidationStateTracker &
                                                   const vvl::DescriptorUpdateTemplate *template_state, const void *pData,
                                                   VkDescriptorSetLayout push_layout) {
     auto const &create_info = template_state->create_info;
-    inline_infos.resize(create_info.descriptorUpdateEntryCount);  // Make sure we have one if we need it
-    inline_infos_khr.resize(create_info.descriptorUpdateEntryCount);
-    inline_infos_nv.resize(create_info.descriptorUpdateEntryCount);
-    desc_writes.reserve(create_info.descriptorUpdateEntryCount);  // emplaced, so reserved without initialization
-    VkDescriptorSetLayout effective_dsl = create_info.templateType == VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET
-                                              ? create_info.descriptorSetLayout
-                                              : push_layout;
-    auto ds_layout_state = device_data.Get<vvl::DescriptorSetLayout>(effective_dsl);
-    if (!ds_layout_state) return;
-
-    // Create a WriteDescriptorSet struct for each template update entry
-    for (uint32_t i = 0; i < create_info.descriptorUpdateEntryCount; i++) {
-        auto binding_count = ds_layout_state->GetDescriptorCountFromBinding(create_info.pDescriptorUpdateEntries[i].dstBinding);
-        auto binding_being_updated = create_info.pDescriptorUpdateEntries[i].dstBinding;
-        auto dst_array_element = create_info.pDescriptorUpdateEntries[i].dstArrayElement;
-
-        desc_writes.reserve(desc_writes.size() + create_info.pDescriptorUpdateEntries[i].descriptorCount);
-        for (uint32_t j = 0; j < create_info.pDescriptorUpdateEntries[i].descriptorCount; j++) {
-            desc_writes.emplace_back();
-            auto &write_entry = desc_writes.back();
-
-            size_t offset = create_info.pDescriptorUpdateEntries[i].offset + j * create_info.pDescriptorUpdateEntries[i].stride;
-            char *update_entry = (char *)(pData) + offset;
-
-            if (dst_array_element >= binding_count) {
-                dst_array_element = 0;
-                binding_being_updated = ds_layout_state->GetNextValidBinding(binding_being_updated);
+    // Descriptor set templates were decoded against their layout at creation time, push templates depend on the bound layout
+    TemplateWriteEntries push_write_entries;
+    if (create_info.templateType != VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET) {
+        auto ds_layout_state = device_data.Get<vvl::DescriptorSetLayout>(push_layout);
+        if (!ds_layout_state) return;
+        DecodeTemplateWriteEntries(create_info, *ds_layout_state, push_write_entries);
+    }
+    const TemplateWriteEntries &write_entries =
+        create_info.templateType == VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET ? template_state->write_entries
+                                                                                       : push_write_entries;
+
+    // Size the pNext storage up front, the writes point into it
+    uint32_t inline_count = 0;
+    uint32_t inline_khr_count = 0;
+    uint32_t inline_nv_count = 0;
+    for (const auto &entry : write_entries) {
+        inline_count += (entry.descriptor_type == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK) ? 1 : 0;
+        inline_khr_count += (entry.descriptor_type == VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR) ? 1 : 0;
+        inline_nv_count += (entry.descriptor_type == VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV) ? 1 : 0;
+    }
+    inline_infos.resize(inline_count);
+    inline_infos_khr.resize(inline_khr_count);
+    inline_infos_nv.resize(inline_nv_count);
+    desc_writes.resize(static_cast<uint32_t>(write_entries.size()));
+
+    inline_count = 0;
+    inline_khr_count = 0;
+    inline_nv_count = 0;
+    // Create a WriteDescriptorSet struct for each decoded template write
+    for (size_t i = 0; i < write_entries.size(); i++) {
+        const auto &entry = write_entries[i];
+        auto &write_entry = desc_writes[static_cast<uint32_t>(i)];
+        char *update_entry = (char *)(pData) + entry.offset;
+
+        write_entry.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write_entry.pNext = NULL;
+        write_entry.dstSet = descriptorSet;
+        write_entry.dstBinding = entry.dst_binding;
+        write_entry.dstArrayElement = entry.dst_array_element;
+        write_entry.descriptorCount = entry.descriptor_count;
+        write_entry.descriptorType = entry.descriptor_type;
+
+        switch (entry.descriptor_type) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                write_entry.pImageInfo = reinterpret_cast<VkDescriptorImageInfo *>(update_entry);
+                break;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                write_entry.pBufferInfo = reinterpret_cast<VkDescriptorBufferInfo *>(update_entry);
+                break;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                write_entry.pTexelBufferView = reinterpret_cast<VkBufferView *>(update_entry);
+                break;
+            case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT: {
+                VkWriteDescriptorSetInlineUniformBlock *inline_info = &inline_infos[inline_count++];
+                inline_info->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_INLINE_UNIFORM_BLOCK_EXT;
+                inline_info->pNext = nullptr;
+                // descriptorCount must match the dataSize member of the VkWriteDescriptorSetInlineUniformBlock structure
+                inline_info->dataSize = entry.descriptor_count;
+                inline_info->pData = update_entry;
+                write_entry.pNext = inline_info;
+                break;
             }
-
-            write_entry.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            write_entry.pNext = NULL;
-            write_entry.dstSet = descriptorSet;
-            write_entry.dstBinding = binding_being_updated;
-            write_entry.dstArrayElement = dst_array_element;
-            write_entry.descriptorCount = 1;
-            write_entry.descriptorType = create_info.pDescriptorUpdateEntries[i].descriptorType;
-
-            switch (create_info.pDescriptorUpdateEntries[i].descriptorType) {
-                case VK_DESCRIPTOR_TYPE_SAMPLER:
-                case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
-                case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
-                case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
-                case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
-                    write_entry.pImageInfo = reinterpret_cast<VkDescriptorImageInfo *>(update_entry);
-                    break;
-
-                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
-                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
-                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
-                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
-                    write_entry.pBufferInfo = reinterpret_cast<VkDescriptorBufferInfo *>(update_entry);
-                    break;
-
-                case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
-                case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
-                    write_entry.pTexelBufferView = reinterpret_cast<VkBufferView *>(update_entry);
-                    break;
-                case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT: {
-                    VkWriteDescriptorSetInlineUniformBlock *inline_info = &inline_infos[i];
-                    inline_info->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_INLINE_UNIFORM_BLOCK_EXT;
-                    inline_info->pNext = nullptr;
-                    inline_info->dataSize = create_info.pDescriptorUpdateEntries[i].descriptorCount;
-                    inline_info->pData = update_entry;
-                    write_entry.pNext = inline_info;
-                    // descriptorCount must match the dataSize member of the VkWriteDescriptorSetInlineUniformBlock structure
-                    write_entry.descriptorCount = inline_info->dataSize;
-                    // skip the rest of the array, they just represent bytes in the update
-                    j = create_info.pDescriptorUpdateEntries[i].descriptorCount;
-                    break;
-                }
-                case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR: {
-                    VkWriteDescriptorSetAccelerationStructureKHR *inline_info_khr = &inline_infos_khr[i];
-                    inline_info_khr->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
-                    inline_info_khr->pNext = nullptr;
-                    inline_info_khr->accelerationStructureCount = create_info.pDescriptorUpdateEntries[i].descriptorCount;
-                    inline_info_khr->pAccelerationStructures = reinterpret_cast<VkAccelerationStructureKHR *>(update_entry);
-                    write_entry.pNext = inline_info_khr;
-                    break;
-                }
-                case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV: {
-                    VkWriteDescriptorSetAccelerationStructureNV *inline_info_nv = &inline_infos_nv[i];
-                    inline_info_nv->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_NV;
-                    inline_info_nv->pNext = nullptr;
-                    inline_info_nv->accelerationStructureCount = create_info.pDescriptorUpdateEntries[i].descriptorCount;
-                    inline_info_nv->pAccelerationStructures = reinterpret_cast<VkAccelerationStructureNV *>(update_entry);
-                    write_entry.pNext = inline_info_nv;
-                    break;
-                }
-                default:
-                    assert(false);
-                    break;
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR: {
+                VkWriteDescriptorSetAccelerationStructureKHR *inline_info_khr = &inline_infos_khr[inline_khr_count++];
+                inline_info_khr->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+                inline_info_khr->pNext = nullptr;
+                inline_info_khr->accelerationStructureCount = entry.descriptor_count;
+                inline_info_khr->pAccelerationStructures = reinterpret_cast<VkAccelerationStructureKHR *>(update_entry);
+                write_entry.pNext = inline_info_khr;
+                break;
+            }
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV: {
+                VkWriteDescriptorSetAccelerationStructureNV *inline_info_nv = &inline_infos_nv[inline_nv_count++];
+                inline_info_nv->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_NV;
+                inline_info_nv->pNext = nullptr;
+                inline_info_nv->accelerationStructureCount = entry.descriptor_count;
+                inline_info_nv->pAccelerationStructures = reinterpret_cast<VkAccelerationStructureNV *>(update_entry);
+                write_entry.pNext = inline_info_nv;
+                break;
             }
-            dst_array_element++;
+            default:
+                assert(false);
+                break;
         }
     }
 }
@@ -19,7 +19,6 @@
  * This file deals with anything related to Phyiscal Devices, Logical Devices, or Device Queues Families, Device Masks, etc
  */
 
-#include <fstream>
 #include <vector>
 
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__GNU__)
@@ -32,6 +31,7 @@
 #include "state_tracker/image_state.h"
 #include "state_tracker/device_state.h"
 #include "state_tracker/render_pass_state.h"
+#include "state_tracker/shader_module.h"
 #include <spirv-tools/libspirv.h>
 
 bool CoreChecks::ValidateDeviceQueueFamily(uint32_t queue_family, const Location &loc, const char *vuid,
@@ -463,31 +463,40 @@ void CoreChecks::PostCreateDevice(const VkDeviceCreateInfo *pCreateInfo, const L
 
     AdjustValidatorOptions(device_extensions, enabled_features, spirv_val_options, &spirv_val_option_hash);
 
+    if (global_settings.parallel_pipeline_validation) {
+        pipeline_validation_pool = std::make_unique<vvl::ThreadPool>();
+    }
+    if (global_settings.async_spirv_validation) {
+        spirv_validation_pool = std::make_unique<vvl::ThreadPool>();
+    }
+
     // Allocate shader validation cache
     if (!disabled[shader_validation_caching] && !disabled[shader_validation] && !core_validation_cache) {
         auto tmp_path = GetTempFilePath();
-        validation_cache_path = tmp_path + "/shader_validation_cache";
+        std::string cache_suffix;
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__GNU__)
-        validation_cache_path += "-" + std::to_string(getuid());
+        cache_suffix += "-" + std::to_string(getuid());
 #endif
-        validation_cache_path += ".bin";
+        cache_suffix += ".bin";
+        validation_cache_path = tmp_path + "/shader_validation_cache" + cache_suffix;
 
-        std::vector<char> validation_cache_data;
-        std::ifstream read_file(validation_cache_path.c_str(), std::ios::in | std::ios::binary);
-
-        if (read_file) {
-            std::copy(std::istreambuf_iterator<char>(read_file), {}, std::back_inserter(validation_cache_data));
-            read_file.close();
-        } else {
-            LogInfo("WARNING-cache-file-error", device, loc,
-                    "Cannot open shader validation cache at %s for reading (it may not exist yet)", validation_cache_path.c_str());
+        // The reflection of SPIR-V seen in previous runs is restored instead of being recomputed
+        if (spirv_static_data_cache) {
+            reflection_cache_path = tmp_path + "/shader_reflection_cache" + cache_suffix;
+            spirv_static_data_cache->LoadReflection(reflection_cache_path);
         }
 
         VkValidationCacheCreateInfoEXT cacheCreateInfo = vku::InitStructHelper();
-        cacheCreateInfo.initialDataSize = validation_cache_data.size();
-        cacheCreateInfo.pInitialData = validation_cache_data.data();
+        cacheCreateInfo.initialDataSize = 0;
+        cacheCreateInfo.pInitialData = nullptr;
         cacheCreateInfo.flags = 0;
         CoreLayerCreateValidationCacheEXT(device, &cacheCreateInfo, nullptr, &core_validation_cache);
+
+        // The file is shared with other processes and only appended to, what they validated is picked up as well
+        if (!CastFromHandle<ValidationCache *>(core_validation_cache)->AttachFile(validation_cache_path)) {
+            LogInfo("WARNING-cache-file-error", device, loc, "Cannot open shader validation cache at %s",
+                    validation_cache_path.c_str());
+        }
     }
 }
 
@@ -495,41 +504,27 @@ void CoreChecks::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationC
                                             const RecordObject &record_obj) {
     if (!device) return;
 
-    StateTracker::PreCallRecordDestroyDevice(device, pAllocator, record_obj);
-
-    if (core_validation_cache) {
-        Location loc(Func::vkDestroyDevice);
-        size_t validation_cache_size = 0;
-        void *validation_cache_data = nullptr;
-
-        CoreLayerGetValidationCacheDataEXT(device, core_validation_cache, &validation_cache_size, nullptr);
+    // Runs what is still queued, the results have to be in the validation cache before it is written out. Modules that are
+    // still alive and were never used are reported before the state tracker lets go of them.
+    spirv_validation_pool.reset();
+    ReportAllPendingSpirvValidation();
 
-        validation_cache_data = (char *)malloc(sizeof(char) * validation_cache_size);
-        if (!validation_cache_data) {
-            LogInfo("WARNING-cache-memory-error", device, loc, "Validation Cache Memory Error");
-            return;
-        }
+    StateTracker::PreCallRecordDestroyDevice(device, pAllocator, record_obj);
 
-        VkResult result =
-            CoreLayerGetValidationCacheDataEXT(device, core_validation_cache, &validation_cache_size, validation_cache_data);
+    pipeline_validation_pool.reset();
 
-        if (result != VK_SUCCESS) {
-            LogInfo("WARNING-cache-retrieval-error", device, loc, "Validation Cache Retrieval Error");
-            free(validation_cache_data);
-            return;
+    if (spirv_static_data_cache && !reflection_cache_path.empty()) {
+        if (!spirv_static_data_cache->SaveReflection(reflection_cache_path)) {
+            LogInfo("WARNING-cache-write-error", device, Location(Func::vkDestroyDevice),
+                    "Cannot open shader reflection cache at %s for writing", reflection_cache_path.c_str());
         }
+    }
 
-        if (validation_cache_path.size() > 0) {
-            std::ofstream write_file(validation_cache_path.c_str(), std::ios::out | std::ios::binary);
-            if (write_file) {
-                write_file.write(static_cast<char *>(validation_cache_data), validation_cache_size);
-                write_file.close();
-            } else {
-                LogInfo("WARNING-cache-write-error", device, loc, "Cannot open shader validation cache at %s for writing",
-                        validation_cache_path.c_str());
-            }
+    if (core_validation_cache) {
+        if (!CastFromHandle<ValidationCache *>(core_validation_cache)->FlushToFile()) {
+            LogInfo("WARNING-cache-write-error", device, Location(Func::vkDestroyDevice),
+                    "Cannot write to shader validation cache at %s", validation_cache_path.c_str());
         }
-        free(validation_cache_data);
         CoreLayerDestroyValidationCacheEXT(device, core_validation_cache, NULL);
     }
 }
@@ -681,6 +676,10 @@ VkResult CoreChecks::CoreLayerCreateValidationCacheEXT(VkDevice device, const Vk
 
 void CoreChecks::CoreLayerDestroyValidationCacheEXT(VkDevice device, VkValidationCacheEXT validationCache,
                                                     const VkAllocationCallbacks *pAllocator) {
+    // spirv-val still running on the pool may be about to insert into this cache
+    if (spirv_validation_pool) {
+        spirv_validation_pool->WaitIdle();
+    }
     delete CastFromHandle<ValidationCache *>(validationCache);
 }
 
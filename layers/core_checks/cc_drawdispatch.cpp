@@ -1359,9 +1359,9 @@ bool CoreChecks::ValidateActionStateDescriptorsPipeline(const LastBound &last_bo
                          last_bound_state.DescribeNonCompatibleSet(pipeline.max_active_slot, *pipeline_layout).c_str());
     } else {
         // if the bound set is not compatible, the rest will just be extra redundant errors
-        for (const auto &set_binding_pair : pipeline.active_slots) {
+        for (const auto &set_requirements : pipeline.descriptor_requirements.sets) {
             std::string error_string;
-            uint32_t set_index = set_binding_pair.first;
+            uint32_t set_index = set_requirements.set;
             const auto set_info = last_bound_state.per_set[set_index];
             if (!set_info.bound_descriptor_set) {
                 skip |= LogError(vuid.compatible_pipeline_08600, cb_state.GetObjectList(bind_point), vuid.loc(),
@@ -1385,22 +1385,22 @@ bool CoreChecks::ValidateActionStateDescriptorsPipeline(const LastBound &last_bo
                 ASSERT_AND_CONTINUE(descriptor_set);
                 // Validate the draw-time state for this descriptor set
                 // We can skip validating the descriptor set if "nothing" has changed since the last validation.
-                // Same set, no image layout changes, and same "pipeline state" (binding_req_map). If there are
-                // any dynamic descriptors, always revalidate rather than caching the values. We currently only
-                // apply this optimization if IsManyDescriptors is true, to avoid the overhead of copying the
-                // binding_req_map which could potentially be expensive.
-                bool need_validate =
-                    // Revalidate each time if the set has dynamic offsets
-                    set_info.dynamicOffsets.size() > 0 ||
-                    // Revalidate if descriptor set (or contents) has changed
-                    set_info.validated_set != descriptor_set ||
-                    set_info.validated_set_change_count != descriptor_set->GetChangeCount() ||
+                // Same set, no image layout changes, and same "pipeline state" (binding_req_map). Dynamic offsets
+                // don't matter, draw time validation doesn't depend on them (they are checked at bind time).
+                const bool need_full_validate =
+                    // Revalidate if descriptor set or the pipeline using it has changed
+                    set_info.validated_set != descriptor_set || set_info.validated_requirements_id != pipeline.GetId() ||
                     (!disabled[image_layout_validation] &&
                      set_info.validated_set_image_layout_change_count != cb_state.image_layout_change_count);
+                // If only the contents changed, revalidate only the descriptors written since the last validation
+                const bool need_validate =
+                    need_full_validate || set_info.validated_set_change_count != descriptor_set->GetChangeCount();
 
                 if (need_validate) {
-                    skip |= ValidateDrawState(*descriptor_set, set_index, set_binding_pair.second, set_info.dynamicOffsets,
-                                              cb_state, vuid.loc(), vuid);
+                    skip |= ValidateDrawState(
+                        *descriptor_set, set_index, pipeline.descriptor_requirements.SetBindings(set_requirements),
+                        pipeline.GetId(), cb_state, vuid.loc(), vuid,
+                        need_full_validate ? std::nullopt : std::optional<uint64_t>(set_info.validated_set_change_count));
                 }
             }
         }
@@ -1427,9 +1427,9 @@ bool CoreChecks::ValidateActionStateDescriptorsShaderObject(const LastBound &las
                              last_bound_state.DescribeNonCompatibleSet(shader_state->max_active_slot, *shader_state).c_str());
         } else {
             // if the bound set is not copmatible, the rest will just be extra redundant errors
-            for (const auto &set_binding_pair : shader_state->active_slots) {
+            for (const auto &set_requirements : shader_state->descriptor_requirements.sets) {
                 std::string error_string;
-                uint32_t set_index = set_binding_pair.first;
+                uint32_t set_index = set_requirements.set;
                 const auto set_info = last_bound_state.per_set[set_index];
                 if (!set_info.bound_descriptor_set) {
                     const LogObjectList objlist(cb_state.Handle(), shader_state->Handle());
@@ -1451,20 +1451,22 @@ bool CoreChecks::ValidateActionStateDescriptorsShaderObject(const LastBound &las
                     ASSERT_AND_CONTINUE(descriptor_set);
                     // Validate the draw-time state for this descriptor set
                     // We can skip validating the descriptor set if "nothing" has changed since the last validation.
-                    // Same set, no image layout changes, and same "pipeline state" (binding_req_map). If there are
-                    // any dynamic descriptors, always revalidate rather than caching the values.
-                    bool need_validate =
-                        // Revalidate each time if the set has dynamic offsets
-                        set_info.dynamicOffsets.size() > 0 ||
-                        // Revalidate if descriptor set (or contents) has changed
-                        set_info.validated_set != descriptor_set ||
-                        set_info.validated_set_change_count != descriptor_set->GetChangeCount() ||
+                    // Same set, no image layout changes, and same "pipeline state" (binding_req_map). Dynamic offsets
+                    // don't matter, draw time validation doesn't depend on them (they are checked at bind time).
+                    const bool need_full_validate =
+                        // Revalidate if descriptor set or the shader using it has changed
+                        set_info.validated_set != descriptor_set || set_info.validated_requirements_id != shader_state->GetId() ||
                         (!disabled[image_layout_validation] &&
                          set_info.validated_set_image_layout_change_count != cb_state.image_layout_change_count);
+                    // If only the contents changed, revalidate only the descriptors written since the last validation
+                    const bool need_validate =
+                        need_full_validate || set_info.validated_set_change_count != descriptor_set->GetChangeCount();
 
                     if (need_validate) {
-                        skip |= ValidateDrawState(*descriptor_set, set_index, set_binding_pair.second, set_info.dynamicOffsets,
-                                                  cb_state, vuid.loc(), vuid);
+                        skip |= ValidateDrawState(
+                            *descriptor_set, set_index, shader_state->descriptor_requirements.SetBindings(set_requirements),
+                            shader_state->GetId(), cb_state, vuid.loc(), vuid,
+                            need_full_validate ? std::nullopt : std::optional<uint64_t>(set_info.validated_set_change_count));
                     }
                 }
             }
@@ -28,6 +28,33 @@
 #include "state_tracker/descriptor_sets.h"
 #include "state_tracker/render_pass_state.h"
 
+bool CoreChecks::ValidatePipelineCreateInfos(uint32_t count, const std::function<bool(uint32_t index)> &validate) const {
+    bool skip = false;
+    if (!pipeline_validation_pool || count < 2) {
+        for (uint32_t i = 0; i < count; i++) {
+            skip |= validate(i);
+        }
+        return skip;
+    }
+
+    // The state of every pipeline was already created, validating them only reads it
+    std::vector<std::vector<DeferredMessage>> messages(count);
+    pipeline_validation_pool->ParallelFor(count, [&validate, &messages](uint32_t i) {
+        DeferredMessageScope deferred(messages[i]);
+        validate(i);
+    });
+    // While deferred, logging returns true as if the callbacks asked to skip, so a create info that logged anything may have
+    // stopped early where serial validation would have kept going. Those are validated again here, in order, so the callbacks
+    // see the same messages and decide about skipping the same way as without the pool. Clean create infos are not revisited.
+    for (uint32_t i = 0; i < count; i++) {
+        if (!messages[i].empty()) {
+            messages[i].clear();
+            skip |= validate(i);
+        }
+    }
+    return skip;
+}
+
 bool CoreChecks::IsBeforeCtsVersion(uint32_t major, uint32_t minor, uint32_t subminor) const {
     // If VK_KHR_driver_properties is not enabled then conformance version will not be set
     if (phys_dev_props_core12.conformanceVersion.major == 0) {
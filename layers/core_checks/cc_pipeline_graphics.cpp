@@ -42,10 +42,11 @@ bool CoreChecks::PreCallValidateCreateGraphicsPipelines(VkDevice device, VkPipel
                                                                      pPipelines, error_obj, pipeline_states, chassis_state);
 
     skip |= ValidateDeviceQueueSupport(error_obj.location);
-    for (uint32_t i = 0; i < count; i++) {
+    skip |= ValidatePipelineCreateInfos(count, [&](uint32_t i) {
+        bool pipeline_skip = false;
         const Location create_info_loc = error_obj.location.dot(Field::pCreateInfos, i);
-        skip |= ValidateGraphicsPipeline(*pipeline_states[i].get(), pCreateInfos[i].pNext, create_info_loc);
-        skip |= ValidateGraphicsPipelineDerivatives(pipeline_states, i, create_info_loc);
+        pipeline_skip |= ValidateGraphicsPipeline(*pipeline_states[i].get(), pCreateInfos[i].pNext, create_info_loc);
+        pipeline_skip |= ValidateGraphicsPipelineDerivatives(pipeline_states, i, create_info_loc);
 
         // From dumping traces, we found almost all apps only create one pipeline at a time. To greatly simplify the logic, only
         // check the stateless validation in the pNext chain for the first pipeline. (The core issue is because we parse the SPIR-V
@@ -54,13 +55,14 @@ bool CoreChecks::PreCallValidateCreateGraphicsPipelines(VkDevice device, VkPipel
             uint32_t stage_count = std::min(pCreateInfos[0].stageCount, kCommonMaxGraphicsShaderStages);
             for (uint32_t stage = 0; stage < stage_count; stage++) {
                 if (chassis_state.stateless_data[stage].pipeline_pnext_module) {
-                    skip |= ValidateSpirvStateless(
+                    pipeline_skip |= ValidateSpirvStateless(
                         *chassis_state.stateless_data[stage].pipeline_pnext_module, chassis_state.stateless_data[stage],
                         create_info_loc.dot(Field::pStages, stage).pNext(Struct::VkShaderModuleCreateInfo, Field::pCode));
                 }
             }
         }
-    }
+        return pipeline_skip;
+    });
     return skip;
 }
 
@@ -175,9 +175,13 @@ bool CoreChecks::PreCallValidateCreateRayTracingPipelinesNV(VkDevice device, VkP
                                                                          pPipelines, error_obj, pipeline_states, chassis_state);
 
     skip |= ValidateDeviceQueueSupport(error_obj.location);
-    for (uint32_t i = 0; i < count; i++) {
+    skip |= ValidatePipelineCreateInfos(count, [&](uint32_t i) {
+        bool pipeline_skip = false;
         const vvl::Pipeline *pipeline = pipeline_states[i].get();
-        ASSERT_AND_CONTINUE(pipeline);
+        if (!pipeline) {
+            assert(false);
+            return pipeline_skip;
+        }
 
         const Location create_info_loc = error_obj.location.dot(Field::pCreateInfos, i);
         const auto &create_info = pipeline->RayTracingCreateInfo();
@@ -191,22 +195,24 @@ bool CoreChecks::PreCallValidateCreateRayTracingPipelinesNV(VkDevice device, VkP
                 base_pipeline = Get<vvl::Pipeline>(bph);
             }
             if (!base_pipeline || !(base_pipeline->create_flags & VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT)) {
-                skip |= LogError(
+                pipeline_skip |= LogError(
                     "VUID-vkCreateRayTracingPipelinesNV-flags-03416", device, create_info_loc,
                     "If the flags member of any element of pCreateInfos contains the "
                     "VK_PIPELINE_CREATE_DERIVATIVE_BIT flag,"
                     "the base pipeline must have been created with the VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT flag set.");
             }
         }
-        skip |= ValidateRayTracingPipeline(*pipeline, create_info, pCreateInfos[i].flags, create_info_loc);
+        pipeline_skip |= ValidateRayTracingPipeline(*pipeline, create_info, pCreateInfos[i].flags, create_info_loc);
         uint32_t stage_index = 0;
         for (const auto &stage_ci : pipeline->shader_stages_ci) {
-            skip |= ValidatePipelineShaderStage(*pipeline, stage_ci, pCreateInfos[i].pNext,
-                                                create_info_loc.dot(Field::pStages, stage_index++));
+            pipeline_skip |= ValidatePipelineShaderStage(*pipeline, stage_ci, pCreateInfos[i].pNext,
+                                                         create_info_loc.dot(Field::pStages, stage_index++));
         }
-        skip |= ValidatePipelineCacheControlFlags(pCreateInfos[i].flags, create_info_loc.dot(Field::flags),
-                                                  "VUID-VkRayTracingPipelineCreateInfoNV-pipelineCreationCacheControl-02905");
-    }
+        pipeline_skip |=
+            ValidatePipelineCacheControlFlags(pCreateInfos[i].flags, create_info_loc.dot(Field::flags),
+                                              "VUID-VkRayTracingPipelineCreateInfoNV-pipelineCreationCacheControl-02905");
+        return pipeline_skip;
+    });
     return skip;
 }
 
@@ -224,9 +230,13 @@ bool CoreChecks::PreCallValidateCreateRayTracingPipelinesKHR(VkDevice device, Vk
     skip |= ValidateDeferredOperation(device, deferredOperation, error_obj.location.dot(Field::deferredOperation),
                                       "VUID-vkCreateRayTracingPipelinesKHR-deferredOperation-03678");
 
-    for (uint32_t i = 0; i < count; i++) {
+    skip |= ValidatePipelineCreateInfos(count, [&](uint32_t i) {
+        bool pipeline_skip = false;
         const vvl::Pipeline *pipeline = pipeline_states[i].get();
-        ASSERT_AND_CONTINUE(pipeline);
+        if (!pipeline) {
+            assert(false);
+            return pipeline_skip;
+        }
 
         const Location create_info_loc = error_obj.location.dot(Field::pCreateInfos, i);
         const auto &create_info = pipeline->RayTracingCreateInfo();
@@ -240,21 +250,22 @@ bool CoreChecks::PreCallValidateCreateRayTracingPipelinesKHR(VkDevice device, Vk
                 base_pipeline = Get<vvl::Pipeline>(bph);
             }
             if (!base_pipeline || !(base_pipeline->create_flags & VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT)) {
-                skip |= LogError(
+                pipeline_skip |= LogError(
                     "VUID-vkCreateRayTracingPipelinesKHR-flags-03416", device, create_info_loc,
                     "If the flags member of any element of pCreateInfos contains the "
                     "VK_PIPELINE_CREATE_DERIVATIVE_BIT flag,"
                     "the base pipeline must have been created with the VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT flag set.");
             }
         }
-        skip |= ValidateRayTracingPipeline(*pipeline, create_info, pCreateInfos[i].flags, create_info_loc);
+        pipeline_skip |= ValidateRayTracingPipeline(*pipeline, create_info, pCreateInfos[i].flags, create_info_loc);
         uint32_t stage_index = 0;
         for (const auto &stage_ci : pipeline->shader_stages_ci) {
-            skip |= ValidatePipelineShaderStage(*pipeline, stage_ci, pCreateInfos[i].pNext,
-                                                create_info_loc.dot(Field::pStages, stage_index++));
+            pipeline_skip |= ValidatePipelineShaderStage(*pipeline, stage_ci, pCreateInfos[i].pNext,
+                                                         create_info_loc.dot(Field::pStages, stage_index++));
         }
-        skip |= ValidatePipelineCacheControlFlags(pCreateInfos[i].flags, create_info_loc.dot(Field::flags),
-                                                  "VUID-VkRayTracingPipelineCreateInfoKHR-pipelineCreationCacheControl-02905");
+        pipeline_skip |=
+            ValidatePipelineCacheControlFlags(pCreateInfos[i].flags, create_info_loc.dot(Field::flags),
+                                              "VUID-VkRayTracingPipelineCreateInfoKHR-pipelineCreationCacheControl-02905");
         if (create_info.pLibraryInfo) {
             constexpr std::array<std::pair<const char *, VkPipelineCreateFlags>, 7> vuid_map = {{
                 {"VUID-VkRayTracingPipelineCreateInfoKHR-flags-04718", VK_PIPELINE_CREATE_RAY_TRACING_SKIP_AABBS_BIT_KHR},
@@ -276,18 +287,18 @@ bool CoreChecks::PreCallValidateCreateRayTracingPipelinesKHR(VkDevice device, Vk
                 if (!lib) continue;
 
                 if ((lib->create_flags & VK_PIPELINE_CREATE_LIBRARY_BIT_KHR) == 0) {
-                    skip |= LogError("VUID-VkPipelineLibraryCreateInfoKHR-pLibraries-03381", device, library_loc,
-                                     "was created with %s.", string_VkPipelineCreateFlags2KHR(lib->create_flags).c_str());
+                    pipeline_skip |= LogError("VUID-VkPipelineLibraryCreateInfoKHR-pLibraries-03381", device, library_loc,
+                                              "was created with %s.", string_VkPipelineCreateFlags2KHR(lib->create_flags).c_str());
                 }
                 for (const auto &pair : vuid_map) {
                     if (pipeline->create_flags & pair.second) {
                         if ((lib->create_flags & pair.second) == 0) {
-                            skip |= LogError(pair.first, device, library_loc,
-                                             "was created with %s, which is missing %s included in %s (%s).",
-                                             string_VkPipelineCreateFlags2KHR(lib->create_flags).c_str(),
-                                             string_VkPipelineCreateFlags2KHR(pair.second).c_str(),
-                                             create_info_loc.dot(Field::flags).Fields().c_str(),
-                                             string_VkPipelineCreateFlags2KHR(pipeline->create_flags).c_str());
+                            pipeline_skip |= LogError(pair.first, device, library_loc,
+                                                      "was created with %s, which is missing %s included in %s (%s).",
+                                                      string_VkPipelineCreateFlags2KHR(lib->create_flags).c_str(),
+                                                      string_VkPipelineCreateFlags2KHR(pair.second).c_str(),
+                                                      create_info_loc.dot(Field::flags).Fields().c_str(),
+                                                      string_VkPipelineCreateFlags2KHR(pipeline->create_flags).c_str());
                         }
                     }
                 }
@@ -295,7 +306,7 @@ bool CoreChecks::PreCallValidateCreateRayTracingPipelinesKHR(VkDevice device, Vk
                 if (j == 0) {
                     uses_descriptor_buffer = lib->descriptor_buffer_mode;
                 } else if (uses_descriptor_buffer != lib->descriptor_buffer_mode) {
-                    skip |= LogError(
+                    pipeline_skip |= LogError(
                         "VUID-VkPipelineLibraryCreateInfoKHR-pLibraries-08096", device, library_loc,
                         "%s created with VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT which is opposite of pLibraries[0].",
                         lib->descriptor_buffer_mode ? "was" : "was not");
@@ -303,7 +314,8 @@ bool CoreChecks::PreCallValidateCreateRayTracingPipelinesKHR(VkDevice device, Vk
                 }
             }
         }
-    }
+        return pipeline_skip;
+    });
 
     return skip;
 }
@@ -487,6 +487,34 @@ bool CoreChecks::ValidateShaderStageInputOutputLimits(const spirv::Module &modul
 bool CoreChecks::ValidateInterfaceBetweenStages(const spirv::Module &producer, const spirv::EntryPoint &producer_entrypoint,
                                                 const spirv::Module &consumer, const spirv::EntryPoint &consumer_entrypoint,
                                                 const Location &create_info_loc) const {
+    // The result only depends on the two entry points and the device features, so once a pair is found to match without a
+    // single message there is no need to compare it slot by slot again. Pairs that had anything to report are not remembered,
+    // every pipeline using them needs its own message.
+    const hash_util::Hash128 pair_key{producer_entrypoint.unique_id, consumer_entrypoint.unique_id};
+    {
+        ReadLockGuard guard(matched_stage_interfaces_lock);
+        if (matched_stage_interfaces.find(pair_key) != matched_stage_interfaces.end()) {
+            return false;
+        }
+    }
+
+    bool found_issue = false;
+    const bool skip =
+        CompareStageInterfaces(producer, producer_entrypoint, consumer, consumer_entrypoint, create_info_loc, found_issue);
+    if (!found_issue) {
+        WriteLockGuard guard(matched_stage_interfaces_lock);
+        // Entries of destroyed modules are never looked up again, start over rather than letting them pile up
+        if (matched_stage_interfaces.size() >= kMaxMatchedStageInterfaces) {
+            matched_stage_interfaces.clear();
+        }
+        matched_stage_interfaces.insert(pair_key);
+    }
+    return skip;
+}
+
+bool CoreChecks::CompareStageInterfaces(const spirv::Module &producer, const spirv::EntryPoint &producer_entrypoint,
+                                        const spirv::Module &consumer, const spirv::EntryPoint &consumer_entrypoint,
+                                        const Location &create_info_loc, bool &found_issue) const {
     bool skip = false;
 
     if (producer_entrypoint.has_passthrough) {
@@ -545,6 +573,7 @@ bool CoreChecks::ValidateInterfaceBetweenStages(const spirv::Module &producer, c
                 if ((component_info.output_type != component_info.input_type) ||
                     (component_info.output_width != component_info.input_width)) {
                     const LogObjectList objlist(producer.handle(), consumer.handle());
+                    found_issue = true;
                     skip |= LogError("VUID-RuntimeSpirv-OpEntryPoint-07754", objlist, create_info_loc,
                                      "(SPIR-V Interface) Type mismatch on Location %" PRIu32 " Component %" PRIu32
                                      ", between\n\n%s stage:\n%s%s\n\n%s stage:\n%s%s\n\n",
@@ -581,6 +610,7 @@ bool CoreChecks::ValidateInterfaceBetweenStages(const spirv::Module &producer, c
                     const uint32_t input_vec_size = input_var->base_type.Word(3);
                     if (output_vec_size > input_vec_size) {
                         const LogObjectList objlist(producer.handle(), consumer.handle());
+                        found_issue = true;
                         skip |= LogError("VUID-RuntimeSpirv-maintenance4-06817", objlist, create_info_loc,
                                          "(SPIR-V Interface) starting at Location %" PRIu32 " Component %" PRIu32
                                          " the Output (%s) has a Vec%" PRIu32 " while Input (%s) as a Vec%" PRIu32
@@ -598,6 +628,7 @@ bool CoreChecks::ValidateInterfaceBetweenStages(const spirv::Module &producer, c
                 // Don't give any warning if maintenance4 with vectors
                 if (!enabled_features.maintenance4 && (output_var->base_type.Opcode() != spv::OpTypeVector)) {
                     const LogObjectList objlist(producer.handle(), consumer.handle());
+                    found_issue = true;
                     skip |= LogPerformanceWarning("WARNING-Shader-OutputNotConsumed", objlist, create_info_loc,
                                                   "(SPIR-V Interface) %s declared to output location %" PRIu32 " Component %" PRIu32
                                                   " but is not an Input declared by %s.",
@@ -612,6 +643,7 @@ bool CoreChecks::ValidateInterfaceBetweenStages(const spirv::Module &producer, c
                     break;  // When going inbetween Tessellation or Geometry, array size can be different
                 }
                 const LogObjectList objlist(producer.handle(), consumer.handle());
+                found_issue = true;
                 skip |= LogError("VUID-RuntimeSpirv-OpEntryPoint-08743", objlist, create_info_loc,
                                  "(SPIR-V Interface) %s declared input at Location %" PRIu32 " Component %" PRIu32
                                  " %sbut it is not an Output declared in %s",
@@ -673,6 +705,7 @@ bool CoreChecks::ValidateInterfaceBetweenStages(const spirv::Module &producer, c
         }
         msg << "}\n";
         const LogObjectList objlist(producer.handle(), consumer.handle());
+        found_issue = true;
         skip |= LogError("VUID-RuntimeSpirv-OpVariable-08746", objlist, create_info_loc,
                          "(SPIR-V Interface) Mismatch in BuiltIn blocks:\n %s", msg.str().c_str());
     }
@@ -890,13 +923,21 @@ bool CoreChecks::ValidateGraphicsPipelineShaderState(const vvl::Pipeline &pipeli
     // if the shader stages are no good individually, cross-stage validation is pointless.
     if (skip) return true;
 
+    // When linking, only checks that cross library boundaries are new, anything within a single library was validated when the
+    // library was created
+    const bool pre_raster_linked = pipeline.pre_raster_state && !pipeline.OwnsSubState(pipeline.pre_raster_state);
+    const bool pre_raster_and_fragment_linked =
+        pipeline.LinkedFromSameLibrary(pipeline.pre_raster_state, pipeline.fragment_shader_state);
+
     if (pipeline.vertex_input_state && vertex_stage && vertex_stage->entrypoint && vertex_stage->spirv_state &&
-        !pipeline.IsDynamic(CB_DYNAMIC_STATE_VERTEX_INPUT_EXT)) {
+        !pipeline.IsDynamic(CB_DYNAMIC_STATE_VERTEX_INPUT_EXT) &&
+        !pipeline.LinkedFromSameLibrary(pipeline.vertex_input_state, pipeline.pre_raster_state)) {
         skip |=
             ValidateInterfaceVertexInput(pipeline, *vertex_stage->spirv_state.get(), *vertex_stage->entrypoint, create_info_loc);
     }
 
-    if (pipeline.fragment_shader_state && fragment_stage && fragment_stage->entrypoint && fragment_stage->spirv_state) {
+    if (pipeline.fragment_shader_state && fragment_stage && fragment_stage->entrypoint && fragment_stage->spirv_state &&
+        !pipeline.LinkedFromSameLibrary(pipeline.fragment_shader_state, pipeline.fragment_output_state)) {
         skip |= ValidateInterfaceFragmentOutput(pipeline, *fragment_stage->spirv_state.get(), *fragment_stage->entrypoint,
                                                 create_info_loc);
     }
@@ -952,7 +993,10 @@ bool CoreChecks::ValidateGraphicsPipelineShaderState(const vvl::Pipeline &pipeli
             const std::shared_ptr<const spirv::Module> &consumer_spirv =
                 consumer.spirv_state ? consumer.spirv_state : consumer.module_state->spirv;
 
-            if (consumer_spirv && producer_spirv && consumer.entrypoint && producer.entrypoint) {
+            // Pre-raster stages always come from a single library, fragment might be linked from another one
+            const bool same_library = (consumer.GetStage() == VK_SHADER_STAGE_FRAGMENT_BIT) ? pre_raster_and_fragment_linked
+                                                                                          : pre_raster_linked;
+            if (consumer_spirv && producer_spirv && consumer.entrypoint && producer.entrypoint && !same_library) {
                 skip |= ValidateInterfaceBetweenStages(*producer_spirv.get(), *producer.entrypoint, *consumer_spirv.get(),
                                                        *consumer.entrypoint, create_info_loc);
             }
@@ -973,7 +1017,7 @@ bool CoreChecks::ValidateGraphicsPipelineShaderState(const vvl::Pipeline &pipeli
     }
 
     if (tesc_stage && tesc_stage->spirv_state && tesc_stage->entrypoint && tese_stage && tese_stage->spirv_state &&
-        tese_stage->entrypoint) {
+        tese_stage->entrypoint && !pre_raster_linked) {
         skip |= ValidatePipelineTessellationStages(*tesc_stage->spirv_state, *tesc_stage->entrypoint, *tese_stage->spirv_state,
                                                    *tese_stage->entrypoint, create_info_loc);
     }
@@ -314,8 +314,11 @@ bool CoreChecks::PreCallValidateCreateShadersEXT(VkDevice device, uint32_t creat
         }
         const Location create_info_loc = error_obj.location.dot(Field::pCreateInfos, i);
 
-        spv_const_binary_t binary{static_cast<const uint32_t*>(create_info.pCode), create_info.codeSize / sizeof(uint32_t)};
-        skip |= RunSpirvValidation(binary, create_info_loc, cache);
+        // With async_spirv_validation, PreCallRecordCreateShadersEXT hands the SPIR-V to spirv_validation_pool instead
+        if (!spirv_validation_pool) {
+            spv_const_binary_t binary{static_cast<const uint32_t*>(create_info.pCode), create_info.codeSize / sizeof(uint32_t)};
+            skip |= RunSpirvValidation(binary, create_info_loc, cache);
+        }
 
         const auto spirv = std::make_shared<spirv::Module>(create_info.codeSize, static_cast<const uint32_t*>(create_info.pCode));
         vku::safe_VkShaderCreateInfoEXT safe_create_info = vku::safe_VkShaderCreateInfoEXT(&pCreateInfos[i]);
@@ -413,6 +416,17 @@ bool CoreChecks::PreCallValidateDestroyShaderEXT(VkDevice device, VkShaderEXT sh
     return skip;
 }
 
+void CoreChecks::PreCallRecordDestroyShaderEXT(VkDevice device, VkShaderEXT shader, const VkAllocationCallbacks* pAllocator,
+                                               const RecordObject& record_obj) {
+    // Last chance to report spirv-val of a shader object that was never bound
+    if (spirv_validation_pool) {
+        if (auto shader_state = Get<vvl::ShaderObject>(shader); shader_state && shader_state->spirv) {
+            ReportPendingSpirvValidation(*shader_state->spirv);
+        }
+    }
+    StateTracker::PreCallRecordDestroyShaderEXT(device, shader, pAllocator, record_obj);
+}
+
 bool CoreChecks::PreCallValidateCmdBindShadersEXT(VkCommandBuffer commandBuffer, uint32_t stageCount,
                                                   const VkShaderStageFlagBits* pStages, const VkShaderEXT* pShaders,
                                                   const ErrorObject& error_obj) const {
@@ -433,6 +447,12 @@ bool CoreChecks::PreCallValidateCmdBindShadersEXT(VkCommandBuffer commandBuffer,
         const VkShaderStageFlagBits& stage = pStages[i];
         VkShaderEXT shader = pShaders ? pShaders[i] : VK_NULL_HANDLE;
 
+        if (spirv_validation_pool && shader != VK_NULL_HANDLE) {
+            if (const auto shader_state = Get<vvl::ShaderObject>(shader); shader_state && shader_state->spirv) {
+                skip |= ReportPendingSpirvValidation(*shader_state->spirv);
+            }
+        }
+
         for (uint32_t j = i; j < stageCount; ++j) {
             if (i != j && stage == pStages[j]) {
                 skip |= LogError("VUID-vkCmdBindShadersEXT-pStages-08463", commandBuffer, stage_loc,
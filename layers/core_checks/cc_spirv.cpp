@@ -19,6 +19,8 @@
 
 #include <cassert>
 #include <cinttypes>
+#include <condition_variable>
+#include <mutex>
 #include <spirv/unified1/spirv.hpp>
 #include <sstream>
 #include <string>
@@ -2174,6 +2176,14 @@ bool CoreChecks::ValidateShaderStage(const ShaderStageState &stage_state, const
     const spirv::Module &module_state = *stage_state.spirv_state.get();
     if (!module_state.valid_spirv) return skip;  // checked elsewhere
 
+    if (spirv_validation_pool) {
+        // The first use of the module reports what spirv-val found. Like vkCreateShaderModule being skipped, nothing else is
+        // checked if the callback asked to skip.
+        const bool spirv_val_skip = ReportPendingSpirvValidation(module_state);
+        skip |= spirv_val_skip;
+        if (spirv_val_skip) return skip;
+    }
+
     if (!stage_state.entrypoint) {
         const char *vuid = pipeline ? "VUID-VkPipelineShaderStageCreateInfo-pName-00707" : "VUID-VkShaderCreateInfoEXT-pName-08440";
         return LogError(vuid, device, loc.dot(Field::pName), "`%s` entrypoint not found for stage %s.", stage_state.GetPName(),
@@ -2482,6 +2492,24 @@ void CoreChecks::PreCallRecordCreateShaderModule(VkDevice device, const VkShader
     ValidationStateTracker::PreCallRecordCreateShaderModule(device, pCreateInfo, pAllocator, pShaderModule, record_obj,
                                                             chassis_state);
     chassis_state.skip |= ValidateSpirvStateless(*chassis_state.module_state, chassis_state.stateless_data, record_obj.location);
+
+    // Same conditions as ValidateShaderModuleCreateInfo uses to decide if pCode can be given to spirv-val
+    if (spirv_validation_pool && !disabled[shader_validation] && pCreateInfo->pCode &&
+        pCreateInfo->pCode[0] == spv::MagicNumber && SafeModulo(pCreateInfo->codeSize, 4) == 0) {
+        EnqueueSpirvValidation(pCreateInfo->pCode, pCreateInfo->codeSize, GetShaderModuleValidationCache(*pCreateInfo),
+                               record_obj.location.function, 0, chassis_state.module_state);
+    }
+}
+
+void CoreChecks::PreCallRecordDestroyShaderModule(VkDevice device, VkShaderModule shaderModule,
+                                                  const VkAllocationCallbacks *pAllocator, const RecordObject &record_obj) {
+    // Last chance to report a module that was never used
+    if (spirv_validation_pool) {
+        if (auto module_state = Get<vvl::ShaderModule>(shaderModule); module_state && module_state->spirv) {
+            ReportPendingSpirvValidation(*module_state->spirv);
+        }
+    }
+    StateTracker::PreCallRecordDestroyShaderModule(device, shaderModule, pAllocator, record_obj);
 }
 
 void CoreChecks::PreCallRecordCreateShadersEXT(VkDevice device, uint32_t createInfoCount, const VkShaderCreateInfoEXT *pCreateInfos,
@@ -2495,52 +2523,183 @@ void CoreChecks::PreCallRecordCreateShadersEXT(VkDevice device, uint32_t createI
                                                          record_obj.location.dot(Field::pCreateInfos, i));
         }
     }
+
+    if (spirv_validation_pool && !disabled[shader_validation]) {
+        // Reported when the shader object is first bound
+        ValidationCache *cache = CastFromHandle<ValidationCache *>(core_validation_cache);
+        for (uint32_t i = 0; i < createInfoCount; ++i) {
+            const VkShaderCreateInfoEXT &create_info = pCreateInfos[i];
+            if (create_info.codeType == VK_SHADER_CODE_TYPE_SPIRV_EXT && create_info.pCode && chassis_state.module_states[i]) {
+                EnqueueSpirvValidation(static_cast<const uint32_t *>(create_info.pCode), create_info.codeSize, cache,
+                                       record_obj.location.function, i, chassis_state.module_states[i]);
+            }
+        }
+    }
 }
 
-bool CoreChecks::RunSpirvValidation(spv_const_binary_t &binary, const Location &loc, ValidationCache *cache) const {
-    bool skip = false;
+// spv_context only holds the target environment and the message consumer, so rather than creating one for every shader, each
+// thread keeps its own around.
+static spv_const_context GetThreadSpirvContext(spv_target_env spirv_environment) {
+    struct ThreadContext {
+        spv_context ctx = nullptr;
+        spv_target_env env = SPV_ENV_UNIVERSAL_1_0;
+        ~ThreadContext() { spvContextDestroy(ctx); }
+    };
+    thread_local ThreadContext thread_context;
+    if (!thread_context.ctx || thread_context.env != spirv_environment) {
+        spvContextDestroy(thread_context.ctx);
+        thread_context.ctx = spvContextCreate(spirv_environment);
+        thread_context.env = spirv_environment;
+    }
+    return thread_context.ctx;
+}
 
+spv_result_t CoreChecks::RunSpirvValidator(spv_const_binary_t &binary, ValidationCache *cache, std::string &error_text) const {
     if (global_settings.debug_disable_spirv_val) {
-        return skip;
+        return SPV_SUCCESS;
     }
 
-    uint32_t hash = 0;
+    ValidationCache::Key key;
     if (cache) {
-        hash = hash_util::ShaderHash((void *)binary.code, binary.wordCount * sizeof(uint32_t));
-        if (cache->Contains(hash)) {
-            return skip;
+        key = cache->MakeKey(binary.code, binary.wordCount * sizeof(uint32_t));
+        if (cache->Contains(key)) {
+            return SPV_SUCCESS;
         }
     }
 
     // Use SPIRV-Tools validator to try and catch any issues with the module itself. If specialization constants are present,
     // the default values will be used during validation.
     spv_target_env spirv_environment = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
-    spv_context ctx = spvContextCreate(spirv_environment);
     spv_diagnostic diag = nullptr;
-    const spv_result_t spv_valid = spvValidateWithOptions(ctx, spirv_val_options, &binary, &diag);
+    const spv_result_t spv_valid =
+        spvValidateWithOptions(GetThreadSpirvContext(spirv_environment), spirv_val_options, &binary, &diag);
     if (spv_valid != SPV_SUCCESS) {
-        // VkShaderModuleCreateInfo can come from many functions
-        const char *vuid = loc.function == Func::vkCreateShadersEXT ? "VUID-VkShaderCreateInfoEXT-pCode-08737"
-                                                                    : "VUID-VkShaderModuleCreateInfo-pCode-08737";
-
-        if (spv_valid == SPV_WARNING) {
-            skip |= LogWarning(vuid, device, loc.dot(Field::pCode), "(spirv-val produced a warning):\n%s",
-                               diag && diag->error ? diag->error : "(no error text)");
-        } else {
-            skip |= LogError(vuid, device, loc.dot(Field::pCode), "(spirv-val produced an error):\n%s",
-                             diag && diag->error ? diag->error : "(no error text)");
-        }
+        error_text = diag && diag->error ? diag->error : "(no error text)";
     } else if (cache) {
         // No point to cache anything that is not valid, or it will get supressed on the next run
-        cache->Insert(hash);
+        cache->Insert(key);
     }
-
     spvDiagnosticDestroy(diag);
-    spvContextDestroy(ctx);
 
+    return spv_valid;
+}
+
+bool CoreChecks::LogSpirvValidationResult(spv_result_t result, const std::string &error_text, const Location &loc) const {
+    bool skip = false;
+    if (result == SPV_SUCCESS) {
+        return skip;
+    }
+
+    // VkShaderModuleCreateInfo can come from many functions
+    const char *vuid = loc.function == Func::vkCreateShadersEXT ? "VUID-VkShaderCreateInfoEXT-pCode-08737"
+                                                                : "VUID-VkShaderModuleCreateInfo-pCode-08737";
+    if (result == SPV_WARNING) {
+        skip |= LogWarning(vuid, device, loc.dot(Field::pCode), "(spirv-val produced a warning):\n%s", error_text.c_str());
+    } else {
+        skip |= LogError(vuid, device, loc.dot(Field::pCode), "(spirv-val produced an error):\n%s", error_text.c_str());
+    }
     return skip;
 }
 
+bool CoreChecks::RunSpirvValidation(spv_const_binary_t &binary, const Location &loc, ValidationCache *cache) const {
+    std::string error_text;
+    const spv_result_t result = RunSpirvValidator(binary, cache, error_text);
+    return LogSpirvValidationResult(result, error_text, loc);
+}
+
+// A spirv-val run on spirv_validation_pool. The worker only stores the result, it is reported from the next API call that uses
+// the module (see ReportPendingSpirvValidation)
+struct AsyncSpirvValidation {
+    std::vector<uint32_t> code;  // copy of pCode, freed once spirv-val is done
+    ValidationCache *cache = nullptr;
+    vvl::Func function = vvl::Func::Empty;
+    uint32_t create_info_index = 0;  // for vkCreateShadersEXT
+    std::weak_ptr<const spirv::Module> module_state;
+
+    std::mutex lock;
+    std::condition_variable finished_cv;
+    bool finished = false;
+    spv_result_t result = SPV_SUCCESS;
+    std::string error_text;
+};
+
+void CoreChecks::EnqueueSpirvValidation(const uint32_t *code, size_t code_size, ValidationCache *cache, vvl::Func function,
+                                        uint32_t create_info_index, const std::shared_ptr<const spirv::Module> &module_state) {
+    auto job = std::make_shared<AsyncSpirvValidation>();
+    job->code.assign(code, code + code_size / sizeof(uint32_t));
+    job->cache = cache;
+    job->function = function;
+    job->create_info_index = create_info_index;
+    job->module_state = module_state;
+    {
+        WriteLockGuard guard(pending_spirv_validation_lock);
+        pending_spirv_validation.insert_or_assign(module_state.get(), job);
+    }
+
+    spirv_validation_pool->Post([this, job]() {
+        spv_const_binary_t binary{job->code.data(), job->code.size()};
+        std::string error_text;
+        const spv_result_t result = RunSpirvValidator(binary, job->cache, error_text);
+        {
+            std::lock_guard<std::mutex> guard(job->lock);
+            job->finished = true;
+            job->result = result;
+            job->error_text = std::move(error_text);
+            job->code = std::vector<uint32_t>();
+        }
+        job->finished_cv.notify_all();
+    });
+}
+
+bool CoreChecks::ReportSpirvValidation(AsyncSpirvValidation &job) const {
+    std::unique_lock<std::mutex> guard(job.lock);
+    job.finished_cv.wait(guard, [&job]() { return job.finished; });
+    const Location create_info_loc = job.function == Func::vkCreateShadersEXT
+                                         ? Location(job.function, Field::pCreateInfos, job.create_info_index)
+                                         : Location(job.function, Field::pCreateInfo);
+    return LogSpirvValidationResult(job.result, job.error_text, create_info_loc);
+}
+
+bool CoreChecks::ReportPendingSpirvValidation(const spirv::Module &module_state) const {
+    std::shared_ptr<AsyncSpirvValidation> job;
+    {
+        // Taken out of the map, so only the first caller reports it
+        WriteLockGuard guard(pending_spirv_validation_lock);
+        const auto it = pending_spirv_validation.find(&module_state);
+        if (it == pending_spirv_validation.end()) {
+            return false;
+        }
+        job = std::move(it->second);
+        pending_spirv_validation.erase(it);
+    }
+    // The address can belong to a newer module if the one the job was made for never got created
+    if (job->module_state.lock().get() != &module_state) {
+        return false;
+    }
+    return ReportSpirvValidation(*job);
+}
+
+void CoreChecks::ReportAllPendingSpirvValidation() {
+    WriteLockGuard guard(pending_spirv_validation_lock);
+    for (const auto &entry : pending_spirv_validation) {
+        // Jobs of modules that failed to be created are dropped without a report
+        if (!entry.second->module_state.expired()) {
+            ReportSpirvValidation(*entry.second);
+        }
+    }
+    pending_spirv_validation.clear();
+}
+
+ValidationCache *CoreChecks::GetShaderModuleValidationCache(const VkShaderModuleCreateInfo &create_info) const {
+    const auto validation_cache_ci = vku::FindStructInPNextChain<VkShaderModuleValidationCacheCreateInfoEXT>(create_info.pNext);
+    ValidationCache *cache = validation_cache_ci ? CastFromHandle<ValidationCache *>(validation_cache_ci->validationCache) : nullptr;
+    // If app isn't using a shader validation cache, use the default one from CoreChecks
+    if (!cache) {
+        cache = CastFromHandle<ValidationCache *>(core_validation_cache);
+    }
+    return cache;
+}
+
 bool CoreChecks::ValidateShaderModuleCreateInfo(const VkShaderModuleCreateInfo &create_info,
                                                 const Location &create_info_loc) const {
     bool skip = false;
@@ -2562,16 +2721,12 @@ bool CoreChecks::ValidateShaderModuleCreateInfo(const VkShaderModuleCreateInfo &
     } else {
         // if pCode is garbage, don't pass along to spirv-val
 
-        const auto validation_cache_ci = vku::FindStructInPNextChain<VkShaderModuleValidationCacheCreateInfoEXT>(create_info.pNext);
-        ValidationCache *cache =
-            validation_cache_ci ? CastFromHandle<ValidationCache *>(validation_cache_ci->validationCache) : nullptr;
-        // If app isn't using a shader validation cache, use the default one from CoreChecks
-        if (!cache) {
-            cache = CastFromHandle<ValidationCache *>(core_validation_cache);
+        // With async_spirv_validation, PreCallRecordCreateShaderModule hands the SPIR-V to spirv_validation_pool instead.
+        // Shader modules inlined in a pipeline are still validated here, the pipeline needs the result right away.
+        if (!spirv_validation_pool || create_info_loc.function != Func::vkCreateShaderModule) {
+            spv_const_binary_t binary{create_info.pCode, create_info.codeSize / sizeof(uint32_t)};
+            skip |= RunSpirvValidation(binary, create_info_loc, GetShaderModuleValidationCache(create_info));
         }
-
-        spv_const_binary_t binary{create_info.pCode, create_info.codeSize / sizeof(uint32_t)};
-        skip |= RunSpirvValidation(binary, create_info_loc, cache);
     }
 
     return skip;
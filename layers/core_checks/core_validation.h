@@ -25,6 +25,7 @@
 #include "error_message/error_location.h"
 #include "error_message/record_object.h"
 #include "containers/qfo_transfer.h"
+#include "utils/thread_pool.h"
 #include <spirv-tools/libspirv.hpp>
 
 typedef vvl::unordered_map<const vvl::Image*, std::optional<GlobalImageLayoutRangeMap>> GlobalImageLayoutMap;
@@ -39,6 +40,7 @@ struct StatelessData;
 
 struct SubpassLayout;
 struct DAGNode;
+struct AsyncSpirvValidation;
 struct SemaphoreSubmitState;
 
 class CoreChecks : public ValidationStateTracker {
@@ -57,6 +59,18 @@ class CoreChecks : public ValidationStateTracker {
     GlobalQFOTransferBarrierMap<QFOBufferTransferBarrier> qfo_release_buffer_barrier_map;
     VkValidationCacheEXT core_validation_cache = VK_NULL_HANDLE;
     std::string validation_cache_path;
+    std::string reflection_cache_path;
+    // Only created when parallel_pipeline_validation is enabled
+    std::unique_ptr<vvl::ThreadPool> pipeline_validation_pool;
+    // Only created when async_spirv_validation is enabled, spirv-val then runs on these threads
+    std::unique_ptr<vvl::ThreadPool> spirv_validation_pool;
+    // spirv-val runs whose result was not reported yet, the first call using the module (or shader object) takes it out
+    mutable std::shared_mutex pending_spirv_validation_lock;
+    mutable vvl::unordered_map<const spirv::Module*, std::shared_ptr<AsyncSpirvValidation>> pending_spirv_validation;
+    // Producer/consumer pairs of EntryPoint::unique_id whose stage interfaces matched without any message
+    static constexpr size_t kMaxMatchedStageInterfaces = 1 << 16;
+    mutable std::shared_mutex matched_stage_interfaces_lock;
+    mutable vvl::unordered_set<hash_util::Hash128, hash_util::Hash128::Hasher> matched_stage_interfaces;
 
     // The options are set from extensions/features only, so only need ot create once.
     // This also is needed for shader caching (You can have the same SPIR-V, but different Vulkan features making it legal/illegal
@@ -77,6 +91,9 @@ class CoreChecks : public ValidationStateTracker {
                                       const VkPipelineRenderingCreateInfo* rendering_struct, const Location& loc, int lib_index,
                                       const char* vuid) const;
     bool ValidateGraphicsPipelineDerivatives(PipelineStates& pipeline_states, uint32_t pipe_index, const Location& loc) const;
+    // Calls validate() for each create info of a vkCreate*Pipelines call, on pipeline_validation_pool if there is one.
+    // Messages are reported in create info order either way.
+    bool ValidatePipelineCreateInfos(uint32_t count, const std::function<bool(uint32_t index)>& validate) const;
     bool ValidateMultiViewShaders(const vvl::Pipeline& pipeline, const Location& multiview_loc, uint32_t view_mask,
                                   bool dynamic_rendering) const;
     bool ValidateDrawPipelineVertexAttribute(const vvl::CommandBuffer& cb_state, const vvl::Pipeline& pipeline,
@@ -556,9 +573,12 @@ class CoreChecks : public ValidationStateTracker {
     VkResult CoreLayerGetValidationCacheDataEXT(VkDevice device, VkValidationCacheEXT validationCache, size_t* pDataSize,
                                                 void* pData) override;
     // For given bindings validate state at time of draw is correct, returning false on error and writing error details into string*
-    bool ValidateDrawState(const vvl::DescriptorSet& descriptor_set, uint32_t set_index, const BindingVariableMap& bindings,
-                           const std::vector<uint32_t>& dynamic_offsets, const vvl::CommandBuffer& cb_state, const Location& loc,
-                           const vvl::DrawDispatchVuid& vuid) const;
+    // If |validated_change_count| is set, only descriptors written since the set was at that change count are validated
+    // |requirements_id| is the id of the pipeline or shader object |bindings| belongs to
+    bool ValidateDrawState(const vvl::DescriptorSet& descriptor_set, uint32_t set_index,
+                           vvl::span<const DescriptorRequirementTable::Binding> bindings,
+                           vvl::StateObject::IdType requirements_id, const vvl::CommandBuffer& cb_state, const Location& loc,
+                           const vvl::DrawDispatchVuid& vuid, std::optional<uint64_t> validated_change_count) const;
 
     bool VerifySetLayoutCompatibility(const vvl::DescriptorSetLayout& layout_dsl,
                                       const vvl::DescriptorSetLayout& bound_dsl, std::string& error_msg) const;
@@ -683,7 +703,19 @@ class CoreChecks : public ValidationStateTracker {
     void PreCallRecordCreateShadersEXT(VkDevice device, uint32_t createInfoCount, const VkShaderCreateInfoEXT* pCreateInfos,
                                        const VkAllocationCallbacks* pAllocator, VkShaderEXT* pShaders,
                                        const RecordObject& record_obj, chassis::ShaderObject& chassis_state) override;
+    void PreCallRecordDestroyShaderModule(VkDevice device, VkShaderModule shaderModule, const VkAllocationCallbacks* pAllocator,
+                                          const RecordObject& record_obj) override;
+    void PreCallRecordDestroyShaderEXT(VkDevice device, VkShaderEXT shader, const VkAllocationCallbacks* pAllocator,
+                                       const RecordObject& record_obj) override;
+    spv_result_t RunSpirvValidator(spv_const_binary_t& binary, ValidationCache* cache, std::string& error_text) const;
+    bool LogSpirvValidationResult(spv_result_t result, const std::string& error_text, const Location& loc) const;
     bool RunSpirvValidation(spv_const_binary_t& binary, const Location& loc, ValidationCache* cache) const;
+    void EnqueueSpirvValidation(const uint32_t* code, size_t code_size, ValidationCache* cache, vvl::Func function,
+                                uint32_t create_info_index, const std::shared_ptr<const spirv::Module>& module_state);
+    bool ReportSpirvValidation(AsyncSpirvValidation& job) const;
+    bool ReportPendingSpirvValidation(const spirv::Module& module_state) const;
+    void ReportAllPendingSpirvValidation();
+    ValidationCache* GetShaderModuleValidationCache(const VkShaderModuleCreateInfo& create_info) const;
     bool ValidateSpirvStateless(const spirv::Module& module_state, const spirv::StatelessData& stateless_data,
                                 const Location& loc) const;
     bool ValidateShaderModuleCreateInfo(const VkShaderModuleCreateInfo& create_info, const Location& create_info_loc) const;
@@ -747,6 +779,9 @@ class CoreChecks : public ValidationStateTracker {
     bool ValidateInterfaceBetweenStages(const spirv::Module& producer, const spirv::EntryPoint& producer_entrypoint,
                                         const spirv::Module& consumer, const spirv::EntryPoint& consumer_entrypoint,
                                         const Location& create_info_loc) const;
+    bool CompareStageInterfaces(const spirv::Module& producer, const spirv::EntryPoint& producer_entrypoint,
+                                const spirv::Module& consumer, const spirv::EntryPoint& consumer_entrypoint,
+                                const Location& create_info_loc, bool& found_issue) const;
     bool ValidateFsOutputsAgainstRenderPass(const spirv::Module& module_state, const spirv::EntryPoint& entrypoint,
                                             const vvl::Pipeline& pipeline, uint32_t subpass_index,
                                             const Location& create_info_loc) const;
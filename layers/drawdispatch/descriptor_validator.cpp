@@ -70,9 +70,11 @@ vvl::DescriptorValidator::DescriptorValidator(ValidationStateTracker &dev, vvl::
     : dev_state(dev), cb_state(cb), descriptor_set(set), set_index(set_index_), framebuffer(fb), loc(l), vuids(GetDrawDispatchVuid(loc.function)) {}
 
 template <typename T>
-bool vvl::DescriptorValidator::ValidateDescriptors(const DescriptorBindingInfo &binding_info, const T &binding) const {
+bool vvl::DescriptorValidator::ValidateDescriptors(const DescriptorBindingInfo &binding_info, const T &binding,
+                                                    const IndexRange &range) const {
     bool skip = false;
-    for (uint32_t index = 0; !skip && index < binding.count; index++) {
+    assert(range.end <= binding.count);
+    for (uint32_t index = range.start; !skip && index < range.end; index++) {
         const auto &descriptor = binding.descriptors[index];
 
         if (!binding.updated[index]) {
@@ -87,7 +89,8 @@ bool vvl::DescriptorValidator::ValidateDescriptors(const DescriptorBindingInfo &
     return skip;
 }
 
-bool vvl::DescriptorValidator::ValidateBinding(const DescriptorBindingInfo &binding_info, const vvl::DescriptorBinding &binding) const {
+bool vvl::DescriptorValidator::ValidateBinding(const DescriptorBindingInfo &binding_info, const vvl::DescriptorBinding &binding,
+                                               const IndexRange &range) const {
     using DescriptorClass = vvl::DescriptorClass;
     bool skip = false;
     switch (binding.descriptor_class) {
@@ -95,22 +98,22 @@ bool vvl::DescriptorValidator::ValidateBinding(const DescriptorBindingInfo &bind
             // Can't validate the descriptor because it may not have been updated.
             break;
         case DescriptorClass::GeneralBuffer:
-            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::BufferBinding &>(binding));
+            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::BufferBinding &>(binding), range);
             break;
         case DescriptorClass::ImageSampler:
-            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::ImageSamplerBinding &>(binding));
+            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::ImageSamplerBinding &>(binding), range);
             break;
         case DescriptorClass::Image:
-            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::ImageBinding &>(binding));
+            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::ImageBinding &>(binding), range);
             break;
         case DescriptorClass::PlainSampler:
-            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::SamplerBinding &>(binding));
+            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::SamplerBinding &>(binding), range);
             break;
         case DescriptorClass::TexelBuffer:
-            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::TexelBinding &>(binding));
+            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::TexelBinding &>(binding), range);
             break;
         case DescriptorClass::AccelerationStructure:
-            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::AccelerationStructureBinding &>(binding));
+            skip |= ValidateDescriptors(binding_info, static_cast<const vvl::AccelerationStructureBinding &>(binding), range);
             break;
         default:
             break;
@@ -34,6 +34,7 @@ class SamplerDescriptor;
 class CommandBuffer;
 class Sampler;
 class DescriptorSet;
+struct IndexRange;
 
 // The reason there is a vector is because we can have a shader that looks like
 //   layout(set = 0, binding = 2) uniform sampler3D tex3d[];
@@ -51,12 +52,14 @@ class DescriptorValidator {
        return dev_state.FormatHandle(std::forward<T>(h));
     }
 
-    bool ValidateBinding(const DescriptorBindingInfo& binding_info, const vvl::DescriptorBinding& binding) const;
+    // Validates the array elements of |binding| in |range|
+    bool ValidateBinding(const DescriptorBindingInfo& binding_info, const vvl::DescriptorBinding& binding,
+                         const IndexRange& range) const;
     bool ValidateBinding(const DescriptorBindingInfo& binding_info, const std::vector<uint32_t> &indices);
 
  private:
     template <typename T>
-    bool ValidateDescriptors(const DescriptorBindingInfo& binding_info, const T& binding) const;
+    bool ValidateDescriptors(const DescriptorBindingInfo& binding_info, const T& binding, const IndexRange& range) const;
 
     template <typename T>
     bool ValidateDescriptors(const DescriptorBindingInfo& binding_info, const T& binding, const std::vector<uint32_t>& indices);
@@ -549,6 +549,15 @@ bool DebugReport::LogMsgEnabled(std::string_view vuid_text, VkDebugUtilsMessageS
     return true;
 }
 
+// Set by DeferredMessageScope
+static thread_local std::vector<DeferredMessage> *deferred_messages = nullptr;
+
+DeferredMessageScope::DeferredMessageScope(std::vector<DeferredMessage> &messages) : previous_(deferred_messages) {
+    deferred_messages = &messages;
+}
+
+DeferredMessageScope::~DeferredMessageScope() { deferred_messages = previous_; }
+
 bool DebugReport::LogMsg(VkFlags msg_flags, const LogObjectList &objects, const Location &loc, std::string_view vuid_text,
                          const char *format, va_list argptr) {
     assert(*(vuid_text.data() + vuid_text.size()) == '\0');
@@ -557,6 +566,21 @@ bool DebugReport::LogMsg(VkFlags msg_flags, const LogObjectList &objects, const
     VkDebugUtilsMessageTypeFlagsEXT msg_type;
 
     DebugReportFlagsToAnnotFlags(msg_flags, &msg_severity, &msg_type);
+
+    if (deferred_messages) {
+        {
+            // Only what doesn't depend on the order of the messages can be filtered now
+            std::unique_lock<std::mutex> lock(debug_output_mutex);
+            if (!(active_msg_severities & msg_severity) || !(active_msg_types & msg_type) ||
+                filter_message_ids.find(hash_util::VuidHash(vuid_text)) != filter_message_ids.end()) {
+                return false;
+            }
+        }
+        deferred_messages->emplace_back(DeferredMessage{msg_flags, std::string(vuid_text)});
+        // Stop early like an error a callback asked to skip would, whatever was logged is validated again without deferring
+        return true;
+    }
+
     std::unique_lock<std::mutex> lock(debug_output_mutex);
     // Avoid logging cost if msg is to be ignored
     if (!LogMsgEnabled(vuid_text, msg_severity, msg_type)) {
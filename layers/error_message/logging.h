@@ -182,6 +182,27 @@ struct MessageFormatSettings {
     std::string application_name;
 };
 
+// A message that was logged while a DeferredMessageScope was active, it never reaches the callbacks
+struct DeferredMessage {
+    VkFlags msg_flags;
+    std::string vuid_text;
+};
+
+// While alive, every message logged from the current thread is appended to messages instead of being sent to the callbacks.
+// Logging a message that passes the severity, type and ID filters returns true, as if a callback asked to skip.
+// Used to validate in parallel: whatever logged a message is validated again without deferring, so the callbacks see the same
+// messages, in the same order, as if it was done one after the other.
+class DeferredMessageScope {
+  public:
+    explicit DeferredMessageScope(std::vector<DeferredMessage> &messages);
+    ~DeferredMessageScope();
+    DeferredMessageScope(const DeferredMessageScope &) = delete;
+    DeferredMessageScope &operator=(const DeferredMessageScope &) = delete;
+
+  private:
+    std::vector<DeferredMessage> *previous_;
+};
+
 class DebugReport {
   public:
     std::vector<VkLayerDbgFunctionState> debug_callback_list;
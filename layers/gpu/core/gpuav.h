@@ -48,6 +48,14 @@ VALSTATETRACK_DERIVED_STATE_OBJECT(VkQueue, gpuav::Queue, vvl::Queue)
 
 namespace gpuav {
 
+// Buffer device address ranges of the whole device, copied out of the state tracker once per
+// buffer_device_address_ranges_version and shared by every command buffer updating its BDA table at submit time.
+// A snapshot is never modified once returned, so command buffers keep the last one they wrote to diff the next one against.
+struct BdaRanges {
+    uint32_t version = 0;
+    std::vector<ValidationStateTracker::BufferAddressRange> ranges;
+};
+
 class Validator : public gpu::GpuShaderInstrumentor {
     using BaseClass = GpuShaderInstrumentor;
     using Func = vvl::Func;
@@ -84,6 +92,8 @@ class Validator : public gpu::GpuShaderInstrumentor {
                                    vku::safe_VkDeviceCreateInfo* modified_create_info) final;
     void PostCreateDevice(const VkDeviceCreateInfo* pCreateInfo, const Location& loc) final;
 
+    std::shared_ptr<const BdaRanges> GetBdaRanges();
+
   private:
     void InitSettings(const Location& loc);
 
@@ -411,6 +421,9 @@ class Validator : public gpu::GpuShaderInstrumentor {
 
   private:
     std::string instrumented_shader_cache_path_{};
+
+    std::mutex bda_ranges_lock_;
+    std::shared_ptr<const BdaRanges> bda_ranges_;
 };
 
 }  // namespace gpuav
@@ -16,7 +16,6 @@
  */
 
 #include <cmath>
-#include <fstream>
 #include "utils/hash_util.h"
 #include "gpu/core/gpuav.h"
 #include "gpu/cmd_validation/gpuav_draw.h"
@@ -29,7 +28,6 @@
 #include "gpu/instrumentation/gpuav_instrumentation.h"
 #include "gpu/shaders/gpu_shaders_constants.h"
 #include "chassis/chassis_modification_state.h"
-#include "gpu/core/gpu_shader_cache_hash.h"
 
 // Generated shaders
 #include "generated/gpu_av_shader_hash.h"
@@ -94,23 +92,6 @@ void Validator::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationCa
 
     shared_resources_manager.Clear();
 
-    if (gpuav_settings.cache_instrumented_shaders && !instrumented_shaders_cache_.IsEmpty()) {
-        std::ofstream file_stream(instrumented_shader_cache_path_, std::ofstream::out | std::ofstream::binary);
-        if (file_stream) {
-            ShaderCacheHash shader_cache_hash(gpuav_settings.shader_instrumentation);
-            file_stream.write(reinterpret_cast<const char *>(&shader_cache_hash), sizeof(shader_cache_hash));
-            uint32_t datasize = static_cast<uint32_t>(instrumented_shaders_cache_.spirv_shaders_.size());
-            file_stream.write(reinterpret_cast<char *>(&datasize), sizeof(uint32_t));
-            for (auto &record : instrumented_shaders_cache_.spirv_shaders_) {
-                // Hash of shader
-                file_stream.write(reinterpret_cast<const char *>(&record.first), sizeof(uint32_t));
-                const size_t spirv_dwords_count = record.second.size();
-                file_stream.write(reinterpret_cast<const char *>(&spirv_dwords_count), sizeof(uint32_t));
-                file_stream.write(reinterpret_cast<const char *>(record.second.data()), spirv_dwords_count * sizeof(uint32_t));
-            }
-            file_stream.close();
-        }
-    }
     BaseClass::PreCallRecordDestroyDevice(device, pAllocator, record_obj);
 }
 
@@ -16,7 +16,6 @@
  */
 
 #include <cmath>
-#include <fstream>
 #include <cstring>
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__GNU__)
 #include <unistd.h>
@@ -29,6 +28,7 @@
 #include "gpu/shaders/gpu_shaders_constants.h"
 #include "generated/chassis.h"
 #include "gpu/core/gpu_shader_cache_hash.h"
+#include "utils/hash_util.h"
 
 namespace gpuav {
 
@@ -72,6 +72,18 @@ std::shared_ptr<vvl::CommandBuffer> Validator::CreateCmdBufferState(VkCommandBuf
     return std::static_pointer_cast<vvl::CommandBuffer>(std::make_shared<CommandBuffer>(*this, handle, allocate_info, pool));
 }
 
+std::shared_ptr<const BdaRanges> Validator::GetBdaRanges() {
+    std::lock_guard<std::mutex> guard(bda_ranges_lock_);
+    if (!bda_ranges_ || bda_ranges_->version != buffer_device_address_ranges_version) {
+        // Command buffers hold on to the previous snapshot without taking bda_ranges_lock_, so its storage is never written
+        // again, a new snapshot is made for each version
+        auto new_ranges = std::make_shared<BdaRanges>();
+        new_ranges->version = GetBufferAddressRanges(new_ranges->ranges);
+        bda_ranges_ = std::move(new_ranges);
+    }
+    return bda_ranges_;
+}
+
 static std::vector<VkExtensionProperties> GetExtensions(VkPhysicalDevice physical_device) {
     VkResult err;
     uint32_t extension_count = 512;
@@ -276,26 +288,14 @@ void Validator::PostCreateDevice(const VkDeviceCreateInfo *pCreateInfo, const Lo
 #endif
         instrumented_shader_cache_path_ += ".bin";
 
-        std::ifstream file_stream(instrumented_shader_cache_path_, std::ifstream::in | std::ifstream::binary);
-        if (file_stream) {
-            ShaderCacheHash shader_cache_hash(gpuav_settings.shader_instrumentation);
-            char inst_shader_hash[sizeof(shader_cache_hash)];
-            file_stream.read(inst_shader_hash, sizeof(inst_shader_hash));
-            if (std::memcmp(inst_shader_hash, reinterpret_cast<char *>(&shader_cache_hash), sizeof(shader_cache_hash)) == 0) {
-                uint32_t num_shaders = 0;
-                file_stream.read(reinterpret_cast<char *>(&num_shaders), sizeof(uint32_t));
-                for (uint32_t i = 0; i < num_shaders; ++i) {
-                    uint32_t hash;
-                    uint32_t spirv_dwords_count;
-                    std::vector<uint32_t> shader_code;
-                    file_stream.read(reinterpret_cast<char *>(&hash), sizeof(uint32_t));
-                    file_stream.read(reinterpret_cast<char *>(&spirv_dwords_count), sizeof(uint32_t));
-                    shader_code.resize(spirv_dwords_count);
-                    file_stream.read(reinterpret_cast<char *>(shader_code.data()), 4 * spirv_dwords_count);
-                    instrumented_shaders_cache_.Add(hash, std::move(shader_code));
-                }
-            }
-            file_stream.close();
+        // Settings or GPU-AV shaders that changed give other keys, so records that don't apply anymore are never hit
+        const ShaderCacheHash shader_cache_hash(gpuav_settings.shader_instrumentation);
+        instrumented_shaders_cache_.SetKeySeed(hash_util::ShaderHash64(&shader_cache_hash, sizeof(shader_cache_hash)));
+        if (!instrumented_shaders_cache_.AttachFile(instrumented_shader_cache_path_)) {
+            InternalWarning(device, loc,
+                            ("Unable to use " + instrumented_shader_cache_path_ +
+                             " for the instrumented shader cache, instrumented shaders will only be cached in memory.")
+                                .c_str());
         }
     }
 
@@ -22,7 +22,10 @@
 #include "gpu/resources/gpu_shader_resources.h"
 #include "gpu/shaders/gpu_shaders_constants.h"
 
+#include <algorithm>
+
 using vvl::DescriptorClass;
+using vvl::IndexRange;
 
 namespace gpuav {
 
@@ -241,42 +244,135 @@ static glsl::DescriptorState GetInData(const vvl::MutableDescriptor &desc) {
 }
 
 template <typename Binding>
-void FillBindingInData(const Binding &binding, glsl::DescriptorState *data, uint32_t &index) {
-    for (uint32_t di = 0; di < binding.count; di++) {
+void FillBindingInData(const Binding &binding, glsl::DescriptorState *data, const IndexRange &range) {
+    for (uint32_t di = range.start; di < range.end; di++) {
         if (!binding.updated[di]) {
-            data[index++] = glsl::DescriptorState();
+            data[di] = glsl::DescriptorState();
         } else {
-            data[index++] = GetInData(binding.descriptors[di]);
+            data[di] = GetInData(binding.descriptors[di]);
         }
     }
 }
 
 // Inline Uniforms are currently treated as a single descriptor. Writes to any offsets cause the whole range to be valid.
 template <>
-void FillBindingInData(const vvl::InlineUniformBinding &binding, glsl::DescriptorState *data, uint32_t &index) {
-    data[index++] = glsl::DescriptorState(DescriptorClass::InlineUniform, glsl::kDebugInputBindlessSkipId, vvl::kU32Max);
+void FillBindingInData(const vvl::InlineUniformBinding &binding, glsl::DescriptorState *data, const IndexRange &range) {
+    data[0] = glsl::DescriptorState(DescriptorClass::InlineUniform, glsl::kDebugInputBindlessSkipId, vvl::kU32Max);
+}
+
+// Number of descriptors, including all array elements
+uint32_t DescriptorSet::StateDescriptorCount() const {
+    uint32_t descriptor_count = 0;
+    for (const auto &binding : *this) {
+        // Shader instrumentation is tracking inline uniform blocks as scalars. Don't try to validate inline uniform
+        // blocks
+        if (binding->type == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT) {
+            descriptor_count++;
+        } else {
+            descriptor_count += binding->count;
+        }
+    }
+    return descriptor_count;
+}
+
+// Writes the descriptors changed since |since_change_count| into the state buffer, or all of them if there is no change count.
+// Only the written part of the buffer is flushed.
+void DescriptorSet::WriteState(Validator &gpuav, const Location &loc, State &state, std::optional<uint64_t> since_change_count) {
+    glsl::DescriptorState *data{nullptr};
+    state.buffer.MapMemory(loc, reinterpret_cast<void **>(&data));
+    if (!data) {
+        return;
+    }
+
+    uint32_t dirty_begin = vvl::kU32Max;
+    uint32_t dirty_end = 0;
+    std::vector<IndexRange> ranges;
+    uint32_t state_start = 0;
+    for (uint32_t i = 0; i < bindings_.size(); i++) {
+        const auto &binding = *bindings_[i];
+        const uint32_t binding_start = state_start;
+        glsl::DescriptorState *binding_data = data + binding_start;
+        const bool is_inline_uniform = binding.type == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT;
+        state_start += is_inline_uniform ? 1 : binding.count;
+
+        ranges.clear();
+        binding.GetDirtyRanges(since_change_count, ranges);
+        for (const auto &range : ranges) {
+            if (range.start >= range.end) {
+                continue;
+            }
+            switch (binding.descriptor_class) {
+                case DescriptorClass::InlineUniform:
+                    FillBindingInData(static_cast<const vvl::InlineUniformBinding &>(binding), binding_data, range);
+                    break;
+                case DescriptorClass::GeneralBuffer:
+                    FillBindingInData(static_cast<const vvl::BufferBinding &>(binding), binding_data, range);
+                    break;
+                case DescriptorClass::TexelBuffer:
+                    FillBindingInData(static_cast<const vvl::TexelBinding &>(binding), binding_data, range);
+                    break;
+                case DescriptorClass::Mutable:
+                    FillBindingInData(static_cast<const vvl::MutableBinding &>(binding), binding_data, range);
+                    break;
+                case DescriptorClass::PlainSampler:
+                    FillBindingInData(static_cast<const vvl::SamplerBinding &>(binding), binding_data, range);
+                    break;
+                case DescriptorClass::ImageSampler:
+                    FillBindingInData(static_cast<const vvl::ImageSamplerBinding &>(binding), binding_data, range);
+                    break;
+                case DescriptorClass::Image:
+                    FillBindingInData(static_cast<const vvl::ImageBinding &>(binding), binding_data, range);
+                    break;
+                case DescriptorClass::AccelerationStructure:
+                    FillBindingInData(static_cast<const vvl::AccelerationStructureBinding &>(binding), binding_data, range);
+                    break;
+                case DescriptorClass::NoDescriptorClass:
+                    gpuav.InternalError(gpuav.device, loc, "NoDescriptorClass not supported.");
+            }
+            dirty_begin = std::min(dirty_begin, binding_start + (is_inline_uniform ? 0 : range.start));
+            dirty_end = std::max(dirty_end, binding_start + (is_inline_uniform ? 1 : range.end));
+        }
+    }
+
+    // Flush the descriptor state buffer before unmapping so that the new state is visible to the GPU
+    if (dirty_begin < dirty_end) {
+        state.buffer.FlushAllocation(loc, dirty_begin * sizeof(glsl::DescriptorState),
+                                     (dirty_end - dirty_begin) * sizeof(glsl::DescriptorState));
+    }
+    state.buffer.UnmapMemory();
 }
 
 std::shared_ptr<DescriptorSet::State> DescriptorSet::GetCurrentState(Validator &gpuav, const Location &loc) {
     auto guard = Lock();
-    uint32_t cur_version = current_version_.load();
-    if (last_used_state_ && last_used_state_->version == cur_version) {
+    const uint64_t change_count = GetChangeCount();
+    if (last_used_state_ && last_used_state_->change_count == change_count) {
         return last_used_state_;
     }
-    auto next_state = std::make_shared<State>(VkHandle(), cur_version, gpuav);
-
-    uint32_t descriptor_count = 0;  // Number of descriptors, including all array elements
-    if (GetBindingCount() > 0) {
-        for (const auto &binding : *this) {
-            // Shader instrumentation is tracking inline uniform blocks as scalars. Don't try to validate inline uniform
-            // blocks
-            if (binding->type == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT) {
-                descriptor_count++;
-            } else {
-                descriptor_count += binding->count;
-            }
+
+    // A state without pending submits can't be read by the GPU, so it can be brought up to date in place. Command buffers
+    // only recorded with it will see the update, which matches the descriptor set they will be submitted with. Otherwise
+    // switch to the spare buffer, and if that one is also busy allocate a new one.
+    std::shared_ptr<State> next_state;
+    if (last_used_state_ && last_used_state_->pending_submits == 0) {
+        next_state = std::move(last_used_state_);
+    } else if (spare_state_ && spare_state_->pending_submits == 0) {
+        next_state = std::move(spare_state_);
+        spare_state_ = std::move(last_used_state_);
+    } else {
+        spare_state_ = std::move(last_used_state_);
+    }
+
+    if (next_state) {
+        if (next_state->buffer.allocation) {
+            WriteState(gpuav, loc, *next_state, next_state->change_count);
         }
+        next_state->change_count = change_count;
+        last_used_state_ = std::move(next_state);
+        return last_used_state_;
     }
+
+    next_state = std::make_shared<State>(VkHandle(), change_count, gpuav);
+    const uint32_t descriptor_count = StateDescriptorCount();
     if (descriptor_count == 0) {
         // no descriptors case, return a dummy state object
         last_used_state_ = next_state;
@@ -288,73 +384,38 @@ std::shared_ptr<DescriptorSet::State> DescriptorSet::GetCurrentState(Validator &
     buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
 
     // The descriptor state buffer can be very large (4mb+ in some games). Allocating it as HOST_CACHED
-    // and manually flushing it at the end of the state updates is faster than using HOST_COHERENT.
+    // and manually flushing the written ranges is faster than using HOST_COHERENT.
     VmaAllocationCreateInfo alloc_info{};
     alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
     next_state->buffer.CreateBuffer(loc, &buffer_info, &alloc_info);
 
-    glsl::DescriptorState *data{nullptr};
-    next_state->buffer.MapMemory(loc, reinterpret_cast<void **>(&data));
-
-    uint32_t index = 0;
-    for (uint32_t i = 0; i < bindings_.size(); i++) {
-        const auto &binding = *bindings_[i];
-        switch (binding.descriptor_class) {
-            case DescriptorClass::InlineUniform:
-                FillBindingInData(static_cast<const vvl::InlineUniformBinding &>(binding), data, index);
-                break;
-            case DescriptorClass::GeneralBuffer:
-                FillBindingInData(static_cast<const vvl::BufferBinding &>(binding), data, index);
-                break;
-            case DescriptorClass::TexelBuffer:
-                FillBindingInData(static_cast<const vvl::TexelBinding &>(binding), data, index);
-                break;
-            case DescriptorClass::Mutable:
-                FillBindingInData(static_cast<const vvl::MutableBinding &>(binding), data, index);
-                break;
-            case DescriptorClass::PlainSampler:
-                FillBindingInData(static_cast<const vvl::SamplerBinding &>(binding), data, index);
-                break;
-            case DescriptorClass::ImageSampler:
-                FillBindingInData(static_cast<const vvl::ImageSamplerBinding &>(binding), data, index);
-                break;
-            case DescriptorClass::Image:
-                FillBindingInData(static_cast<const vvl::ImageBinding &>(binding), data, index);
-                break;
-            case DescriptorClass::AccelerationStructure:
-                FillBindingInData(static_cast<const vvl::AccelerationStructureBinding &>(binding), data, index);
-                break;
-            case DescriptorClass::NoDescriptorClass:
-                gpuav.InternalError(gpuav.device, loc, "NoDescriptorClass not supported.");
-        }
-    }
-
-    // Flush the descriptor state buffer before unmapping so that the new state is visible to the GPU
-    next_state->buffer.FlushAllocation(loc);
-    next_state->buffer.UnmapMemory();
+    WriteState(gpuav, loc, *next_state, std::nullopt);
 
     last_used_state_ = next_state;
     return next_state;
 }
 
+void DescriptorSet::BeginSubmit(State &state) {
+    auto guard = Lock();
+    ++state.pending_submits;
+}
+
+void DescriptorSet::EndSubmit(State &state) {
+    auto guard = Lock();
+    // A submit that failed part way through UpdateBindlessStateBuffer() never got to BeginSubmit()
+    if (state.pending_submits > 0) {
+        --state.pending_submits;
+    }
+}
+
 std::shared_ptr<DescriptorSet::State> DescriptorSet::GetOutputState(Validator &gpuav, const Location &loc) {
     auto guard = Lock();
-    uint32_t cur_version = current_version_.load();
     if (output_state_) {
         return output_state_;
     }
-    auto next_state = std::make_shared<State>(VkHandle(), cur_version, gpuav);
+    auto next_state = std::make_shared<State>(VkHandle(), GetChangeCount(), gpuav);
 
-    uint32_t descriptor_count = 0;  // Number of descriptors, including all array elements
-    for (const auto &binding : *this) {
-        // Shader instrumentation is tracking inline uniform blocks as scalers. Don't try to validate inline uniform
-        // blocks
-        if (binding->type == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT) {
-            descriptor_count++;
-        } else {
-            descriptor_count += binding->count;
-        }
-    }
+    const uint32_t descriptor_count = StateDescriptorCount();
     if (descriptor_count == 0) {
         // no descriptors case, return a dummy state object
         output_state_ = next_state;
@@ -417,21 +478,6 @@ std::map<uint32_t, std::vector<uint32_t>> DescriptorSet::State::UsedDescriptors(
 
 DescriptorSet::State::~State() { buffer.DestroyBuffer(); }
 
-void DescriptorSet::PerformPushDescriptorsUpdate(uint32_t write_count, const VkWriteDescriptorSet *write_descs) {
-    vvl::DescriptorSet::PerformPushDescriptorsUpdate(write_count, write_descs);
-    current_version_++;
-}
-
-void DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorSet &write_desc) {
-    vvl::DescriptorSet::PerformWriteUpdate(write_desc);
-    current_version_++;
-}
-
-void DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet &copy_desc, const vvl::DescriptorSet &src_set) {
-    vvl::DescriptorSet::PerformCopyUpdate(copy_desc, src_set);
-    current_version_++;
-}
-
 DescriptorHeap::DescriptorHeap(Validator &gpuav, uint32_t max_descriptors, const Location &loc)
     : max_descriptors_(max_descriptors), buffer_(gpuav) {
     // If max_descriptors_ is 0, GPU-AV aborted during vkCreateDevice(). We still need to
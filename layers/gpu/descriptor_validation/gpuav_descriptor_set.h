@@ -17,8 +17,8 @@
 
 #pragma once
 
-#include <atomic>
 #include <mutex>
+#include <optional>
 #include "state_tracker/descriptor_sets.h"
 #include "vma/vma.h"
 
@@ -52,25 +52,32 @@ class DescriptorSet : public vvl::DescriptorSet {
                   const std::shared_ptr<vvl::DescriptorSetLayout const> &layout, uint32_t variable_count,
                   ValidationStateTracker *state_data);
     virtual ~DescriptorSet();
-    void Destroy() override { last_used_state_.reset(); };
+    void Destroy() override {
+        last_used_state_.reset();
+        spare_state_.reset();
+    };
     struct State {
-        State(VkDescriptorSet set, uint32_t version, Validator &gpuav) : set(set), version(version), buffer(gpuav) {}
+        State(VkDescriptorSet set, uint64_t change_count, Validator &gpuav) : set(set), change_count(change_count), buffer(gpuav) {}
         ~State();
 
         const VkDescriptorSet set;
-        const uint32_t version;
+        // Change count of the descriptor set the buffer contents match
+        uint64_t change_count;
         AddressBuffer buffer;
+        // Submissions using the buffer that have not been retired yet, guarded by the owning set's state lock
+        uint32_t pending_submits = 0;
 
         std::map<uint32_t, std::vector<uint32_t>> UsedDescriptors(const Location &loc, const DescriptorSet &set,
                                                                   uint32_t shader_set) const;
     };
-    void PerformPushDescriptorsUpdate(uint32_t write_count, const VkWriteDescriptorSet *write_descs) override;
-    void PerformWriteUpdate(const VkWriteDescriptorSet &) override;
-    void PerformCopyUpdate(const VkCopyDescriptorSet &, const vvl::DescriptorSet &) override;
 
     VkDeviceAddress GetLayoutState(Validator &gpuav, const Location &loc);
     std::shared_ptr<State> GetCurrentState(Validator &gpuav, const Location &loc);
     std::shared_ptr<State> GetOutputState(Validator &gpuav, const Location &loc);
+    // Bracket each queue submission of a command buffer using a state from GetCurrentState(), the GPU may read the buffer
+    // in between so it is not rewritten in place
+    void BeginSubmit(State &state);
+    void EndSubmit(State &state);
 
   protected:
     bool SkipBinding(const vvl::DescriptorBinding &binding, bool is_dynamic_accessed) const override { return true; }
@@ -78,9 +85,14 @@ class DescriptorSet : public vvl::DescriptorSet {
   private:
     std::lock_guard<std::mutex> Lock() const { return std::lock_guard<std::mutex>(state_lock_); }
 
+    uint32_t StateDescriptorCount() const;
+    void WriteState(Validator &gpuav, const Location &loc, State &state, std::optional<uint64_t> since_change_count);
+
     AddressBuffer layout_;
-    std::atomic<uint32_t> current_version_{0};
+    // The state buffers are double buffered: one with pending submits may still be read by the GPU, so updates go to
+    // whichever buffer has none, rewriting just the dirty descriptors
     std::shared_ptr<State> last_used_state_;
+    std::shared_ptr<State> spare_state_;
     std::shared_ptr<State> output_state_;
     mutable std::mutex state_lock_;
 };
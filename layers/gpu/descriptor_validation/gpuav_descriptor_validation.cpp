@@ -155,6 +155,8 @@ void UpdateBoundDescriptors(Validator &gpuav, CommandBuffer &cb_state, VkPipelin
                 set_buffer.gpu_state = set_buffer.state->GetCurrentState(gpuav, loc);
                 bindless_state->desc_sets[i].in_data = set_buffer.gpu_state->buffer.device_addr;
             }
+            // Released in RetireBindlessStateBuffer(), if the submit doesn't make it there the state is just never rewritten
+            set_buffer.state->BeginSubmit(*set_buffer.gpu_state);
             if (!set_buffer.output_state) {
                 set_buffer.output_state = set_buffer.state->GetOutputState(gpuav, loc);
                 if (!set_buffer.output_state) {
@@ -169,6 +171,16 @@ void UpdateBoundDescriptors(Validator &gpuav, CommandBuffer &cb_state, VkPipelin
     return true;
 }
 
+void RetireBindlessStateBuffer(CommandBuffer &cb_state) {
+    for (auto &cmd_info : cb_state.di_input_buffer_list) {
+        for (auto &set_buffer : cmd_info.descriptor_set_buffers) {
+            if (set_buffer.gpu_state) {
+                set_buffer.state->EndSubmit(*set_buffer.gpu_state);
+            }
+        }
+    }
+}
+
 [[nodiscard]] bool CommandBuffer::ValidateBindlessDescriptorSets(const Location &loc) {
     // For each vkCmdBindDescriptorSets()...
     // Some applications repeatedly call vkCmdBindDescriptorSets() with the same descriptor sets, avoid
@@ -31,4 +31,6 @@ void UpdateBoundPipeline(Validator& gpuav, CommandBuffer& cb_state, VkPipelineBi
 void UpdateBoundDescriptors(Validator& gpuav, CommandBuffer& cb_state, VkPipelineBindPoint pipeline_bind_point,
                             const Location& loc);
 [[nodiscard]] bool UpdateBindlessStateBuffer(Validator& gpuav, CommandBuffer& cb_state, const Location& loc);
+// Once the submission that ran UpdateBindlessStateBuffer() is done with the descriptor state buffers
+void RetireBindlessStateBuffer(CommandBuffer& cb_state);
 }  // namespace gpuav
@@ -21,7 +21,8 @@
 #include "gpu/spirv/module.h"
 #include "chassis/chassis_modification_state.h"
 #include "gpu/shaders/gpu_error_codes.h"
-#include "spirv-tools/optimizer.hpp"
+#include "spirv-tools/libspirv.h"
+#include "utils/hash_util.h"
 #include "utils/vk_layer_utils.h"
 #include "state_tracker/descriptor_sets.h"
 #include "state_tracker/shader_object_state.h"
@@ -138,16 +139,6 @@ static VkResult UtilInitializeVma(VkInstance instance, VkPhysicalDevice physical
     return vmaCreateAllocator(&allocator_info, pAllocator);
 }
 
-void SpirvCache::Add(uint32_t hash, std::vector<uint32_t> spirv) { spirv_shaders_.emplace(hash, std::move(spirv)); }
-
-std::vector<uint32_t> *SpirvCache::Get(uint32_t spirv_hash) {
-    auto it = spirv_shaders_.find(spirv_hash);
-    if (it != spirv_shaders_.end()) {
-        return &it->second;
-    }
-    return nullptr;
-}
-
 ReadLockGuard GpuShaderInstrumentor::ReadLock() const {
     if (global_settings.fine_grained_locking) {
         return ReadLockGuard(validation_object_mutex, std::defer_lock);
@@ -503,15 +494,14 @@ void GpuShaderInstrumentor::PreCallRecordShaderObjectInstrumentation(
     chassis::ShaderObjectInstrumentationData &instrumentation_data) {
     if (gpuav_settings.select_instrumented_shaders && !IsSelectiveInstrumentationEnabled(create_info.pNext)) return;
     uint32_t unique_shader_id = 0;
+    uint64_t cache_key = 0;
     bool cached = false;
     bool pass = false;
     std::vector<uint32_t> &instrumented_spirv = instrumentation_data.instrumented_spirv;
     if (gpuav_settings.cache_instrumented_shaders) {
         unique_shader_id = hash_util::ShaderHash(create_info.pCode, create_info.codeSize);
-        if (const auto spirv = instrumented_shaders_cache_.Get(unique_shader_id)) {
-            instrumented_spirv = *spirv;
-            cached = true;
-        }
+        cache_key = instrumented_shaders_cache_.MakeKey(create_info.pCode, create_info.codeSize);
+        cached = instrumented_shaders_cache_.Get(cache_key, instrumented_spirv);
     } else {
         unique_shader_id = unique_shader_module_id_++;
     }
@@ -529,7 +519,7 @@ void GpuShaderInstrumentor::PreCallRecordShaderObjectInstrumentation(
         create_info.pCode = instrumented_spirv.data();
         create_info.codeSize = instrumented_spirv.size() * sizeof(uint32_t);
         if (gpuav_settings.cache_instrumented_shaders && !cached) {
-            instrumented_shaders_cache_.Add(unique_shader_id, instrumented_spirv);
+            instrumented_shaders_cache_.Add(cache_key, instrumented_spirv);
         }
     }
 }
@@ -629,6 +619,7 @@ void GpuShaderInstrumentor::PreCallRecordCreateGraphicsPipelines(VkDevice device
     chassis_state.shader_instrumentations_metadata.resize(count);
     chassis_state.modified_create_infos.resize(count);
 
+    std::vector<ShaderInstrumentationJob> jobs;
     for (uint32_t i = 0; i < count; ++i) {
         const auto &pipeline_state = pipeline_states[i];
 
@@ -645,12 +636,13 @@ void GpuShaderInstrumentor::PreCallRecordCreateGraphicsPipelines(VkDevice device
 
         if (pipeline_state->linking_shaders != 0) {
             PreCallRecordPipelineCreationShaderInstrumentationGPL(pAllocator, *pipeline_state, new_pipeline_ci, create_info_loc,
-                                                                  shader_instrumentation_metadata);
+                                                                  shader_instrumentation_metadata, jobs);
         } else {
             PreCallRecordPipelineCreationShaderInstrumentation(pAllocator, *pipeline_state, new_pipeline_ci, create_info_loc,
-                                                               shader_instrumentation_metadata);
+                                                               shader_instrumentation_metadata, jobs);
         }
     }
+    RunShaderInstrumentationJobs(jobs);
 
     chassis_state.pCreateInfos = reinterpret_cast<VkGraphicsPipelineCreateInfo *>(chassis_state.modified_create_infos.data());
 }
@@ -667,6 +659,7 @@ void GpuShaderInstrumentor::PreCallRecordCreateComputePipelines(VkDevice device,
     chassis_state.shader_instrumentations_metadata.resize(count);
     chassis_state.modified_create_infos.resize(count);
 
+    std::vector<ShaderInstrumentationJob> jobs;
     for (uint32_t i = 0; i < count; ++i) {
         const auto &pipeline_state = pipeline_states[i];
 
@@ -682,8 +675,9 @@ void GpuShaderInstrumentor::PreCallRecordCreateComputePipelines(VkDevice device,
         auto &shader_instrumentation_metadata = chassis_state.shader_instrumentations_metadata[i];
 
         PreCallRecordPipelineCreationShaderInstrumentation(pAllocator, *pipeline_state, new_pipeline_ci, create_info_loc,
-                                                           shader_instrumentation_metadata);
+                                                           shader_instrumentation_metadata, jobs);
     }
+    RunShaderInstrumentationJobs(jobs);
 
     chassis_state.pCreateInfos = reinterpret_cast<VkComputePipelineCreateInfo *>(chassis_state.modified_create_infos.data());
 }
@@ -701,6 +695,7 @@ void GpuShaderInstrumentor::PreCallRecordCreateRayTracingPipelinesNV(VkDevice de
     chassis_state.shader_instrumentations_metadata.resize(count);
     chassis_state.modified_create_infos.resize(count);
 
+    std::vector<ShaderInstrumentationJob> jobs;
     for (uint32_t i = 0; i < count; ++i) {
         const auto &pipeline_state = pipeline_states[i];
 
@@ -716,8 +711,9 @@ void GpuShaderInstrumentor::PreCallRecordCreateRayTracingPipelinesNV(VkDevice de
         auto &shader_instrumentation_metadata = chassis_state.shader_instrumentations_metadata[i];
 
         PreCallRecordPipelineCreationShaderInstrumentation(pAllocator, *pipeline_state, new_pipeline_ci, create_info_loc,
-                                                           shader_instrumentation_metadata);
+                                                           shader_instrumentation_metadata, jobs);
     }
+    RunShaderInstrumentationJobs(jobs);
 
     chassis_state.pCreateInfos = reinterpret_cast<VkRayTracingPipelineCreateInfoNV *>(chassis_state.modified_create_infos.data());
 }
@@ -733,6 +729,7 @@ void GpuShaderInstrumentor::PreCallRecordCreateRayTracingPipelinesKHR(
     chassis_state.shader_instrumentations_metadata.resize(count);
     chassis_state.modified_create_infos.resize(count);
 
+    std::vector<ShaderInstrumentationJob> jobs;
     for (uint32_t i = 0; i < count; ++i) {
         const auto &pipeline_state = pipeline_states[i];
 
@@ -748,8 +745,9 @@ void GpuShaderInstrumentor::PreCallRecordCreateRayTracingPipelinesKHR(
         auto &shader_instrumentation_metadata = chassis_state.shader_instrumentations_metadata[i];
 
         PreCallRecordPipelineCreationShaderInstrumentation(pAllocator, *pipeline_state, new_pipeline_ci, create_info_loc,
-                                                           shader_instrumentation_metadata);
+                                                           shader_instrumentation_metadata, jobs);
     }
+    RunShaderInstrumentationJobs(jobs);
 
     chassis_state.pCreateInfos = reinterpret_cast<VkRayTracingPipelineCreateInfoKHR *>(chassis_state.modified_create_infos.data());
 }
@@ -1034,7 +1032,8 @@ bool GpuShaderInstrumentor::HasBindlessDescriptors(VkShaderCreateInfoEXT &create
 template <typename SafeCreateInfo>
 void GpuShaderInstrumentor::PreCallRecordPipelineCreationShaderInstrumentation(
     const VkAllocationCallbacks *pAllocator, vvl::Pipeline &pipeline_state, SafeCreateInfo &new_pipeline_ci, const Location &loc,
-    std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata) {
+    std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata,
+    std::vector<ShaderInstrumentationJob> &jobs) {
     // Init here instead of in chassis so we don't pay cost when GPU-AV is not used
     const size_t total_stages = pipeline_state.stage_states.size();
     shader_instrumentation_metadata.resize(total_stages);
@@ -1066,38 +1065,36 @@ void GpuShaderInstrumentor::PreCallRecordPipelineCreationShaderInstrumentation(
         }
 
         uint32_t unique_shader_id = 0;
-        bool cached = false;
-        bool pass = false;
-        std::vector<uint32_t> instrumented_spirv;
+        uint64_t cache_key = 0;
         if (gpuav_settings.cache_instrumented_shaders) {
-            unique_shader_id =
-                hash_util::ShaderHash(module_state->spirv->words_.data(), module_state->spirv->words_.size() * sizeof(uint32_t));
-            if (const auto spirv = instrumented_shaders_cache_.Get(unique_shader_id)) {
-                instrumented_spirv = *spirv;
-                cached = true;
-            }
+            const auto &words = module_state->spirv->words_;
+            unique_shader_id = hash_util::ShaderHash(words.data(), words.size() * sizeof(uint32_t));
+            cache_key = instrumented_shaders_cache_.MakeKey(words.data(), words.size() * sizeof(uint32_t));
         } else {
             unique_shader_id = unique_shader_module_id_++;
         }
-        if (!cached) {
-            pass =
-                InstrumentShader(module_state->spirv->words_, unique_shader_id, has_bindless_descriptors, loc, instrumented_spirv);
+        auto &job = jobs.emplace_back(module_state, unique_shader_id, cache_key, has_bindless_descriptors, loc);
+        if (gpuav_settings.cache_instrumented_shaders) {
+            job.cached = instrumented_shaders_cache_.Get(cache_key, job.instrumented_spirv);
         }
-        if (cached || pass) {
-            instrumentation_metadata.unique_shader_id = unique_shader_id;
-            if (module_state->VkHandle() != VK_NULL_HANDLE) {
+
+        job.apply = [this, pAllocator, &pipeline_state, &new_pipeline_ci, &stage_state, sm_ci, &instrumentation_metadata,
+                     i](ShaderInstrumentationJob &job) {
+            if (!job.cached && !job.pass) return;
+            instrumentation_metadata.unique_shader_id = job.unique_shader_id;
+            if (job.module_state->VkHandle() != VK_NULL_HANDLE) {
                 // If the user used vkCreateShaderModule, we create a new VkShaderModule to replace with the instrumented
                 // shader
                 VkShaderModule instrumented_shader_module;
                 VkShaderModuleCreateInfo create_info = vku::InitStructHelper();
-                create_info.pCode = instrumented_spirv.data();
-                create_info.codeSize = instrumented_spirv.size() * sizeof(uint32_t);
+                create_info.pCode = job.instrumented_spirv.data();
+                create_info.codeSize = job.instrumented_spirv.size() * sizeof(uint32_t);
                 VkResult result = DispatchCreateShaderModule(device, &create_info, pAllocator, &instrumented_shader_module);
                 if (result == VK_SUCCESS) {
                     SetShaderModule(new_pipeline_ci, *stage_state.pipeline_create_info, instrumented_shader_module, i);
                     pipeline_state.instrumentation_data.instrumented_shader_module.emplace_back(instrumented_shader_module);
                 } else {
-                    InternalError(device, loc, "Unable to replace non-instrumented shader with instrumented one.");
+                    InternalError(device, job.loc, "Unable to replace non-instrumented shader with instrumented one.");
                 }
             } else if (sm_ci) {
                 // The user is inlining the Shader Module into the pipeline, so just need to update the spirv
@@ -1107,15 +1104,11 @@ void GpuShaderInstrumentor::PreCallRecordPipelineCreationShaderInstrumentation(
                 // memory. It would be much harder to change everything from std::vector and instead to adjust Safe Struct to not
                 // double-free the memory on us. If making any changes, we have to consider a case where the user inlines the
                 // fragment shader, but use a normal VkShaderModule in the vertex shader.
-                sm_ci->SetCode(instrumented_spirv);
+                sm_ci->SetCode(job.instrumented_spirv);
             } else {
                 assert(false);
             }
-
-            if (gpuav_settings.cache_instrumented_shaders && !cached) {
-                instrumented_shaders_cache_.Add(unique_shader_id, instrumented_spirv);
-            }
-        }
+        };
     }
 }
 
@@ -1160,7 +1153,8 @@ void GpuShaderInstrumentor::PostCallRecordPipelineCreationShaderInstrumentation(
 // doesn't fit in the "all pipeline" templated flow.
 void GpuShaderInstrumentor::PreCallRecordPipelineCreationShaderInstrumentationGPL(
     const VkAllocationCallbacks *pAllocator, vvl::Pipeline &pipeline_state, vku::safe_VkGraphicsPipelineCreateInfo &new_pipeline_ci,
-    const Location &loc, std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata) {
+    const Location &loc, std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata,
+    std::vector<ShaderInstrumentationJob> &jobs) {
     // Init here instead of in chassis so we don't pay cost when GPU-AV is not used
     const size_t total_stages = pipeline_state.stage_states.size();
     shader_instrumentation_metadata.resize(total_stages);
@@ -1179,7 +1173,8 @@ void GpuShaderInstrumentor::PreCallRecordPipelineCreationShaderInstrumentationGP
         if (!lib) continue;
         if (lib->stage_states.empty()) continue;
 
-        vku::safe_VkGraphicsPipelineCreateInfo new_lib_pipeline_ci(lib->GraphicsCreateInfo());
+        // Shared with the jobs, which patch it after the shaders were instrumented
+        auto new_lib_pipeline_ci = std::make_shared<vku::safe_VkGraphicsPipelineCreateInfo>(lib->GraphicsCreateInfo());
 
         for (uint32_t stage_state_i = 0; stage_state_i < static_cast<uint32_t>(lib->stage_states.size()); ++stage_state_i) {
             const auto &stage_state = lib->stage_states[stage_state_i];
@@ -1191,9 +1186,9 @@ void GpuShaderInstrumentor::PreCallRecordPipelineCreationShaderInstrumentationGP
 
             vku::safe_VkPipelineShaderStageCreateInfo *stage_ci = nullptr;
             // Check pNext for inlined SPIR-V
-            for (uint32_t i = 0; i < new_lib_pipeline_ci.stageCount; ++i) {
-                if (new_lib_pipeline_ci.pStages[i].stage == stage) {
-                    stage_ci = &new_lib_pipeline_ci.pStages[i];
+            for (uint32_t i = 0; i < new_lib_pipeline_ci->stageCount; ++i) {
+                if (new_lib_pipeline_ci->pStages[i].stage == stage) {
+                    stage_ci = &new_lib_pipeline_ci->pStages[i];
                 }
             }
 
@@ -1211,39 +1206,37 @@ void GpuShaderInstrumentor::PreCallRecordPipelineCreationShaderInstrumentationGP
             }
 
             uint32_t unique_shader_id = 0;
-            bool cached = false;
-            bool pass = false;
-            std::vector<uint32_t> instrumented_spirv;
+            uint64_t cache_key = 0;
             if (gpuav_settings.cache_instrumented_shaders) {
-                unique_shader_id = hash_util::ShaderHash(module_state->spirv->words_.data(),
-                                                         module_state->spirv->words_.size() * sizeof(uint32_t));
-                if (const auto spirv = instrumented_shaders_cache_.Get(unique_shader_id)) {
-                    instrumented_spirv = *spirv;
-                    cached = true;
-                }
+                const auto &words = module_state->spirv->words_;
+                unique_shader_id = hash_util::ShaderHash(words.data(), words.size() * sizeof(uint32_t));
+                cache_key = instrumented_shaders_cache_.MakeKey(words.data(), words.size() * sizeof(uint32_t));
             } else {
                 unique_shader_id = unique_shader_module_id_++;
             }
-            if (!cached) {
-                pass = InstrumentShader(module_state->spirv->words_, unique_shader_id, has_bindless_descriptors, loc,
-                                        instrumented_spirv);
+            auto &job = jobs.emplace_back(module_state, unique_shader_id, cache_key, has_bindless_descriptors, loc);
+            if (gpuav_settings.cache_instrumented_shaders) {
+                job.cached = instrumented_shaders_cache_.Get(cache_key, job.instrumented_spirv);
             }
-            if (cached || pass) {
-                instrumentation_metadata.unique_shader_id = unique_shader_id;
-                if (module_state->VkHandle() != VK_NULL_HANDLE) {
+
+            job.apply = [this, pAllocator, lib, new_lib_pipeline_ci, &stage_state, sm_ci, &instrumentation_metadata,
+                         stage_state_i](ShaderInstrumentationJob &job) {
+                if (!job.cached && !job.pass) return;
+                instrumentation_metadata.unique_shader_id = job.unique_shader_id;
+                if (job.module_state->VkHandle() != VK_NULL_HANDLE) {
                     // If the user used vkCreateShaderModule, we create a new VkShaderModule to replace with the instrumented
                     // shader
                     VkShaderModule instrumented_shader_module;
                     VkShaderModuleCreateInfo create_info = vku::InitStructHelper();
-                    create_info.pCode = instrumented_spirv.data();
-                    create_info.codeSize = instrumented_spirv.size() * sizeof(uint32_t);
+                    create_info.pCode = job.instrumented_spirv.data();
+                    create_info.codeSize = job.instrumented_spirv.size() * sizeof(uint32_t);
                     VkResult result = DispatchCreateShaderModule(device, &create_info, pAllocator, &instrumented_shader_module);
                     if (result == VK_SUCCESS) {
-                        SetShaderModule(new_lib_pipeline_ci, *stage_state.pipeline_create_info, instrumented_shader_module,
+                        SetShaderModule(*new_lib_pipeline_ci, *stage_state.pipeline_create_info, instrumented_shader_module,
                                         stage_state_i);
                         lib->instrumentation_data.instrumented_shader_module.emplace_back(instrumented_shader_module);
                     } else {
-                        InternalError(device, loc, "Unable to replace non-instrumented shader with instrumented one.");
+                        InternalError(device, job.loc, "Unable to replace non-instrumented shader with instrumented one.");
                     }
                 } else if (sm_ci) {
                     // The user is inlining the Shader Module into the pipeline, so just need to update the spirv
@@ -1253,27 +1246,28 @@ void GpuShaderInstrumentor::PreCallRecordPipelineCreationShaderInstrumentationGP
                     // memory. It would be much harder to change everything from std::vector and instead to adjust Safe Struct to
                     // not double-free the memory on us. If making any changes, we have to consider a case where the user inlines
                     // the fragment shader, but use a normal VkShaderModule in the vertex shader.
-                    sm_ci->SetCode(instrumented_spirv);
+                    sm_ci->SetCode(job.instrumented_spirv);
                 } else {
                     assert(false);
                 }
-
-                if (gpuav_settings.cache_instrumented_shaders && !cached) {
-                    instrumented_shaders_cache_.Add(unique_shader_id, instrumented_spirv);
-                }
-            }
+            };
         }
 
-        VkPipeline new_lib_pipeline;
-        DispatchCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, new_lib_pipeline_ci.ptr(), pAllocator, &new_lib_pipeline);
+        // The library can only be created once the jobs of all its stages were applied
+        auto &create_lib_job = jobs.emplace_back(nullptr, 0, 0, false, loc);
+        create_lib_job.apply = [this, pAllocator, &pipeline_state, lib, new_lib_pipeline_ci, library_create_info,
+                                library_i](ShaderInstrumentationJob &) {
+            VkPipeline new_lib_pipeline;
+            DispatchCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, new_lib_pipeline_ci->ptr(), pAllocator, &new_lib_pipeline);
 
-        if (lib->active_shaders & VK_SHADER_STAGE_FRAGMENT_BIT) {
-            pipeline_state.instrumentation_data.frag_out_lib = new_lib_pipeline;
-        } else {
-            pipeline_state.instrumentation_data.pre_raster_lib = new_lib_pipeline;
-        }
+            if (lib->active_shaders & VK_SHADER_STAGE_FRAGMENT_BIT) {
+                pipeline_state.instrumentation_data.frag_out_lib = new_lib_pipeline;
+            } else {
+                pipeline_state.instrumentation_data.pre_raster_lib = new_lib_pipeline;
+            }
 
-        const_cast<VkPipeline *>(library_create_info->pLibraries)[library_i] = new_lib_pipeline;
+            const_cast<VkPipeline *>(library_create_info->pLibraries)[library_i] = new_lib_pipeline;
+        };
     }
 }
 
@@ -1336,10 +1330,70 @@ static bool GpuValidateShader(const std::vector<uint32_t> &input, bool SetRelaxB
     return (result == SPV_SUCCESS);
 }
 
-// Call the SPIR-V Optimizer to run the instrumentation pass on the shader.
+// Instruments the shaders of the jobs, on the worker pool when there is more than one.
+void GpuShaderInstrumentor::RunShaderInstrumentationJobs(std::vector<ShaderInstrumentationJob> &jobs) {
+    // When caching, a shader used by several pipelines of the batch has a single id and key, so it is only instrumented once
+    std::vector<uint32_t> to_instrument;
+    std::vector<std::pair<uint32_t, uint32_t>> duplicates;  // [job, job it is a duplicate of]
+    vvl::unordered_map<uint64_t, uint32_t> job_with_key;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(jobs.size()); ++i) {
+        const auto &job = jobs[i];
+        if (!job.module_state || job.cached) continue;
+        if (gpuav_settings.cache_instrumented_shaders) {
+            const auto [it, inserted] = job_with_key.emplace(job.cache_key, i);
+            if (!inserted) {
+                duplicates.emplace_back(i, it->second);
+                continue;
+            }
+        }
+        to_instrument.emplace_back(i);
+    }
+
+    auto instrument = [this, &jobs, &to_instrument](uint32_t index) {
+        auto &job = jobs[to_instrument[index]];
+        job.pass = InstrumentShader(job.module_state->spirv->words_, job.unique_shader_id, job.has_bindless_descriptors, job.loc,
+                                    job.instrumented_spirv, job.error);
+    };
+    if (to_instrument.size() > 1) {
+        std::call_once(instrumentation_pool_once_, [this]() { instrumentation_pool_ = std::make_unique<vvl::ThreadPool>(); });
+        instrumentation_pool_->ParallelFor(static_cast<uint32_t>(to_instrument.size()), instrument);
+    } else if (to_instrument.size() == 1) {
+        instrument(0);
+    }
+
+    for (const auto &[job_i, original_i] : duplicates) {
+        jobs[job_i].pass = jobs[original_i].pass;
+        jobs[job_i].instrumented_spirv = jobs[original_i].instrumented_spirv;
+    }
+
+    // Back on the calling thread, errors are reported and the pipelines patched in the order of the create infos
+    for (auto &job : jobs) {
+        if (!job.error.empty()) {
+            InternalError(device, job.loc, job.error.c_str());
+        }
+        job.apply(job);
+        if (gpuav_settings.cache_instrumented_shaders && job.pass) {
+            instrumented_shaders_cache_.Add(job.cache_key, job.instrumented_spirv);
+        }
+    }
+}
+
+// Run the instrumentation passes on the shader and link in the GLSL functions they call.
 bool GpuShaderInstrumentor::InstrumentShader(const vvl::span<const uint32_t> &input_spirv, uint32_t unique_shader_id,
                                              bool has_bindless_descriptors, const Location &loc,
                                              std::vector<uint32_t> &out_instrumented_spirv) {
+    std::string error;
+    const bool pass =
+        InstrumentShader(input_spirv, unique_shader_id, has_bindless_descriptors, loc, out_instrumented_spirv, error);
+    if (!error.empty()) {
+        InternalError(device, loc, error.c_str());
+    }
+    return pass;
+}
+
+bool GpuShaderInstrumentor::InstrumentShader(const vvl::span<const uint32_t> &input_spirv, uint32_t unique_shader_id,
+                                             bool has_bindless_descriptors, const Location &loc,
+                                             std::vector<uint32_t> &out_instrumented_spirv, std::string &out_error) const {
     if (input_spirv[0] != spv::MagicNumber) return false;
 
     if (gpuav_settings.debug_dump_instrumented_shaders) {
@@ -1368,21 +1422,15 @@ bool GpuShaderInstrumentor::InstrumentShader(const vvl::span<const uint32_t> &in
     if (is_debug_printf) {
         modified |= module.RunPassDebugPrintf(debug_printf_binding_slot_);
     } else {
-        GpuAVSettings::ShaderInstrumentation &shader_instrumentation = gpuav_settings.shader_instrumentation;
+        const GpuAVSettings::ShaderInstrumentation &shader_instrumentation = gpuav_settings.shader_instrumentation;
+        gpu::spirv::InstrumentationPasses passes;
         // If descriptor indexing is enabled, enable length checks and updated descriptor checks
-        if (shader_instrumentation.bindless_descriptor) {
-            modified |= module.RunPassBindlessDescriptor();
-            modified |= module.RunPassNonBindlessOOBBuffer();
-            modified |= module.RunPassNonBindlessOOBTexelBuffer();
-        }
-
-        if (shader_instrumentation.buffer_device_address) {
-            modified |= module.RunPassBufferDeviceAddress();
-        }
-
-        if (shader_instrumentation.ray_query) {
-            modified |= module.RunPassRayQuery();
-        }
+        passes.bindless_descriptor = shader_instrumentation.bindless_descriptor;
+        passes.non_bindless_oob_buffer = shader_instrumentation.bindless_descriptor;
+        passes.non_bindless_oob_texel_buffer = shader_instrumentation.bindless_descriptor;
+        passes.buffer_device_address = shader_instrumentation.buffer_device_address;
+        passes.ray_query = shader_instrumentation.ray_query;
+        modified |= module.RunInstrumentationPasses(passes);
 
         // If there were GLSL written function injected, we will grab them and link them in here
         for (const auto &info : module.link_info_) {
@@ -1395,7 +1443,7 @@ bool GpuShaderInstrumentor::InstrumentShader(const vvl::span<const uint32_t> &in
         return false;
     }
 
-    // some small cleanup to make sure SPIR-V is legal
+    // some small cleanup to make sure SPIR-V is legal, and drop anything the instrumentation added but didn't end up using
     module.PostProcess();
     // translate internal representation of SPIR-V into legal SPIR-V binary
     module.ToBinary(out_instrumented_spirv);
@@ -1407,59 +1455,20 @@ bool GpuShaderInstrumentor::InstrumentShader(const vvl::span<const uint32_t> &in
                          static_cast<std::streamsize>(out_instrumented_spirv.size() * sizeof(uint32_t)));
     }
 
-    spv_target_env target_env = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
     // (Maybe) validate the instrumented and linked shader
     if (gpuav_settings.debug_validate_instrumented_shaders) {
+        spv_target_env target_env = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
         std::string instrumented_error;
         if (!GpuValidateShader(out_instrumented_spirv, device_extensions.vk_khr_relaxed_block_layout,
                                device_extensions.vk_ext_scalar_block_layout, target_env, instrumented_error)) {
             std::ostringstream strm;
             strm << "Instrumented shader (id " << unique_shader_id << ") is invalid, spirv-val error:\n"
                  << instrumented_error << " Proceeding with non instrumented shader.";
-            InternalError(device, loc, strm.str().c_str());
+            out_error = strm.str();
             return false;
         }
     }
 
-    // Run Dead Code elimination
-    // If DebugPrintf is the only thing, there will be nothing to eliminate so don't waste time on it
-    if (!is_debug_printf) {
-        using namespace spvtools;
-        OptimizerOptions opt_options;
-        opt_options.set_run_validator(false);
-        Optimizer dce_pass(target_env);
-
-        const MessageConsumer gpu_console_message_consumer =
-            [this, loc](spv_message_level_t level, const char *, const spv_position_t &position, const char *message) -> void {
-            switch (level) {
-                case SPV_MSG_FATAL:
-                case SPV_MSG_INTERNAL_ERROR:
-                case SPV_MSG_ERROR:
-                    this->LogError("UNASSIGNED-GPU-Assisted", this->device, loc,
-                                   "Error during shader instrumentation: line %zu: %s", position.index, message);
-                    break;
-                default:
-                    break;
-            }
-        };
-
-        dce_pass.SetMessageConsumer(gpu_console_message_consumer);
-        // Call CreateAggressiveDCEPass with preserve_interface == true
-        dce_pass.RegisterPass(CreateAggressiveDCEPass(true));
-        if (!dce_pass.Run(out_instrumented_spirv.data(), out_instrumented_spirv.size(), &out_instrumented_spirv, opt_options)) {
-            InternalError(device, loc,
-                          "Failure to run spirv-opt DCE on instrumented shader. Proceeding with non-instrumented shader.");
-            return false;
-        }
-
-        if (gpuav_settings.debug_dump_instrumented_shaders) {
-            std::string file_name = "dump_" + std::to_string(unique_shader_id) + "_opt.spv";
-            std::ofstream debug_file(file_name, std::ios::out | std::ios::binary);
-            debug_file.write(reinterpret_cast<char *>(out_instrumented_spirv.data()),
-                             static_cast<std::streamsize>(out_instrumented_spirv.size() * sizeof(uint32_t)));
-        }
-    }
-
     return true;
 }
 
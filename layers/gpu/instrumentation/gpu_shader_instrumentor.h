@@ -21,14 +21,16 @@
 #include "gpu/core/gpu_state_tracker.h"
 #include "gpu/resources/gpu_resources.h"
 #include "gpu/spirv/instruction.h"
+#include "utils/spirv_cache.h"
+#include "utils/thread_pool.h"
 #include "vma/vma.h"
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
-namespace gpuav {
-class Validator;
-}
-
 namespace chassis {
 struct ShaderInstrumentationMetadata;
 struct ShaderObjectInstrumentationData;
@@ -48,17 +50,6 @@ static const VkShaderModule kPipelineStageInfoHandle = CastFromUint64<VkShaderMo
 // We set a reasonable max because we have to pad the pipeline layout with dummy descriptor set layouts.
 static const uint32_t kMaxAdjustedBoundDescriptorSet = 33;
 
-class SpirvCache {
-  public:
-    void Add(uint32_t hash, std::vector<uint32_t> spirv);
-    std::vector<uint32_t> *Get(uint32_t spirv_hash);
-    bool IsEmpty() { return spirv_shaders_.empty(); }
-
-  private:
-    friend class gpuav::Validator;
-    vvl::unordered_map<uint32_t, std::vector<uint32_t>> spirv_shaders_{};
-};
-
 struct GpuAssistedShaderTracker {
     VkPipeline pipeline;
     VkShaderModule shader_module;
@@ -189,10 +180,38 @@ class GpuShaderInstrumentor : public ValidationStateTracker {
     bool HasBindlessDescriptors(vvl::Pipeline &pipeline_state);
     bool HasBindlessDescriptors(VkShaderCreateInfoEXT &create_info);
 
+    // A shader stage of a vkCreate*Pipelines call that needs to be instrumented. The stages of every pipeline in the call are
+    // gathered first so the distinct shaders can be instrumented on the worker pool, then apply() is called (in order, on the
+    // calling thread) to patch the instrumented SPIR-V into the pipeline create info.
+    struct ShaderInstrumentationJob {
+        ShaderInstrumentationJob(std::shared_ptr<const vvl::ShaderModule> module_state, uint32_t unique_shader_id,
+                                 uint64_t cache_key, bool has_bindless_descriptors, const Location &loc)
+            : module_state(std::move(module_state)),
+              unique_shader_id(unique_shader_id),
+              cache_key(cache_key),
+              has_bindless_descriptors(has_bindless_descriptors),
+              loc(loc) {}
+
+        std::shared_ptr<const vvl::ShaderModule> module_state;  // null for jobs that only run apply()
+        uint32_t unique_shader_id;
+        uint64_t cache_key;
+        bool has_bindless_descriptors;
+        const Location loc;
+
+        bool cached = false;
+        bool pass = false;
+        std::vector<uint32_t> instrumented_spirv;
+        std::string error;
+        std::function<void(ShaderInstrumentationJob &job)> apply;
+    };
+    // Instruments every job that missed the cache and applies the results
+    void RunShaderInstrumentationJobs(std::vector<ShaderInstrumentationJob> &jobs);
+
     template <typename SafeCreateInfo>
     void PreCallRecordPipelineCreationShaderInstrumentation(
         const VkAllocationCallbacks *pAllocator, vvl::Pipeline &pipeline_state, SafeCreateInfo &new_pipeline_ci,
-        const Location &loc, std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata);
+        const Location &loc, std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata,
+        std::vector<ShaderInstrumentationJob> &jobs);
     void PostCallRecordPipelineCreationShaderInstrumentation(
         vvl::Pipeline &pipeline_state, std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata);
 
@@ -200,7 +219,8 @@ class GpuShaderInstrumentor : public ValidationStateTracker {
     void PreCallRecordPipelineCreationShaderInstrumentationGPL(
         const VkAllocationCallbacks *pAllocator, vvl::Pipeline &pipeline_state,
         vku::safe_VkGraphicsPipelineCreateInfo &new_pipeline_ci, const Location &loc,
-        std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata);
+        std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata,
+        std::vector<ShaderInstrumentationJob> &jobs);
     void PostCallRecordPipelineCreationShaderInstrumentationGPL(
         vvl::Pipeline &pipeline_state, const VkAllocationCallbacks *pAllocator,
         std::vector<chassis::ShaderInstrumentationMetadata> &shader_instrumentation_metadata);
@@ -209,6 +229,10 @@ class GpuShaderInstrumentor : public ValidationStateTracker {
     // Returns if shader was instrumented successfully or not
     bool InstrumentShader(const vvl::span<const uint32_t> &input_spirv, uint32_t unique_shader_id, bool has_bindless_descriptors,
                           const Location &loc, std::vector<uint32_t> &out_instrumented_spirv);
+    // Same, but safe to call from a worker thread. Internal errors are returned in out_error for the caller to report, as
+    // InternalError() disconnects the layer and can only be done from the thread that is in the chassis call.
+    bool InstrumentShader(const vvl::span<const uint32_t> &input_spirv, uint32_t unique_shader_id, bool has_bindless_descriptors,
+                          const Location &loc, std::vector<uint32_t> &out_instrumented_spirv, std::string &out_error) const;
 
   public:
     VkDescriptorSetLayout GetInstrumentationDescriptorSetLayout() { return instrumentation_desc_layout_; }
@@ -231,7 +255,7 @@ class GpuShaderInstrumentor : public ValidationStateTracker {
     std::unique_ptr<DescriptorSetManager> desc_set_manager_;
     vvl::concurrent_unordered_map<uint32_t, GpuAssistedShaderTracker> shader_map_;
     std::vector<VkDescriptorSetLayoutBinding> instrumentation_bindings_;
-    SpirvCache instrumented_shaders_cache_;
+    vvl::SpirvCache instrumented_shaders_cache_;
     DeviceMemoryBlock indices_buffer_{};
     unsigned int indices_buffer_alignment_ = 0;
 
@@ -248,6 +272,10 @@ class GpuShaderInstrumentor : public ValidationStateTracker {
 
     // Pass select_instrumented_shaders from vkCreateShaderModule to CreatePipeline time
     vvl::unordered_set<VkShaderModule> selected_instrumented_shaders;
+
+    // Created with the first vkCreate*Pipelines call that has more than one shader to instrument
+    std::unique_ptr<vvl::ThreadPool> instrumentation_pool_;
+    std::once_flag instrumentation_pool_once_;
 };
 
 }  // namespace gpu
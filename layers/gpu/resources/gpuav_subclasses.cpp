@@ -24,6 +24,8 @@
 #include "gpu/descriptor_validation/gpuav_descriptor_validation.h"
 #include "gpu/shaders/gpu_error_header.h"
 
+#include <algorithm>
+
 namespace gpuav {
 
 Buffer::Buffer(ValidationStateTracker &dev_data, VkBuffer buff, const VkBufferCreateInfo *pCreateInfo, DescriptorHeap &desc_heap_)
@@ -128,33 +130,35 @@ CommandBuffer::CommandBuffer(Validator &gpuav, VkCommandBuffer handle, const VkC
     AllocateResources(loc);
 }
 
-static bool AllocateErrorLogsBuffer(Validator &gpuav, gpu::DeviceMemoryBlock &error_logs_mem, const Location &loc) {
+// The buffer stays mapped for the lifetime of the command buffer, so post processing a submission that found no error only
+// has to read the written size word
+static bool AllocateErrorLogsBuffer(Validator &gpuav, gpu::DeviceMemoryBlock &error_logs_mem, uint32_t *&error_logs_ptr,
+                                    const Location &loc) {
     VkBufferCreateInfo buffer_info = vku::InitStructHelper();
     buffer_info.size = glsl::kErrorBufferByteSize;
     buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
     VmaAllocationCreateInfo alloc_info = {};
+    alloc_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
     alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
     alloc_info.pool = gpuav.output_buffer_pool_;
+    VmaAllocationInfo allocation_info = {};
     VkResult result = vmaCreateBuffer(gpuav.vma_allocator_, &buffer_info, &alloc_info, &error_logs_mem.buffer,
-                                      &error_logs_mem.allocation, nullptr);
+                                      &error_logs_mem.allocation, &allocation_info);
     if (result != VK_SUCCESS) {
         gpuav.InternalError(gpuav.device, loc, "Unable to allocate device memory for error output buffer.", true);
         return false;
     }
-
-    uint32_t *output_buffer_ptr;
-    result = vmaMapMemory(gpuav.vma_allocator_, error_logs_mem.allocation, reinterpret_cast<void **>(&output_buffer_ptr));
-    if (result == VK_SUCCESS) {
-        memset(output_buffer_ptr, 0, glsl::kErrorBufferByteSize);
-        if (gpuav.gpuav_settings.shader_instrumentation.bindless_descriptor) {
-            output_buffer_ptr[cst::stream_output_flags_offset] = cst::inst_buffer_oob_enabled;
-        }
-        vmaUnmapMemory(gpuav.vma_allocator_, error_logs_mem.allocation);
-    } else {
+    if (!allocation_info.pMappedData) {
         gpuav.InternalError(gpuav.device, loc, "Unable to map device memory allocated for error output buffer.", true);
         return false;
     }
 
+    error_logs_ptr = static_cast<uint32_t *>(allocation_info.pMappedData);
+    memset(error_logs_ptr, 0, glsl::kErrorBufferByteSize);
+    if (gpuav.gpuav_settings.shader_instrumentation.bindless_descriptor) {
+        error_logs_ptr[cst::stream_output_flags_offset] = cst::inst_buffer_oob_enabled;
+    }
+
     return true;
 }
 
@@ -178,7 +182,7 @@ void CommandBuffer::AllocateResources(const Location &loc) {
     }
 
     // Error output buffer
-    if (!AllocateErrorLogsBuffer(*gpuav, error_output_buffer_, loc)) {
+    if (!AllocateErrorLogsBuffer(*gpuav, error_output_buffer_, error_output_buffer_ptr_, loc)) {
         return;
     }
 
@@ -188,17 +192,23 @@ void CommandBuffer::AllocateResources(const Location &loc) {
         buffer_info.size = GetCmdErrorsCountsBufferByteSize();
         buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
         VmaAllocationCreateInfo alloc_info = {};
+        alloc_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
         alloc_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
         alloc_info.pool = gpuav->output_buffer_pool_;
+        VmaAllocationInfo allocation_info = {};
         result = vmaCreateBuffer(gpuav->vma_allocator_, &buffer_info, &alloc_info, &cmd_errors_counts_buffer_.buffer,
-                                 &cmd_errors_counts_buffer_.allocation, nullptr);
+                                 &cmd_errors_counts_buffer_.allocation, &allocation_info);
         if (result != VK_SUCCESS) {
             gpuav->InternalError(gpuav->device, loc, "Unable to allocate device memory for commands errors counts buffer.", true);
             return;
         }
+        if (!allocation_info.pMappedData) {
+            gpuav->InternalError(gpuav->device, loc, "Unable to map device memory for commands errors counts buffer.", true);
+            return;
+        }
 
-        ClearCmdErrorsCountsBuffer(loc);
-        if (gpuav->aborted_) return;
+        cmd_errors_counts_buffer_ptr_ = static_cast<uint32_t *>(allocation_info.pMappedData);
+        ClearCmdErrorsCountsBuffer();
     }
 
     // BDA snapshot
@@ -308,10 +318,14 @@ bool CommandBuffer::UpdateBdaRangesBuffer(const Location &loc) {
 
     // By supplying a "date"
     if (!gpuav->gpuav_settings.shader_instrumentation.buffer_device_address ||
-        bda_ranges_snapshot_version_ == gpuav->buffer_device_address_ranges_version) {
+        (bda_ranges_in_snapshot_ && bda_ranges_in_snapshot_->version == gpuav->buffer_device_address_ranges_version)) {
         return true;
     }
 
+    // The device level snapshot is only rebuilt when the address map changed, every other command buffer submitted for the
+    // same version shares it
+    auto bda_ranges = gpuav->GetBdaRanges();
+
     // Update buffer device address table
     // ---
     VkDeviceAddress *bda_table_ptr = nullptr;
@@ -324,7 +338,8 @@ bool CommandBuffer::UpdateBdaRangesBuffer(const Location &loc) {
     }
 
     // Buffer device address table layout
-    // Ranges are sorted from low to high, and do not overlap
+    // Ranges are sorted from low to high, and do not overlap (the shader binary searches the table, see
+    // buffer_device_address.comp)
     // QWord 0 | Number of *ranges* (1 range occupies 2 QWords)
     // QWord 1 | Range 1 begin
     // QWord 2 | Range 1 end
@@ -334,10 +349,35 @@ bool CommandBuffer::UpdateBdaRangesBuffer(const Location &loc) {
 
     const size_t max_recordable_ranges =
         static_cast<size_t>((GetBdaRangesBufferByteSize() - sizeof(uint64_t)) / (2 * sizeof(VkDeviceAddress)));
-    auto bda_ranges = reinterpret_cast<ValidationStateTracker::BufferAddressRange *>(bda_table_ptr + 1);
-    const auto [ranges_to_update_count, total_address_ranges_count] =
-        gpuav->GetBufferAddressRanges(bda_ranges, max_recordable_ranges);
+    const size_t total_address_ranges_count = bda_ranges->ranges.size();
+    const size_t ranges_to_update_count = std::min(max_recordable_ranges, total_address_ranges_count);
+
+    // Buffers are mostly created and destroyed at the high end of the address space, so the ranges leading up to the first
+    // one that changed since the last update are already in the table and are not written again
+    size_t first_changed_range = 0;
+    if (bda_ranges_in_snapshot_) {
+        const auto &written_ranges = bda_ranges_in_snapshot_->ranges;
+        const size_t comparable_count = std::min(written_ranges.size(), ranges_to_update_count);
+        first_changed_range = static_cast<size_t>(
+            std::mismatch(written_ranges.begin(), written_ranges.begin() + comparable_count, bda_ranges->ranges.begin()).first -
+            written_ranges.begin());
+    }
+
     bda_table_ptr[0] = ranges_to_update_count;
+    std::copy(bda_ranges->ranges.begin() + first_changed_range, bda_ranges->ranges.begin() + ranges_to_update_count,
+              reinterpret_cast<ValidationStateTracker::BufferAddressRange *>(bda_table_ptr + 1) + first_changed_range);
+
+    // Post update cleanups
+    // ---
+    // Flush what was written before un-mapping so that the new state is visible to the GPU
+    result = vmaFlushAllocation(gpuav->vma_allocator_, bda_ranges_snapshot_.allocation, 0, sizeof(VkDeviceAddress));
+    if (result == VK_SUCCESS && first_changed_range < ranges_to_update_count) {
+        const VkDeviceSize first_changed_offset = sizeof(VkDeviceAddress) * (1 + 2 * first_changed_range);
+        const VkDeviceSize changed_size = 2 * sizeof(VkDeviceAddress) * (ranges_to_update_count - first_changed_range);
+        result = vmaFlushAllocation(gpuav->vma_allocator_, bda_ranges_snapshot_.allocation, first_changed_offset, changed_size);
+    }
+    vmaUnmapMemory(gpuav->vma_allocator_, bda_ranges_snapshot_.allocation);
+    bda_ranges_in_snapshot_ = std::move(bda_ranges);
 
     if (total_address_ranges_count > size_t(gpuav->gpuav_settings.max_bda_in_use)) {
         std::ostringstream problem_string;
@@ -349,13 +389,6 @@ bool CommandBuffer::UpdateBdaRangesBuffer(const Location &loc) {
         return false;
     }
 
-    // Post update cleanups
-    // ---
-    // Flush the BDA buffer before un-mapping so that the new state is visible to the GPU
-    result = vmaFlushAllocation(gpuav->vma_allocator_, bda_ranges_snapshot_.allocation, 0, VK_WHOLE_SIZE);
-    vmaUnmapMemory(gpuav->vma_allocator_, bda_ranges_snapshot_.allocation);
-    bda_ranges_snapshot_version_ = gpuav->buffer_device_address_ranges_version;
-
     return true;
 }
 
@@ -400,9 +433,11 @@ void CommandBuffer::ResetCBState() {
     current_bindless_buffer = VK_NULL_HANDLE;
 
     error_output_buffer_.Destroy(gpuav->vma_allocator_);
+    error_output_buffer_ptr_ = nullptr;
     cmd_errors_counts_buffer_.Destroy(gpuav->vma_allocator_);
+    cmd_errors_counts_buffer_ptr_ = nullptr;
     bda_ranges_snapshot_.Destroy(gpuav->vma_allocator_);
-    bda_ranges_snapshot_version_ = 0;
+    bda_ranges_in_snapshot_.reset();
 
     if (validation_cmd_desc_pool_ != VK_NULL_HANDLE && validation_cmd_desc_set_ != VK_NULL_HANDLE) {
         gpuav->desc_set_manager_->PutBackDescriptorSet(validation_cmd_desc_pool_, validation_cmd_desc_set_);
@@ -425,17 +460,8 @@ void CommandBuffer::ResetCBState() {
     trace_rays_index = 0;
 }
 
-void CommandBuffer::ClearCmdErrorsCountsBuffer(const Location &loc) const {
-    auto gpuav = static_cast<Validator *>(&dev_data);
-    uint32_t *cmd_errors_counts_buffer_ptr = nullptr;
-    VkResult result = vmaMapMemory(gpuav->vma_allocator_, cmd_errors_counts_buffer_.allocation,
-                                   reinterpret_cast<void **>(&cmd_errors_counts_buffer_ptr));
-    if (result != VK_SUCCESS) {
-        gpuav->InternalError(gpuav->device, loc, "Unable to map device memory for commands errors counts buffer.", true);
-        return;
-    }
-    std::memset(cmd_errors_counts_buffer_ptr, 0, static_cast<size_t>(GetCmdErrorsCountsBufferByteSize()));
-    vmaUnmapMemory(gpuav->vma_allocator_, cmd_errors_counts_buffer_.allocation);
+void CommandBuffer::ClearCmdErrorsCountsBuffer() const {
+    std::memset(cmd_errors_counts_buffer_ptr_, 0, static_cast<size_t>(GetCmdErrorsCountsBufferByteSize()));
 }
 
 bool CommandBuffer::PreProcess(const Location &loc) {
@@ -454,10 +480,12 @@ bool CommandBuffer::PreProcess(const Location &loc) {
     return !per_command_error_loggers.empty() || has_build_as_cmd;
 }
 
-bool CommandBuffer::NeedsPostProcess() { return !error_output_buffer_.IsNull(); }
+bool CommandBuffer::NeedsPostProcess() { return error_output_buffer_ptr_ && cmd_errors_counts_buffer_ptr_; }
 
 // For the given command buffer, map its debug data buffers and read their contents for analysis.
 void CommandBuffer::PostProcess(VkQueue queue, const Location &loc) {
+    RetireBindlessStateBuffer(*this);
+
     // CommandBuffer::Destroy can happen on an other thread,
     // so when getting here after acquiring command buffer's lock,
     // make sure there are still things to process
@@ -467,51 +495,44 @@ void CommandBuffer::PostProcess(VkQueue queue, const Location &loc) {
 
     auto gpuav = static_cast<Validator *>(&dev_data);
     bool skip = false;
-    uint32_t *error_output_buffer_ptr = nullptr;
-    VkResult result =
-        vmaMapMemory(gpuav->vma_allocator_, error_output_buffer_.allocation, reinterpret_cast<void **>(&error_output_buffer_ptr));
-    assert(result == VK_SUCCESS);
-    if (result == VK_SUCCESS) {
-        // The second word in the debug output buffer is the number of words that would have
-        // been written by the shader instrumentation, if there was enough room in the buffer we provided.
-        // The number of words actually written by the shaders is determined by the size of the buffer
-        // we provide via the descriptor. So, we process only the number of words that can fit in the
-        // buffer.
-        const uint32_t total_words = error_output_buffer_ptr[cst::stream_output_size_offset];
-        // A zero here means that the shader instrumentation didn't write anything.
-        if (total_words != 0) {
-            uint32_t *const error_records_start = &error_output_buffer_ptr[cst::stream_output_data_offset];
-            assert(glsl::kErrorBufferByteSize > cst::stream_output_data_offset);
-            uint32_t *const error_records_end =
-                error_output_buffer_ptr + (glsl::kErrorBufferByteSize - cst::stream_output_data_offset);
-
-            uint32_t *error_record_ptr = error_records_start;
-            uint32_t record_size = error_record_ptr[glsl::kHeaderErrorRecordSizeOffset];
-            assert(record_size == glsl::kErrorRecordSize);
-
-            while (record_size > 0 && (error_record_ptr + record_size) <= error_records_end) {
-                const uint32_t error_logger_i = error_record_ptr[glsl::kHeaderCommandResourceIdOffset];
-                assert(error_logger_i < per_command_error_loggers.size());
-                auto &error_logger = per_command_error_loggers[error_logger_i];
-                const LogObjectList objlist(queue, VkHandle());
-                skip |= error_logger(*gpuav, error_record_ptr, objlist);
-
-                // Next record
-                error_record_ptr += record_size;
-                record_size = error_record_ptr[glsl::kHeaderErrorRecordSizeOffset];
-            }
-
-            // Clear the written size and any error messages. Note that this preserves the first word, which contains flags.
-            assert(glsl::kErrorBufferByteSize > cst::stream_output_data_offset);
-            memset(&error_output_buffer_ptr[cst::stream_output_data_offset], 0,
-                   glsl::kErrorBufferByteSize - cst::stream_output_data_offset * sizeof(uint32_t));
+    uint32_t *const error_output_buffer_ptr = error_output_buffer_ptr_;
+    // The second word in the debug output buffer is the number of words that would have
+    // been written by the shader instrumentation, if there was enough room in the buffer we provided.
+    // The number of words actually written by the shaders is determined by the size of the buffer
+    // we provide via the descriptor. So, we process only the number of words that can fit in the
+    // buffer.
+    const uint32_t total_words = error_output_buffer_ptr[cst::stream_output_size_offset];
+    // A zero here means that the shader instrumentation didn't write anything. Shaders only bump a command error count
+    // right before reserving room for an error record, so the counts buffer is still all zeros too and nothing needs
+    // to be cleared.
+    if (total_words != 0) {
+        uint32_t *const error_records_start = &error_output_buffer_ptr[cst::stream_output_data_offset];
+        assert(glsl::kErrorBufferByteSize > cst::stream_output_data_offset);
+        uint32_t *const error_records_end = error_output_buffer_ptr + (glsl::kErrorBufferByteSize - cst::stream_output_data_offset);
+
+        uint32_t *error_record_ptr = error_records_start;
+        uint32_t record_size = error_record_ptr[glsl::kHeaderErrorRecordSizeOffset];
+        assert(record_size == glsl::kErrorRecordSize);
+
+        const LogObjectList objlist(queue, VkHandle());
+        while (record_size > 0 && (error_record_ptr + record_size) <= error_records_end) {
+            const uint32_t error_logger_i = error_record_ptr[glsl::kHeaderCommandResourceIdOffset];
+            assert(error_logger_i < per_command_error_loggers.size());
+            auto &error_logger = per_command_error_loggers[error_logger_i];
+            skip |= error_logger(*gpuav, error_record_ptr, objlist);
+
+            // Next record
+            error_record_ptr += record_size;
+            record_size = error_record_ptr[glsl::kHeaderErrorRecordSizeOffset];
         }
+
+        // Clear the written size and any error messages. Note that this preserves the first word, which contains flags.
+        memset(&error_output_buffer_ptr[cst::stream_output_data_offset], 0,
+               glsl::kErrorBufferByteSize - cst::stream_output_data_offset * sizeof(uint32_t));
         error_output_buffer_ptr[cst::stream_output_size_offset] = 0;
-        vmaUnmapMemory(gpuav->vma_allocator_, error_output_buffer_.allocation);
-    }
 
-    ClearCmdErrorsCountsBuffer(loc);
-    if (gpuav->aborted_) return;
+        ClearCmdErrorsCountsBuffer();
+    }
 
     // If instrumentation found an error, skip post processing. Errors detected by instrumentation are usually
     // very serious, such as a prematurely destroyed resource and the state needed below is likely invalid.
@@ -35,6 +35,7 @@
 namespace gpuav {
 
 class Validator;
+struct BdaRanges;
 struct DescBindingInfo;
 
 class CommandBuffer : public gpu_tracker::CommandBuffer {
@@ -86,7 +87,7 @@ class CommandBuffer : public gpu_tracker::CommandBuffer {
 
     const gpu::DeviceMemoryBlock &GetBdaRangesSnapshot() const { return bda_ranges_snapshot_; }
 
-    void ClearCmdErrorsCountsBuffer(const Location &loc) const;
+    void ClearCmdErrorsCountsBuffer() const;
 
     void Destroy() final;
     void Reset(const Location &loc) final;
@@ -115,12 +116,15 @@ class CommandBuffer : public gpu_tracker::CommandBuffer {
 
     // Buffer storing GPU-AV errors
     gpu::DeviceMemoryBlock error_output_buffer_ = {};
+    uint32_t *error_output_buffer_ptr_ = nullptr;  // persistently mapped
     // Buffer storing an error count per validated commands.
     // Used to limit the number of errors a single command can emit.
     gpu::DeviceMemoryBlock cmd_errors_counts_buffer_ = {};
+    uint32_t *cmd_errors_counts_buffer_ptr_ = nullptr;  // persistently mapped
     // Buffer storing a snapshot of buffer device address ranges
     gpu::DeviceMemoryBlock bda_ranges_snapshot_ = {};
-    uint32_t bda_ranges_snapshot_version_ = 0;
+    // Device level ranges last written to bda_ranges_snapshot_, only what changed since is written on the next update
+    std::shared_ptr<const BdaRanges> bda_ranges_in_snapshot_;
 };
 
 class Buffer : public vvl::Buffer {
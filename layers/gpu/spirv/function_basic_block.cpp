@@ -38,7 +38,7 @@ void Function::ToBinary(std::vector<uint32_t>& out) {
     }
 }
 
-BasicBlock::BasicBlock(std::unique_ptr<Instruction> label, Function& function) : function_(function) {
+BasicBlock::BasicBlock(InstructionPtr label, Function& function) : function_(function) {
     // Used when loading initial SPIR-V
     instructions_.emplace_back(std::move(label));  // OpLabel
 }
@@ -88,7 +88,7 @@ void BasicBlock::CreateInstruction(spv::Op opcode, const std::vector<uint32_t>&
     }
 
     // Add 1 as we need to reserve the first word for the opcode/length
-    auto new_inst = std::make_unique<Instruction>((uint32_t)(words.size() + 1), opcode);
+    auto new_inst = function_.module_.NewInstruction((uint32_t)(words.size() + 1), opcode);
     new_inst->Fill(words);
 
     const uint32_t result_id = new_inst->ResultId();
@@ -104,13 +104,13 @@ void BasicBlock::CreateInstruction(spv::Op opcode, const std::vector<uint32_t>&
     }
 }
 
-Function::Function(Module& module, std::unique_ptr<Instruction> function_inst) : module_(module) {
+Function::Function(Module& module, InstructionPtr function_inst) : module_(module) {
     // Used when loading initial SPIR-V
     pre_block_inst_.emplace_back(std::move(function_inst));  // OpFunction
 }
 
 BasicBlockIt Function::InsertNewBlock(BasicBlockIt it) {
-    auto new_block = std::make_unique<BasicBlock>(module_, (*it)->function_);
+    auto new_block = vvl::MakeArenaUnique<BasicBlock>(module_.arena_, module_, (*it)->function_);
     it++;  // make sure it inserted after
     BasicBlockIt new_block_it = blocks_.insert(it, std::move(new_block));
 
@@ -120,7 +120,7 @@ BasicBlockIt Function::InsertNewBlock(BasicBlockIt it) {
 void Function::InitBlocks(uint32_t count) {
     blocks_.reserve(blocks_.size() + count);
     for (uint32_t i = 0; i < count; i++) {
-        auto new_block = std::make_unique<BasicBlock>(module_, *this);
+        auto new_block = vvl::MakeArenaUnique<BasicBlock>(module_.arena_, module_, *this);
         blocks_.emplace_back(std::move(new_block));
     }
 }
@@ -158,5 +158,35 @@ void Function::ReplaceAllUsesWith(uint32_t old_word, uint32_t new_word) {
     }
 }
 
+void Function::ApplyPredecessorRenames() {
+    if (predecessor_renames_.empty()) {
+        return;
+    }
+
+    for (auto& block : blocks_) {
+        for (auto& inst : block->instructions_) {
+            if (inst->Opcode() != spv::OpPhi) {
+                continue;
+            }
+            // OpPhi operands are pairs of (variable, parent block)
+            for (uint32_t parent_index = 4; parent_index < inst->Length(); parent_index += 2) {
+                const uint32_t old_label = inst->Word(parent_index);
+                auto rename = predecessor_renames_.find(old_label);
+                if (rename == predecessor_renames_.end()) {
+                    continue;
+                }
+                // A block split more than once is renamed to the last block it was split into
+                uint32_t new_label = rename->second;
+                for (rename = predecessor_renames_.find(new_label); rename != predecessor_renames_.end();
+                     rename = predecessor_renames_.find(new_label)) {
+                    new_label = rename->second;
+                }
+                inst->ReplaceOperandId(old_label, new_label);
+            }
+        }
+    }
+    predecessor_renames_.clear();
+}
+
 }  // namespace spirv
 }  // namespace gpu
\ No newline at end of file
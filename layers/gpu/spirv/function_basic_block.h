@@ -19,24 +19,25 @@
 #include <memory>
 #include <spirv/unified1/spirv.hpp>
 #include "containers/custom_containers.h"
+#include "containers/bump_arena.h"
+#include "instruction.h"
 
 namespace gpu {
 namespace spirv {
 
 class Module;
 struct Function;
-struct Instruction;
 
 // Core data structure of module.
 // The vector acts as our linked list to iterator and make occasional insertions.
-// The unique_ptr allows us to create instructions outside module scope and bring them back.
-using InstructionList = std::vector<std::unique_ptr<Instruction>>;
+// The InstructionPtr allows us to create instructions outside the list and bring them back.
+using InstructionList = std::vector<InstructionPtr>;
 using InstructionIt = InstructionList::iterator;
 
 // Since CFG analysis/manipulation is not a main focus, Blocks/Funcitons are just simple containers for ordering Instructions
 struct BasicBlock {
     // Used when loading initial SPIR-V
-    BasicBlock(std::unique_ptr<Instruction> label, Function& function);
+    BasicBlock(InstructionPtr label, Function& function);
     BasicBlock(Module& module, Function& function);
 
     void ToBinary(std::vector<uint32_t>& out);
@@ -59,11 +60,11 @@ struct BasicBlock {
     bool loop_header_ = false;
 };
 
-using BasicBlockList = std::vector<std::unique_ptr<BasicBlock>>;
+using BasicBlockList = std::vector<vvl::ArenaUniquePtr<BasicBlock>>;
 using BasicBlockIt = BasicBlockList::iterator;
 
 struct Function {
-    Function(Module& module, std::unique_ptr<Instruction> function_inst);
+    Function(Module& module, InstructionPtr function_inst);
     Function(Module& module) : module_(module) {}
 
     void ToBinary(std::vector<uint32_t>& out);
@@ -77,6 +78,12 @@ struct Function {
 
     void ReplaceAllUsesWith(uint32_t old_word, uint32_t new_word);
 
+    // When a block is split, its terminator (and so the edges to its successors) moves to the new block and any OpPhi using
+    // the old block as a parent has to be updated. Instead of walking the whole function for each split, renames are collected
+    // and applied in a single walk once the function is done being instrumented.
+    void RenamePredecessor(uint32_t old_label, uint32_t new_label) { predecessor_renames_[old_label] = new_label; }
+    void ApplyPredecessorRenames();
+
     Module& module_;
     // OpFunction and parameters
     InstructionList pre_block_inst_;
@@ -100,9 +107,12 @@ struct Function {
     uint32_t stage_info_y_id_ = 0;
     uint32_t stage_info_z_id_ = 0;
     uint32_t stage_info_w_id_ = 0;
+
+    // < old label, new label > waiting for ApplyPredecessorRenames()
+    vvl::unordered_map<uint32_t, uint32_t> predecessor_renames_;
 };
 
-using FunctionList = std::vector<std::unique_ptr<Function>>;
+using FunctionList = std::vector<vvl::ArenaUniquePtr<Function>>;
 using FunctionIt = FunctionList::iterator;
 
 }  // namespace spirv
@@ -41,7 +41,7 @@ BasicBlockIt InjectConditionalFunctionPass::InjectFunction(Function* function, B
     const uint32_t merge_block_label = merge_block.GetLabelId();
 
     // need to preserve the control-flow of how things, like a OpPhi, are accessed from a predecessor block
-    function->ReplaceAllUsesWith(original_label, merge_block_label);
+    function->RenamePredecessor(original_label, merge_block_label);
 
     // Move the targeted instruction to a valid block
     const Instruction& target_inst = *valid_block.instructions_.emplace_back(std::move(*inst_it));
@@ -114,6 +114,48 @@ BasicBlockIt InjectConditionalFunctionPass::InjectFunction(Function* function, B
     return block_it;
 }
 
+bool InjectConditionalFunctionPass::InstrumentInstruction(Function& function, BasicBlockIt& block_it, InstructionIt& inst_it) {
+    // Every instruction is analyzed by the specific pass and lets us know if we need to inject a function or not
+    if (!AnalyzeInstruction(function, *(inst_it->get()))) {
+        // TODO - This should be cleaned up then having it injected here
+        // we can have a situation where the incoming SPIR-V looks like
+        // %a = OpSampledImage %type %image %sampler
+        // ... other stuff we inject a
+        // function around
+        // %b = OpImageSampleExplicitLod %type2 %a %3893 Lod %3918
+        // and we get an error "All OpSampledImage instructions must be in the same block in which their Result <id> are
+        // consumed" to get around this we inject a OpCopyObject right after the OpSampledImage
+        if ((*inst_it)->Opcode() == spv::OpSampledImage) {
+            const uint32_t result_id = (*inst_it)->ResultId();
+            const uint32_t type_id = (*inst_it)->TypeId();
+            const uint32_t copy_id = module_.TakeNextId();
+            function.ReplaceAllUsesWith(result_id, copy_id);
+            inst_it++;
+            (*block_it)->CreateInstruction(spv::OpCopyObject, {type_id, copy_id, result_id}, &inst_it);
+            inst_it--;
+        }
+        return false;
+    }
+
+    if (module_.max_instrumented_count_ != 0 && instrumented_count_ >= module_.max_instrumented_count_) {
+        instrumentation_limit_reached_ = true;
+        return false;
+    }
+    instrumented_count_++;
+
+    // Add any debug information to pass into the function call
+    InjectionData injection_data;
+    injection_data.stage_info_id = GetStageInfo(function, block_it, inst_it);
+    const uint32_t inst_position = target_instruction_->position_index_;
+    auto inst_position_constant = module_.type_manager_.CreateConstantUInt32(inst_position);
+    injection_data.inst_position_id = inst_position_constant.Id();
+
+    // Returns the merge block, the targeted instruction is now alone (before its OpBranch) in the valid block two blocks back
+    block_it = std::prev(InjectFunction(&function, block_it, inst_it, injection_data), 2);
+    inst_it = (*block_it)->instructions_.begin();
+    return true;
+}
+
 bool InjectConditionalFunctionPass::Run() {
     // Can safely loop function list as there is no injecting of new Functions until linking time
     for (const auto& function : module_.functions_) {
@@ -123,46 +165,18 @@ bool InjectConditionalFunctionPass::Run() {
             }
             auto& block_instructions = (*block_it)->instructions_;
             for (auto inst_it = block_instructions.begin(); inst_it != block_instructions.end(); ++inst_it) {
-                // Every instruction is analyzed by the specific pass and lets us know if we need to inject a function or not
-                if (!AnalyzeInstruction(*function, *(inst_it->get()))) {
-                    // TODO - This should be cleaned up then having it injected here
-                    // we can have a situation where the incoming SPIR-V looks like
-                    // %a = OpSampledImage %type %image %sampler
-                    // ... other stuff we inject a
-                    // function around
-                    // %b = OpImageSampleExplicitLod %type2 %a %3893 Lod %3918
-                    // and we get an error "All OpSampledImage instructions must be in the same block in which their Result <id> are
-                    // consumed" to get around this we inject a OpCopyObject right after the OpSampledImage
-                    if ((*inst_it)->Opcode() == spv::OpSampledImage) {
-                        const uint32_t result_id = (*inst_it)->ResultId();
-                        const uint32_t type_id = (*inst_it)->TypeId();
-                        const uint32_t copy_id = module_.TakeNextId();
-                        function->ReplaceAllUsesWith(result_id, copy_id);
-                        inst_it++;
-                        (*block_it)->CreateInstruction(spv::OpCopyObject, {type_id, copy_id, result_id}, &inst_it);
-                        inst_it--;
-                    }
-                    continue;
+                if (InstrumentInstruction(*function, block_it, inst_it)) {
+                    // will start searching again from newly split merge block, right after the invalid block
+                    block_it++;
+                    break;
                 }
-
-                if (module_.max_instrumented_count_ != 0 && instrumented_count_ >= module_.max_instrumented_count_) {
+                if (instrumentation_limit_reached_) {
+                    function->ApplyPredecessorRenames();
                     return true;  // hit limit
                 }
-                instrumented_count_++;
-
-                // Add any debug information to pass into the function call
-                InjectionData injection_data;
-                injection_data.stage_info_id = GetStageInfo(*function, block_it, inst_it);
-                const uint32_t inst_position = target_instruction_->position_index_;
-                auto inst_position_constant = module_.type_manager_.CreateConstantUInt32(inst_position);
-                injection_data.inst_position_id = inst_position_constant.Id();
-
-                block_it = InjectFunction(function.get(), block_it, inst_it, injection_data);
-                // will start searching again from newly split merge block
-                block_it--;
-                break;
             }
         }
+        function->ApplyPredecessorRenames();
     }
 
     return instrumented_count_ != 0;
@@ -47,6 +47,7 @@ namespace spirv {
 class InjectConditionalFunctionPass : public Pass {
   public:
     bool Run() final;
+    bool InstrumentInstruction(Function& function, BasicBlockIt& block_it, InstructionIt& inst_it) final;
 
   protected:
     InjectConditionalFunctionPass(Module& module);
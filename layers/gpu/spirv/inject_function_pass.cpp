@@ -21,6 +21,29 @@ namespace spirv {
 
 InjectFunctionPass::InjectFunctionPass(Module& module) : Pass(module) { module.use_bda_ = true; }
 
+bool InjectFunctionPass::InstrumentInstruction(Function& function, BasicBlockIt& block_it, InstructionIt& inst_it) {
+    // Every instruction is analyzed by the specific pass and lets us know if we need to inject a function or not
+    if (!AnalyzeInstruction(function, *(inst_it->get()))) return false;
+
+    if (module_.max_instrumented_count_ != 0 && instrumented_count_ >= module_.max_instrumented_count_) {
+        instrumentation_limit_reached_ = true;
+        return false;
+    }
+    instrumented_count_++;
+
+    // Add any debug information to pass into the function call
+    InjectionData injection_data;
+    injection_data.stage_info_id = GetStageInfo(function, block_it, inst_it);
+    const uint32_t inst_position = target_instruction_->position_index_;
+    auto inst_position_constant = module_.type_manager_.CreateConstantUInt32(inst_position);
+    injection_data.inst_position_id = inst_position_constant.Id();
+
+    // inst_it is updated to the instruction after the new function call, it will not add/remove any Blocks
+    CreateFunctionCall(**block_it, &inst_it, injection_data);
+    Reset();
+    return true;
+}
+
 bool InjectFunctionPass::Run() {
     // Can safely loop function list as there is no injecting of new Functions until linking time
     for (const auto& function : module_.functions_) {
@@ -30,24 +53,10 @@ bool InjectFunctionPass::Run() {
             }
             auto& block_instructions = (*block_it)->instructions_;
             for (auto inst_it = block_instructions.begin(); inst_it != block_instructions.end(); ++inst_it) {
-                // Every instruction is analyzed by the specific pass and lets us know if we need to inject a function or not
-                if (!AnalyzeInstruction(*function, *(inst_it->get()))) continue;
-
-                if (module_.max_instrumented_count_ != 0 && instrumented_count_ >= module_.max_instrumented_count_) {
+                InstrumentInstruction(*function, block_it, inst_it);
+                if (instrumentation_limit_reached_) {
                     return true;  // hit limit
                 }
-                instrumented_count_++;
-
-                // Add any debug information to pass into the function call
-                InjectionData injection_data;
-                injection_data.stage_info_id = GetStageInfo(*function, block_it, inst_it);
-                const uint32_t inst_position = target_instruction_->position_index_;
-                auto inst_position_constant = module_.type_manager_.CreateConstantUInt32(inst_position);
-                injection_data.inst_position_id = inst_position_constant.Id();
-
-                // inst_it is updated to the instruction after the new function call, it will not add/remove any Blocks
-                CreateFunctionCall(**block_it, &inst_it, injection_data);
-                Reset();
             }
         }
     }
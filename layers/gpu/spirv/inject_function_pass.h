@@ -26,6 +26,7 @@ namespace spirv {
 class InjectFunctionPass : public Pass {
   public:
     bool Run() final;
+    bool InstrumentInstruction(Function& function, BasicBlockIt& block_it, InstructionIt& inst_it) final;
 
   protected:
     InjectFunctionPass(Module& module);
@@ -18,6 +18,7 @@
 #include <stddef.h>
 #include <vector>
 #include "containers/custom_containers.h"
+#include "containers/bump_arena.h"
 #include <spirv/unified1/spirv.hpp>
 
 struct OperandInfo;
@@ -107,6 +108,10 @@ struct Instruction {
 #endif
 };
 
+// Instructions of a Module are placed in its arena (see Module::NewInstruction()), so building the IR doesn't do an allocation
+// per instruction and everything is freed at once with the Module.
+using InstructionPtr = vvl::ArenaUniquePtr<Instruction>;
+
 void GenerateInstructions(const vvl::span<const uint32_t>& spirv, std::vector<Instruction>& instructions);
 
 }  // namespace spirv
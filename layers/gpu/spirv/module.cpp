@@ -25,13 +25,21 @@
 #include "ray_query_pass.h"
 #include "debug_printf_pass.h"
 
+#include <algorithm>
+#include <memory>
 #include <iostream>
 
 namespace gpu {
 namespace spirv {
 
+// The whole parsed module, plus what the passes add, usually ends up in a couple of blocks
+static size_t ArenaBlockSize(size_t word_count) {
+    return std::clamp(word_count * sizeof(Instruction) / 2, vvl::BumpArena::kDefaultBlockSize, size_t(1024 * 1024));
+}
+
 Module::Module(vvl::span<const uint32_t> words, DebugReport* debug_report, const Settings& settings)
-    : type_manager_(*this),
+    : arena_(ArenaBlockSize(words.size())),
+      type_manager_(*this),
       max_instrumented_count_(settings.max_instrumented_count),
       shader_id_(settings.shader_id),
       output_buffer_descriptor_set_(settings.output_buffer_descriptor_set),
@@ -46,6 +54,7 @@ Module::Module(vvl::span<const uint32_t> words, DebugReport* debug_report, const
     header_.version = *it++;
     header_.generator = *it++;
     header_.bound = *it++;
+    original_id_bound_ = header_.bound;
     header_.schema = *it++;
     // Parse everything up until the first function and sort into seperate lists
     while (it != words.end()) {
@@ -54,7 +63,7 @@ Module::Module(vvl::span<const uint32_t> words, DebugReport* debug_report, const
         if (opcode == spv::OpFunction) {
             break;
         }
-        auto new_inst = std::make_unique<Instruction>(it, instruction_count++);
+        auto new_inst = NewInstruction(it, instruction_count++);
 
         switch (opcode) {
             case spv::OpCapability:
@@ -163,10 +172,10 @@ Module::Module(vvl::span<const uint32_t> words, DebugReport* debug_report, const
     while (it != words.end()) {
         const uint32_t opcode = *it & 0x0ffffu;
         const uint32_t length = *it >> 16;
-        auto new_inst = std::make_unique<Instruction>(it, instruction_count++);
+        auto new_inst = NewInstruction(it, instruction_count++);
 
         if (opcode == spv::OpFunction) {
-            auto new_function = std::make_unique<Function>(*this, std::move(new_inst));
+            auto new_function = vvl::MakeArenaUnique<Function>(arena_, *this, std::move(new_inst));
             auto& added_function = functions_.emplace_back(std::move(new_function));
             current_function = &(*added_function);
             block_found = false;
@@ -190,7 +199,7 @@ Module::Module(vvl::span<const uint32_t> words, DebugReport* debug_report, const
 
         if (opcode == spv::OpLabel) {
             block_found = true;
-            auto new_block = std::make_unique<BasicBlock>(std::move(new_inst), *current_function);
+            auto new_block = vvl::MakeArenaUnique<BasicBlock>(arena_, std::move(new_inst), *current_function);
             auto& added_block = current_function->blocks_.emplace_back(std::move(new_block));
             current_block = &(*added_block);
         } else if (function_end_found) {
@@ -235,7 +244,7 @@ static void StringToSpirv(const char* input, std::vector<uint32_t>& output) {
 // Will only add if not already added
 void Module::AddCapability(spv::Capability capability) {
     if (!HasCapability(capability)) {
-        auto new_inst = std::make_unique<Instruction>(2, spv::OpCapability);
+        auto new_inst = NewInstruction(2, spv::OpCapability);
         new_inst->Fill({(uint32_t)capability});
         capabilities_.emplace_back(std::move(new_inst));
     }
@@ -244,7 +253,7 @@ void Module::AddCapability(spv::Capability capability) {
 void Module::AddExtension(const char* extension) {
     std::vector<uint32_t> words;
     StringToSpirv(extension, words);
-    auto new_inst = std::make_unique<Instruction>((uint32_t)(words.size() + 1), spv::OpExtension);
+    auto new_inst = NewInstruction((uint32_t)(words.size() + 1), spv::OpExtension);
     new_inst->Fill(words);
     extensions_.emplace_back(std::move(new_inst));
 }
@@ -252,13 +261,13 @@ void Module::AddExtension(const char* extension) {
 void Module::AddDebugName(const char* name, uint32_t id) {
     std::vector<uint32_t> words = {id};
     StringToSpirv(name, words);
-    auto new_inst = std::make_unique<Instruction>((uint32_t)(words.size() + 1), spv::OpName);
+    auto new_inst = NewInstruction((uint32_t)(words.size() + 1), spv::OpName);
     new_inst->Fill(words);
     debug_name_.emplace_back(std::move(new_inst));
 }
 
 void Module::AddDecoration(uint32_t target_id, spv::Decoration decoration, const std::vector<uint32_t>& operands) {
-    auto new_inst = std::make_unique<Instruction>((uint32_t)(operands.size() + 3), spv::OpDecorate);
+    auto new_inst = NewInstruction((uint32_t)(operands.size() + 3), spv::OpDecorate);
     new_inst->Fill({target_id, (uint32_t)decoration});
     if (!operands.empty()) {
         new_inst->Fill(operands);
@@ -268,7 +277,7 @@ void Module::AddDecoration(uint32_t target_id, spv::Decoration decoration, const
 
 void Module::AddMemberDecoration(uint32_t target_id, uint32_t index, spv::Decoration decoration,
                                  const std::vector<uint32_t>& operands) {
-    auto new_inst = std::make_unique<Instruction>((uint32_t)(operands.size() + 4), spv::OpMemberDecorate);
+    auto new_inst = NewInstruction((uint32_t)(operands.size() + 4), spv::OpMemberDecorate);
     new_inst->Fill({target_id, index, (uint32_t)decoration});
     if (!operands.empty()) {
         new_inst->Fill(operands);
@@ -321,6 +330,71 @@ bool Module::RunPassRayQuery() {
     return changed;
 }
 
+bool Module::RunInstrumentationPasses(const InstrumentationPasses& passes) {
+    // Same order as the instrumentor used to run them one after the other
+    std::vector<std::unique_ptr<Pass>> enabled_passes;
+    if (passes.bindless_descriptor) {
+        enabled_passes.emplace_back(std::make_unique<BindlessDescriptorPass>(*this));
+    }
+    if (passes.non_bindless_oob_buffer) {
+        enabled_passes.emplace_back(std::make_unique<NonBindlessOOBBufferPass>(*this));
+    }
+    if (passes.non_bindless_oob_texel_buffer) {
+        enabled_passes.emplace_back(std::make_unique<NonBindlessOOBTexelBufferPass>(*this));
+    }
+    if (passes.buffer_device_address) {
+        enabled_passes.emplace_back(std::make_unique<BufferDeviceAddressPass>(*this));
+    }
+    if (passes.ray_query) {
+        enabled_passes.emplace_back(std::make_unique<RayQueryPass>(*this));
+    }
+
+    // Every instruction is visited once and handed to each pass in turn, instead of each pass walking the whole module.
+    // An instruction more than one pass wants is wrapped by them in the same order as before, so the checks are nested the
+    // same way. The instructions the passes inject are not visited again, none of them are something a pass instruments.
+    bool changed = false;
+    // Can safely loop function list as there is no injecting of new Functions until linking time
+    for (const auto& function : functions_) {
+        for (auto block_it = function->blocks_.begin(); block_it != function->blocks_.end(); ++block_it) {
+            if ((*block_it)->loop_header_) {
+                continue;  // Currently can't properly handle injecting CFG logic into a loop header block
+            }
+            for (auto inst_it = (*block_it)->instructions_.begin(); inst_it != (*block_it)->instructions_.end(); ++inst_it) {
+                const BasicBlock* target_block = block_it->get();
+                // Where the instructions after the target went if a pass wrapped it in new blocks
+                const BasicBlock* next_block = nullptr;
+                for (auto& pass : enabled_passes) {
+                    if (pass->InstrumentationLimitReached() || !pass->InstrumentInstruction(*function, block_it, inst_it)) {
+                        continue;
+                    }
+                    changed = true;
+                    if (!next_block && block_it->get() != target_block) {
+                        next_block = std::next(block_it, 2)->get();
+                    }
+                }
+
+                if (next_block) {
+                    // Later passes could have split the target's block again, the blocks they added all come before next_block
+                    while (block_it->get() != next_block) {
+                        ++block_it;
+                    }
+                    // will start searching again from the first instruction after the target
+                    --block_it;
+                    break;
+                }
+            }
+        }
+        function->ApplyPredecessorRenames();
+    }
+
+    if (print_debug_info_) {
+        for (const auto& pass : enabled_passes) {
+            pass->PrintDebugInfo();
+        }
+    }
+    return changed;
+}
+
 // binding slot allows debug printf to be slotted in the same set as GPU-AV if needed
 bool Module::RunPassDebugPrintf(uint32_t binding_slot) {
     DebugPrintfPass pass(*this, binding_slot);
@@ -418,7 +492,7 @@ void Module::LinkFunction(const LinkInfo& info) {
             break;
         }
 
-        auto new_inst = std::make_unique<Instruction>(inst_word, kLinkedInstruction);
+        auto new_inst = NewInstruction(inst_word, kLinkedInstruction);
         uint32_t old_result_id = new_inst->ResultId();
 
         SpvType spv_type = GetSpvType(opcode);
@@ -605,10 +679,10 @@ void Module::LinkFunction(const LinkInfo& info) {
     AddDebugName(info.opname, info.function_id);
 
     // Add function and copy all instructions to it, while adjusting any IDs
-    auto& new_function = functions_.emplace_back(std::make_unique<Function>(*this));
+    auto& new_function = functions_.emplace_back(vvl::MakeArenaUnique<Function>(arena_, *this));
     while (offset < info.word_count) {
         const uint32_t* inst_word = &info.words[offset];
-        auto new_inst = std::make_unique<Instruction>(inst_word, kLinkedInstruction);
+        auto new_inst = NewInstruction(inst_word, kLinkedInstruction);
         const uint32_t opcode = new_inst->Opcode();
         const uint32_t length = new_inst->Length();
 
@@ -697,6 +771,109 @@ void Module::PostProcess() {
         // SPV_KHR_storage_buffer_storage_class is needed, but glslang removes it from linking functions
         AddExtension("SPV_KHR_storage_buffer_storage_class");
     }
+
+    RemoveUnusedAddedValues();
+}
+
+// OpName/OpDecorate and friends only point at their target, they don't keep it alive
+static bool IsTargetOnlyInstruction(uint32_t opcode) {
+    switch (opcode) {
+        case spv::OpName:
+        case spv::OpMemberName:
+        case spv::OpDecorate:
+        case spv::OpMemberDecorate:
+        case spv::OpDecorateString:
+        case spv::OpMemberDecorateString:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Linking copies every type/constant/variable of the GLSL module, and the passes grab types and constants as they go, so not
+// everything added is used in the end. Only IDs above original_id_bound_ are looked at, the original shader is left as is.
+//
+// Any word of an instruction matching an ID counts as a use (only the Result ID is skipped). A literal that happens to match just
+// keeps the value around, it never removes something still used.
+void Module::RemoveUnusedAddedValues() {
+    // < id, use count >
+    vvl::unordered_map<uint32_t, int32_t> use_counts;
+    for (const auto& inst : types_values_constants_) {
+        const uint32_t opcode = inst->Opcode();
+        const uint32_t result_id = inst->ResultId();
+        if (result_id >= original_id_bound_ &&
+            (GetSpvType(opcode) != SpvType::Empty || ConstantOperation(opcode) || opcode == spv::OpVariable)) {
+            use_counts[result_id] = 0;
+        }
+    }
+    if (use_counts.empty()) {
+        return;
+    }
+
+    auto count_uses = [&use_counts](const Instruction& inst, int32_t delta) {
+        for (uint32_t i = 1; i < inst.Length(); i++) {
+            if (i == inst.result_id_index_) {
+                continue;
+            }
+            auto it = use_counts.find(inst.Word(i));
+            if (it != use_counts.end()) {
+                it->second += delta;
+            }
+        }
+    };
+    auto count_list_uses = [&count_uses](const InstructionList& list) {
+        for (const auto& inst : list) {
+            if (!IsTargetOnlyInstruction(inst->Opcode())) {
+                count_uses(*inst, 1);
+            }
+        }
+    };
+
+    count_list_uses(capabilities_);
+    count_list_uses(extensions_);
+    count_list_uses(ext_inst_imports_);
+    count_list_uses(memory_model_);
+    // Variables added to the interface are kept, same as the entry point interface is never changed
+    count_list_uses(entry_points_);
+    count_list_uses(execution_modes_);
+    count_list_uses(debug_source_);
+    count_list_uses(debug_name_);
+    count_list_uses(debug_module_processed_);
+    count_list_uses(annotations_);
+    count_list_uses(types_values_constants_);
+    for (const auto& function : functions_) {
+        count_list_uses(function->pre_block_inst_);
+        for (const auto& block : function->blocks_) {
+            count_list_uses(block->instructions_);
+        }
+        count_list_uses(function->post_block_inst_);
+    }
+
+    // Types, constants and variables are declared before their uses, so going backwards, once an unused one is removed, the
+    // ones it was using have seen all of their uses
+    vvl::unordered_set<uint32_t> removed_ids;
+    for (auto it = types_values_constants_.rbegin(); it != types_values_constants_.rend(); ++it) {
+        const Instruction& inst = **it;
+        auto use_count = use_counts.find(inst.ResultId());
+        if (use_count != use_counts.end() && use_count->second == 0) {
+            removed_ids.insert(inst.ResultId());
+            count_uses(inst, -1);
+        }
+    }
+    if (removed_ids.empty()) {
+        return;
+    }
+
+    // The TypeManager still points to the instructions, so it has to let go first
+    type_manager_.RemoveIds(removed_ids);
+
+    auto is_removed = [&removed_ids](const InstructionPtr& inst) { return removed_ids.count(inst->ResultId()) != 0; };
+    auto targets_removed = [&removed_ids](const InstructionPtr& inst) {
+        return IsTargetOnlyInstruction(inst->Opcode()) && removed_ids.count(inst->Word(1)) != 0;
+    };
+    vvl::erase_if(types_values_constants_, is_removed);
+    vvl::erase_if(debug_name_, targets_removed);
+    vvl::erase_if(annotations_, targets_removed);
 }
 
 void Module::InternalWarning(const char* tag, const char* message) {
@@ -34,6 +34,15 @@ struct ModuleHeader {
     uint32_t schema;
 };
 
+// GPU-AV instrumentation passes for Module::RunInstrumentationPasses
+struct InstrumentationPasses {
+    bool bindless_descriptor = false;
+    bool non_bindless_oob_buffer = false;
+    bool non_bindless_oob_texel_buffer = false;
+    bool buffer_device_address = false;
+    bool ray_query = false;
+};
+
 struct Settings {
     uint32_t shader_id;
     uint32_t output_buffer_descriptor_set;
@@ -50,6 +59,14 @@ class Module {
   public:
     Module(vvl::span<const uint32_t> words, DebugReport* debug_report, const Settings& settings);
 
+    // Backs every Instruction, BasicBlock and Function of the module, needs to be declared before anything holding them so it
+    // is destroyed last.
+    vvl::BumpArena arena_;
+    template <typename... Args>
+    InstructionPtr NewInstruction(Args&&... args) {
+        return vvl::MakeArenaUnique<Instruction>(arena_, std::forward<Args>(args)...);
+    }
+
     // Memory that holds all the actual SPIR-V data, replicate the "Logical Layout of a Module" of SPIR-V.
     // Divided into sections to make easier to modify each part at different times, but still keeps it simple to write out all the
     // instructions to a binary format.
@@ -72,11 +89,15 @@ class Module {
 
     // When adding a new instruction with result ID, will need to grab the next ID
     uint32_t TakeNextId();
+    // The bound of the incoming module, every ID from here on was added while instrumenting
+    uint32_t original_id_bound_ = 0;
 
     // Order of functions that will try to be linked in
     std::vector<LinkInfo> link_info_;
     void LinkFunction(const LinkInfo& info);
     void PostProcess();
+    // Removes the types, constants and global variables that were added while instrumenting but nothing ended up using
+    void RemoveUnusedAddedValues();
 
     // The class is designed to be written out to a binary file.
     void ToBinary(std::vector<uint32_t>& out);
@@ -90,6 +111,9 @@ class Module {
     bool RunPassRayQuery();
     bool RunPassDebugPrintf(uint32_t binding_slot = 0);
 
+    // Runs the enabled GPU-AV passes together in a single walk over the module
+    bool RunInstrumentationPasses(const InstrumentationPasses& passes);
+
     void AddInterfaceVariables(uint32_t id, spv::StorageClass storage_class);
 
     // Helpers
@@ -28,6 +28,7 @@ class NonBindlessOOBBufferPass : public Pass {
     void PrintDebugInfo() final;
     const char* Name() const final { return "NonBindlessOOBBufferPass"; }
     bool Run() final;
+    bool InstrumentInstruction(Function& function, BasicBlockIt& block_it, InstructionIt& inst_it) final;
 
   private:
     bool AnalyzeInstruction(const Function& function, const Instruction& inst);
@@ -26,7 +26,7 @@ namespace spirv {
 
 NonBindlessOOBTexelBufferPass::NonBindlessOOBTexelBufferPass(Module& module) : Pass(module) { module.use_bda_ = true; }
 
-static LinkInfo link_info = {instrumentation_non_bindless_oob_texel_buffer_comp,
+static const LinkInfo link_info = {instrumentation_non_bindless_oob_texel_buffer_comp,
                              instrumentation_non_bindless_oob_texel_buffer_comp_size,
                              LinkFunctions::inst_non_bindless_oob_texel_buffer, 0, "inst_non_bindless_oob_texel_buffer"};
 
@@ -34,8 +34,8 @@ static LinkInfo link_info = {instrumentation_non_bindless_oob_texel_buffer_comp,
 uint32_t NonBindlessOOBTexelBufferPass::GetLinkFunctionId() {
     if (link_function_id == 0) {
         link_function_id = module_.TakeNextId();
-        link_info.function_id = link_function_id;
         module_.link_info_.push_back(link_info);
+        module_.link_info_.back().function_id = link_function_id;
     }
     return link_function_id;
 }
@@ -193,6 +193,30 @@ void NonBindlessOOBTexelBufferPass::PrintDebugInfo() {
     std::cout << "NonBindlessOOBTexelBufferPass instrumentation count: " << instrumented_count_ << '\n';
 }
 
+bool NonBindlessOOBTexelBufferPass::InstrumentInstruction(Function& function, BasicBlockIt& block_it, InstructionIt& inst_it) {
+    if (module_.has_bindless_descriptors_) return false;
+    // Every instruction is analyzed by the specific pass and lets us know if we need to inject a function or not
+    if (!AnalyzeInstruction(function, *(inst_it->get()))) return false;
+
+    if (module_.max_instrumented_count_ != 0 && instrumented_count_ >= module_.max_instrumented_count_) {
+        instrumentation_limit_reached_ = true;
+        return false;
+    }
+    instrumented_count_++;
+
+    // Add any debug information to pass into the function call
+    InjectionData injection_data;
+    injection_data.stage_info_id = GetStageInfo(function, block_it, inst_it);
+    const uint32_t inst_position = target_instruction_->position_index_;
+    auto inst_position_constant = module_.type_manager_.CreateConstantUInt32(inst_position);
+    injection_data.inst_position_id = inst_position_constant.Id();
+
+    // inst_it is updated to the instruction after the new function call, it will not add/remove any Blocks
+    CreateFunctionCall(**block_it, &inst_it, injection_data);
+    Reset();
+    return true;
+}
+
 // Created own Run() because need to control finding the largest offset in a given block
 bool NonBindlessOOBTexelBufferPass::Run() {
     if (module_.has_bindless_descriptors_) return false;
@@ -204,24 +228,10 @@ bool NonBindlessOOBTexelBufferPass::Run() {
             }
             auto& block_instructions = (*block_it)->instructions_;
             for (auto inst_it = block_instructions.begin(); inst_it != block_instructions.end(); ++inst_it) {
-                // Every instruction is analyzed by the specific pass and lets us know if we need to inject a function or not
-                if (!AnalyzeInstruction(*function, *(inst_it->get()))) continue;
-
-                if (module_.max_instrumented_count_ != 0 && instrumented_count_ >= module_.max_instrumented_count_) {
+                InstrumentInstruction(*function, block_it, inst_it);
+                if (instrumentation_limit_reached_) {
                     return true;  // hit limit
                 }
-                instrumented_count_++;
-
-                // Add any debug information to pass into the function call
-                InjectionData injection_data;
-                injection_data.stage_info_id = GetStageInfo(*function, block_it, inst_it);
-                const uint32_t inst_position = target_instruction_->position_index_;
-                auto inst_position_constant = module_.type_manager_.CreateConstantUInt32(inst_position);
-                injection_data.inst_position_id = inst_position_constant.Id();
-
-                // inst_it is updated to the instruction after the new function call, it will not add/remove any Blocks
-                CreateFunctionCall(**block_it, &inst_it, injection_data);
-                Reset();
             }
         }
     }
@@ -28,6 +28,7 @@ class NonBindlessOOBTexelBufferPass : public Pass {
     void PrintDebugInfo() final;
     const char* Name() const final { return "NonBindlessOOBTexelBufferPass"; }
     bool Run() final;
+    bool InstrumentInstruction(Function& function, BasicBlockIt& block_it, InstructionIt& inst_it) final;
 
   private:
     bool AnalyzeInstruction(const Function& function, const Instruction& inst);
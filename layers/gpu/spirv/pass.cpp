@@ -32,7 +32,7 @@ const Variable& Pass::GetBuiltinVariable(uint32_t built_in) {
 
     if (variable_id == 0) {
         variable_id = module_.TakeNextId();
-        auto new_inst = std::make_unique<Instruction>(4, spv::OpDecorate);
+        auto new_inst = module_.NewInstruction(4, spv::OpDecorate);
         new_inst->Fill({variable_id, spv::DecorationBuiltIn, built_in});
         module_.annotations_.emplace_back(std::move(new_inst));
     }
@@ -42,7 +42,7 @@ const Variable& Pass::GetBuiltinVariable(uint32_t built_in) {
     const Variable* built_in_variable = module_.type_manager_.FindVariableById(variable_id);
     if (!built_in_variable) {
         const Type& pointer_type = module_.type_manager_.GetTypePointerBuiltInInput(spv::BuiltIn(built_in));
-        auto new_inst = std::make_unique<Instruction>(4, spv::OpVariable);
+        auto new_inst = module_.NewInstruction(4, spv::OpVariable);
         new_inst->Fill({pointer_type.Id(), variable_id, spv::StorageClassInput});
         built_in_variable = &module_.type_manager_.AddVariable(std::move(new_inst), pointer_type);
         module_.AddInterfaceVariables(built_in_variable->Id(), spv::StorageClassInput);
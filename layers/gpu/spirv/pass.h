@@ -34,10 +34,18 @@ struct InjectionData {
 // Common helpers for all passes
 class Pass {
   public:
+    virtual ~Pass() = default;
     virtual const char* Name() const = 0;
     // Return false if nothing was changed
     virtual bool Run() { return false; }
 
+    // For passes that check single instructions, lets several of them share one walk of the module (see
+    // Module::RunInstrumentationPasses).
+    // Returns true if the instruction was instrumented, the block and instruction iterators then point at the targeted
+    // instruction again. If the pass wrapped it in a new block, the instructions that followed it were moved two blocks further.
+    virtual bool InstrumentInstruction(Function&, BasicBlockIt&, InstructionIt&) { return false; }
+    bool InstrumentationLimitReached() const { return instrumentation_limit_reached_; }
+
     virtual void PrintDebugInfo() {}
 
     // Finds (and creates if needed) decoration and returns the OpVariable it points to
@@ -69,6 +77,8 @@ class Pass {
     InstructionIt FindTargetInstruction(BasicBlock& block) const;
 
     uint32_t instrumented_count_ = 0;
+    // Set once Settings::max_instrumented_count stops the pass from instrumenting anything else
+    bool instrumentation_limit_reached_ = false;
 };
 
 }  // namespace spirv
@@ -43,7 +43,7 @@ const Type* Variable::PointerType(TypeManager& type_manager_) const {
     return type_manager_.FindTypeById(type_id);
 }
 
-const Type& TypeManager::AddType(std::unique_ptr<Instruction> new_inst, SpvType spv_type) {
+const Type& TypeManager::AddType(InstructionPtr new_inst, SpvType spv_type) {
     const auto& inst = module_.types_values_constants_.emplace_back(std::move(new_inst));
 
     id_to_type_[inst->ResultId()] = std::make_unique<Type>(spv_type, *inst);
@@ -140,7 +140,7 @@ const Type& TypeManager::GetTypeVoid() {
     };
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(2, spv::OpTypeVoid);
+    auto new_inst = module_.NewInstruction(2, spv::OpTypeVoid);
     new_inst->Fill({type_id});
     return AddType(std::move(new_inst), SpvType::kVoid);
 }
@@ -151,7 +151,7 @@ const Type& TypeManager::GetTypeBool() {
     };
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(2, spv::OpTypeBool);
+    auto new_inst = module_.NewInstruction(2, spv::OpTypeBool);
     new_inst->Fill({type_id});
     return AddType(std::move(new_inst), SpvType::kBool);
 }
@@ -162,7 +162,7 @@ const Type& TypeManager::GetTypeSampler() {
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(2, spv::OpTypeSampler);
+    auto new_inst = module_.NewInstruction(2, spv::OpTypeSampler);
     new_inst->Fill({type_id});
     return AddType(std::move(new_inst), SpvType::kSampler);
 }
@@ -173,7 +173,7 @@ const Type& TypeManager::GetTypeRayQuery() {
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(2, spv::OpTypeRayQueryKHR);
+    auto new_inst = module_.NewInstruction(2, spv::OpTypeRayQueryKHR);
     new_inst->Fill({type_id});
     return AddType(std::move(new_inst), SpvType::kRayQueryKHR);
 }
@@ -184,7 +184,7 @@ const Type& TypeManager::GetTypeAccelerationStructure() {
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(2, spv::OpTypeAccelerationStructureKHR);
+    auto new_inst = module_.NewInstruction(2, spv::OpTypeAccelerationStructureKHR);
     new_inst->Fill({type_id});
     return AddType(std::move(new_inst), SpvType::kAccelerationStructureKHR);
 }
@@ -200,7 +200,7 @@ const Type& TypeManager::GetTypeInt(uint32_t bit_width, bool is_signed) {
 
     const uint32_t type_id = module_.TakeNextId();
     const uint32_t signed_word = is_signed ? 1 : 0;
-    auto new_inst = std::make_unique<Instruction>(4, spv::OpTypeInt);
+    auto new_inst = module_.NewInstruction(4, spv::OpTypeInt);
     new_inst->Fill({type_id, bit_width, signed_word});
     return AddType(std::move(new_inst), SpvType::kInt);
 }
@@ -214,7 +214,7 @@ const Type& TypeManager::GetTypeFloat(uint32_t bit_width) {
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(3, spv::OpTypeFloat);
+    auto new_inst = module_.NewInstruction(3, spv::OpTypeFloat);
     new_inst->Fill({type_id, bit_width});
     return AddType(std::move(new_inst), SpvType::kFloat);
 }
@@ -230,7 +230,7 @@ const Type& TypeManager::GetTypeArray(const Type& element_type, const Constant&
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(4, spv::OpTypeArray);
+    auto new_inst = module_.NewInstruction(4, spv::OpTypeArray);
     new_inst->Fill({type_id, element_type.Id(), length.Id()});
     return AddType(std::move(new_inst), SpvType::kArray);
 }
@@ -244,7 +244,7 @@ const Type& TypeManager::GetTypeRuntimeArray(const Type& element_type) {
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(3, spv::OpTypeRuntimeArray);
+    auto new_inst = module_.NewInstruction(3, spv::OpTypeRuntimeArray);
     new_inst->Fill({type_id, element_type.Id()});
     return AddType(std::move(new_inst), SpvType::kRuntimeArray);
 }
@@ -263,7 +263,7 @@ const Type& TypeManager::GetTypeVector(const Type& component_type, uint32_t comp
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(4, spv::OpTypeVector);
+    auto new_inst = module_.NewInstruction(4, spv::OpTypeVector);
     new_inst->Fill({type_id, component_type.Id(), component_count});
     return AddType(std::move(new_inst), SpvType::kVector);
 }
@@ -282,7 +282,7 @@ const Type& TypeManager::GetTypeMatrix(const Type& column_type, uint32_t column_
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(4, spv::OpTypeMatrix);
+    auto new_inst = module_.NewInstruction(4, spv::OpTypeMatrix);
     new_inst->Fill({type_id, column_type.Id(), column_count});
     return AddType(std::move(new_inst), SpvType::kMatrix);
 }
@@ -297,7 +297,7 @@ const Type& TypeManager::GetTypeSampledImage(const Type& image_type) {
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(3, spv::OpTypeSampledImage);
+    auto new_inst = module_.NewInstruction(3, spv::OpTypeSampledImage);
     new_inst->Fill({type_id, image_type.Id()});
     return AddType(std::move(new_inst), SpvType::kSampledImage);
 }
@@ -316,7 +316,7 @@ const Type& TypeManager::GetTypePointer(spv::StorageClass storage_class, const T
     }
 
     const uint32_t type_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(4, spv::OpTypePointer);
+    auto new_inst = module_.NewInstruction(4, spv::OpTypePointer);
     new_inst->Fill({type_id, uint32_t(storage_class), pointer_type.Id()});
     return AddType(std::move(new_inst), SpvType::kPointer);
 }
@@ -413,7 +413,7 @@ uint32_t TypeManager::TypeLength(const Type& type) {
     return 0;
 }
 
-const Constant& TypeManager::AddConstant(std::unique_ptr<Instruction> new_inst, const Type& type) {
+const Constant& TypeManager::AddConstant(InstructionPtr new_inst, const Type& type) {
     const auto& inst = module_.types_values_constants_.emplace_back(std::move(new_inst));
 
     id_to_constant_[inst->ResultId()] = std::make_unique<Constant>(type, *inst);
@@ -458,7 +458,7 @@ const Constant* TypeManager::FindConstantById(uint32_t id) const {
 const Constant& TypeManager::CreateConstantUInt32(uint32_t value) {
     const Type& type = GetTypeInt(32, 0);
     const uint32_t constant_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(4, spv::OpConstant);
+    auto new_inst = module_.NewInstruction(4, spv::OpConstant);
     new_inst->Fill({type.Id(), constant_id, value});
     return AddConstant(std::move(new_inst), type);
 }
@@ -495,7 +495,7 @@ const Constant& TypeManager::GetConstantZeroFloat32() {
         float_32bit_zero_constants_ = FindConstantFloat32(float_32_type.Id(), 0);
         if (!float_32bit_zero_constants_) {
             const uint32_t constant_id = module_.TakeNextId();
-            auto new_inst = std::make_unique<Instruction>(4, spv::OpConstant);
+            auto new_inst = module_.NewInstruction(4, spv::OpConstant);
             new_inst->Fill({float_32_type.Id(), constant_id, 0});
             float_32bit_zero_constants_ = &AddConstant(std::move(new_inst), float_32_type);
         }
@@ -509,7 +509,7 @@ const Constant& TypeManager::GetConstantZeroVec3() {
     const uint32_t float32_0_id = module_.type_manager_.GetConstantZeroFloat32().Id();
 
     const uint32_t constant_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(6, spv::OpConstantComposite);
+    auto new_inst = module_.NewInstruction(6, spv::OpConstantComposite);
     new_inst->Fill({vec3_type.Id(), constant_id, float32_0_id, float32_0_id, float32_0_id});
     return AddConstant(std::move(new_inst), vec3_type);
 }
@@ -522,12 +522,12 @@ const Constant& TypeManager::GetConstantNull(const Type& type) {
     }
 
     const uint32_t constant_id = module_.TakeNextId();
-    auto new_inst = std::make_unique<Instruction>(3, spv::OpConstantNull);
+    auto new_inst = module_.NewInstruction(3, spv::OpConstantNull);
     new_inst->Fill({type.Id(), constant_id});
     return AddConstant(std::move(new_inst), type);
 }
 
-const Variable& TypeManager::AddVariable(std::unique_ptr<Instruction> new_inst, const Type& type) {
+const Variable& TypeManager::AddVariable(InstructionPtr new_inst, const Type& type) {
     const auto& inst = module_.types_values_constants_.emplace_back(std::move(new_inst));
 
     id_to_variable_[inst->ResultId()] = std::make_unique<Variable>(type, *inst);
@@ -589,5 +589,39 @@ uint32_t TypeManager::FindTypeByteSize(uint32_t type_id, uint32_t matrix_stride,
     return 1;
 }
 
+void TypeManager::RemoveIds(const vvl::unordered_set<uint32_t>& ids) {
+    auto is_removed = [&ids](const auto* object) { return ids.count(object->Id()) != 0; };
+    auto reset_if_removed = [&is_removed](auto*& object) {
+        if (object && is_removed(object)) {
+            object = nullptr;
+        }
+    };
+
+    reset_if_removed(void_type);
+    reset_if_removed(bool_type);
+    reset_if_removed(sampler_type);
+    reset_if_removed(ray_query_type);
+    reset_if_removed(acceleration_structure_type);
+    for (auto* types : {&int_types_, &float_types_, &vector_types_, &matrix_types_, &image_types_, &sampled_image_types_,
+                        &array_types_, &runtime_array_types_, &pointer_types_, &forward_pointer_types_, &function_types_}) {
+        vvl::erase_if(*types, is_removed);
+    }
+
+    reset_if_removed(uint_32bit_zero_constants_);
+    reset_if_removed(float_32bit_zero_constants_);
+    vvl::erase_if(int_32bit_constants_, is_removed);
+    vvl::erase_if(float_32bit_constants_, is_removed);
+    vvl::erase_if(null_constants_, is_removed);
+
+    vvl::erase_if(input_variables_, is_removed);
+    vvl::erase_if(output_variables_, is_removed);
+
+    for (const uint32_t id : ids) {
+        id_to_type_.erase(id);
+        id_to_constant_.erase(id);
+        id_to_variable_.erase(id);
+    }
+}
+
 }  // namespace spirv
-}  // namespace gpu
\ No newline at end of file
+}  // namespace gpu
@@ -92,7 +92,7 @@ class TypeManager {
   public:
     TypeManager(Module& module) : module_(module) {}
 
-    const Type& AddType(std::unique_ptr<Instruction> new_inst, SpvType spv_type);
+    const Type& AddType(InstructionPtr new_inst, SpvType spv_type);
     const Type* FindTypeById(uint32_t id) const;
     const Type* FindFunctionType(const Instruction& inst) const;
     // There shouldn't be a case where we need to query for a specific type, but then not add it if not found.
@@ -112,7 +112,7 @@ class TypeManager {
     const Type& GetTypePointerBuiltInInput(spv::BuiltIn built_in);
     uint32_t TypeLength(const Type& type);
 
-    const Constant& AddConstant(std::unique_ptr<Instruction> new_inst, const Type& type);
+    const Constant& AddConstant(InstructionPtr new_inst, const Type& type);
     const Constant* FindConstantById(uint32_t id) const;
     const Constant* FindConstantInt32(uint32_t type_id, uint32_t value) const;
     const Constant* FindConstantFloat32(uint32_t type_id, uint32_t value) const;
@@ -124,11 +124,14 @@ class TypeManager {
     const Constant& GetConstantZeroVec3();
     const Constant& GetConstantNull(const Type& type);
 
-    const Variable& AddVariable(std::unique_ptr<Instruction> new_inst, const Type& type);
+    const Variable& AddVariable(InstructionPtr new_inst, const Type& type);
     const Variable* FindVariableById(uint32_t id) const;
 
     uint32_t FindTypeByteSize(uint32_t type_id, uint32_t matrix_stride = 0, bool col_major = false, bool in_matrix = false);
 
+    // Stops tracking the types/constants/variables with these IDs, needs to be called before their instructions are removed
+    void RemoveIds(const vvl::unordered_set<uint32_t>& ids);
+
   private:
     Module& module_;
 
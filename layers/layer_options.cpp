@@ -164,6 +164,8 @@ const char *VK_LAYER_DUPLICATE_MESSAGE_LIMIT = "duplicate_message_limit";
 // GloablSettings
 // ---
 const char *VK_LAYER_FINE_GRAINED_LOCKING = "fine_grained_locking";
+const char *VK_LAYER_PARALLEL_PIPELINE_VALIDATION = "parallel_pipeline_validation";
+const char *VK_LAYER_ASYNC_SPIRV_VALIDATION = "async_spirv_validation";
 // Debug settings used for internal development
 const char *VK_LAYER_DEBUG_DISABLE_SPIRV_VAL = "debug_disable_spirv_val";
 
@@ -797,6 +799,15 @@ void ProcessConfigAndEnvSettings(ConfigAndEnvSettings *settings_data) {
         vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_FINE_GRAINED_LOCKING, global_settings.fine_grained_locking);
     }
 
+    if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_PARALLEL_PIPELINE_VALIDATION)) {
+        vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_PARALLEL_PIPELINE_VALIDATION,
+                                global_settings.parallel_pipeline_validation);
+    }
+
+    if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_ASYNC_SPIRV_VALIDATION)) {
+        vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_ASYNC_SPIRV_VALIDATION, global_settings.async_spirv_validation);
+    }
+
     if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_DEBUG_DISABLE_SPIRV_VAL)) {
         vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_DEBUG_DISABLE_SPIRV_VAL, global_settings.debug_disable_spirv_val);
     }
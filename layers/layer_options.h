@@ -81,6 +81,8 @@ using CHECK_ENABLED = std::array<bool, kMaxEnableFlags>;
 // General settings to be used by all parts of the Validation Layers
 struct GlobalSettings {
     bool fine_grained_locking = true;
+    bool parallel_pipeline_validation = false;
+    bool async_spirv_validation = false;
 
     bool debug_disable_spirv_val = false;
 };
@@ -269,9 +269,14 @@ void CommandBuffer::ResetCBState() {
     activeQueries.clear();
     startedQueries.clear();
     renderPassQueries.clear();
+    // The layout maps of the recording that just ended are kept for the next one to reuse for the same images, the ones the
+    // recording didn't take back from the recording before are freed
+    std::swap(image_layout_map, retained_image_layout_map_);
     image_layout_map.clear();
     aliased_image_layout_map.clear();
     current_vertex_buffer_binding_info.clear();
+    ClearPushConstantData();
+    push_constant_ranges_layout.reset();
     primaryCommandBuffer = VK_NULL_HANDLE;
     linkedCommandBuffers.clear();
     queue_submit_functions.clear();
@@ -279,6 +284,9 @@ void CommandBuffer::ResetCBState() {
     cmd_execute_commands_functions.clear();
     eventUpdates.clear();
     queryUpdates.clear();
+    // Every callback stream is empty now, so nothing is left pointing into the arena. The blocks recent recordings needed
+    // are kept for the next one.
+    command_arena.Reset();
 
     for (auto &item : lastBound) {
         item.Reset();
@@ -342,6 +350,23 @@ void CommandBuffer::ResetPushConstantRangesLayoutIfIncompatible(const vvl::Pipel
     }
 
     push_constant_ranges_layout = pipeline_layout_state.push_constant_ranges_layout;
+    ClearPushConstantData();
+}
+
+CommandBuffer::PushConstantData &CommandBuffer::AddPushConstantData() {
+    auto &push_constant_data = push_constant_data_chunks.emplace_back();
+    if (!spare_push_constant_values_.empty()) {
+        push_constant_data.values = std::move(spare_push_constant_values_.back());
+        spare_push_constant_values_.pop_back();
+    }
+    return push_constant_data;
+}
+
+void CommandBuffer::ClearPushConstantData() {
+    for (auto &push_constant_data : push_constant_data_chunks) {
+        push_constant_data.values.clear();
+        spare_push_constant_values_.emplace_back(std::move(push_constant_data.values));
+    }
     push_constant_data_chunks.clear();
 }
 
@@ -351,6 +376,7 @@ void CommandBuffer::Destroy() {
     {
         auto guard = WriteLock();
         ResetCBState();
+        command_arena.Release();
     }
     StateObject::Destroy();
 }
@@ -383,6 +409,7 @@ void CommandBuffer::NotifyInvalidate(const StateObject::NodeList &invalid_nodes,
                 case kVulkanObjectTypeImage:
                     if (unlink) {
                         image_layout_map.erase(obj->Handle().Cast<VkImage>());
+                        retained_image_layout_map_.erase(obj->Handle().Cast<VkImage>());
                     }
                     break;
                 default:
@@ -433,7 +460,7 @@ std::shared_ptr<ImageSubresourceLayoutMap> CommandBuffer::GetImageSubresourceLay
         if (alias_iter != aliased_image_layout_map.end()) {
             layout_map = alias_iter->second;
         } else {
-            layout_map = std::make_shared<ImageSubresourceLayoutMap>(image_state);
+            layout_map = MakeImageSubresourceLayoutMap(image_state);
             // Save the local layout map for the next aliased image.
             // The global layout map pointer is only used as a key into the local lookup
             // table so it doesn't need to be locked.
@@ -441,7 +468,7 @@ std::shared_ptr<ImageSubresourceLayoutMap> CommandBuffer::GetImageSubresourceLay
         }
 
     } else {
-        layout_map = std::make_shared<ImageSubresourceLayoutMap>(image_state);
+        layout_map = MakeImageSubresourceLayoutMap(image_state);
     }
     if (iter != image_layout_map.end()) {
         // overwrite the stale entry
@@ -454,6 +481,22 @@ std::shared_ptr<ImageSubresourceLayoutMap> CommandBuffer::GetImageSubresourceLay
     return layout_map;
 }
 
+// Hands back the map the previous recording used for this image when nothing else holds on to it anymore. Nothing can take a
+// new reference to a retained map, as it is only reachable from retained_image_layout_map_.
+std::shared_ptr<ImageSubresourceLayoutMap> CommandBuffer::MakeImageSubresourceLayoutMap(const vvl::Image &image_state) {
+    auto retained = retained_image_layout_map_.find(image_state.VkHandle());
+    if (retained != retained_image_layout_map_.end()) {
+        std::shared_ptr<ImageSubresourceLayoutMap> layout_map = std::move(retained->second.map);
+        const bool reusable = retained->second.id == image_state.GetId() && layout_map.use_count() == 1;
+        retained_image_layout_map_.erase(retained);
+        if (reusable) {
+            layout_map->Reset();
+            return layout_map;
+        }
+    }
+    return std::make_shared<ImageSubresourceLayoutMap>(image_state);
+}
+
 static bool SetQueryState(const QueryObject &object, QueryState value, QueryMap *localQueryToStateMap) {
     (*localQueryToStateMap)[object] = value;
     return false;
@@ -1101,15 +1144,11 @@ void CommandBuffer::ExecuteCommands(vvl::span<const VkCommandBuffer> secondary_c
             }
             return skip;
         });
-        for (auto &function : sub_cb_state->eventUpdates) {
-            eventUpdates.push_back(function);
-        }
+        eventUpdates.Append(sub_cb_state->eventUpdates);
         for (auto &event : sub_cb_state->events) {
             events.push_back(event);
         }
-        for (auto &function : sub_cb_state->queue_submit_functions) {
-            queue_submit_functions.push_back(function);
-        }
+        queue_submit_functions.Append(sub_cb_state->queue_submit_functions);
 
         // State is trashed after executing secondary command buffers.
         // Importantly, this function runs after CoreChecks::PreCallValidateCmdExecuteCommands.
@@ -1211,8 +1250,8 @@ void CommandBuffer::UpdatePipelineState(Func command, const VkPipelineBindPoint
     }
 
     if (last_bound.desc_set_pipeline_layout != VK_NULL_HANDLE) {
-        for (const auto &set_binding_pair : pipe->active_slots) {
-            uint32_t set_index = set_binding_pair.first;
+        for (const auto &set_requirements : pipe->descriptor_requirements.sets) {
+            uint32_t set_index = set_requirements.set;
             if (set_index >= last_bound.per_set.size()) {
                 continue;
             }
@@ -1227,22 +1266,26 @@ void CommandBuffer::UpdatePipelineState(Func command, const VkPipelineBindPoint
 
             // We can skip updating the state if "nothing" has changed since the last validation.
             // See CoreChecks::ValidateActionState for more details.
-            const bool need_update =  // Update if descriptor set (or contents) has changed
-                set_info.validated_set != descriptor_set.get() ||
-                set_info.validated_set_change_count != descriptor_set->GetChangeCount() ||
+            const bool need_full_update =  // Update everything if descriptor set or pipeline has changed
+                set_info.validated_set != descriptor_set.get() || set_info.validated_requirements_id != pipe->GetId() ||
                 (!dev_data.disabled[image_layout_validation] &&
                  set_info.validated_set_image_layout_change_count != image_layout_change_count);
+            // Otherwise only the descriptors written since the last update need to be visited
+            const bool need_update = need_full_update || set_info.validated_set_change_count != descriptor_set->GetChangeCount();
             if (need_update) {
                 if (!dev_data.disabled[command_buffer_state] && !descriptor_set->IsPushDescriptor()) {
                     AddChild(descriptor_set);
                 }
 
                 // Bind this set and its active descriptor resources to the command buffer
-                descriptor_set->UpdateDrawState(&dev_data, this, command, pipe, set_binding_pair.second);
+                descriptor_set->UpdateDrawState(
+                    &dev_data, this, command, pipe, pipe->descriptor_requirements.SetBindings(set_requirements),
+                    need_full_update ? std::nullopt : std::optional<uint64_t>(set_info.validated_set_change_count));
 
                 set_info.validated_set = descriptor_set.get();
                 set_info.validated_set_change_count = descriptor_set->GetChangeCount();
                 set_info.validated_set_image_layout_change_count = image_layout_change_count;
+                set_info.validated_requirements_id = pipe->GetId();
             }
         }
     }
@@ -1724,7 +1767,7 @@ void CommandBuffer::UnbindResources() {
     current_vertex_buffer_binding_info.clear();
 
     // Push constants
-    push_constant_data_chunks.clear();
+    ClearPushConstantData();
     push_constant_ranges_layout.reset();
 
     // Reset status of cb to force rebinding of all resources
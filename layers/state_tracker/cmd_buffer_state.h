@@ -25,6 +25,7 @@
 #include "state_tracker/vertex_index_buffer_state.h"
 #include "containers/qfo_transfer.h"
 #include "containers/custom_containers.h"
+#include "containers/callback_stream.h"
 #include "generated/dynamic_state_helper.h"
 
 class CoreChecks;
@@ -478,30 +479,35 @@ class CommandBuffer : public RefcountedStateObject {
     ImageLayoutMap image_layout_map;
     AliasedLayoutMap aliased_image_layout_map;  // storage for potentially aliased images
 
-    vvl::unordered_map<uint32_t, vvl::VertexBufferBinding> current_vertex_buffer_binding_info;
+    // Bindings up to the inline count are stored in the command buffer itself, clearing them frees nothing
+    small_unordered_map<uint32_t, vvl::VertexBufferBinding, 8> current_vertex_buffer_binding_info;
     vvl::IndexBufferBinding index_buffer_binding;
 
     VkCommandBuffer primaryCommandBuffer;
     // If primary, the secondary command buffers we will call.
     vvl::unordered_set<CommandBuffer *> linkedCommandBuffers;
+    // Backing storage for the deferred callback streams below. Recording a callback only bumps a pointer into this arena,
+    // everything is released at once when the command buffer is reset.
+    BumpArena command_arena;
     // Validation functions run at primary CB queue submit time
-    using QueueCallback = std::function<bool(const ValidationStateTracker &device_data, const class vvl::Queue &queue_state,
-                                             const CommandBuffer &cb_state)>;
-    std::vector<QueueCallback> queue_submit_functions;
+    using QueueCallback = bool(const ValidationStateTracker &device_data, const class vvl::Queue &queue_state,
+                               const CommandBuffer &cb_state);
+    using QueueCallbacks = CallbackStream<QueueCallback>;
+    QueueCallbacks queue_submit_functions{command_arena};
     // Used by some layers to defer actions until vkCmdEndRenderPass time.
     // Layers using this are responsible for inserting the callbacks into queue_submit_functions.
-    std::vector<QueueCallback> queue_submit_functions_after_render_pass;
+    QueueCallbacks queue_submit_functions_after_render_pass{command_arena};
     // Validation functions run when secondary CB is executed in primary
-    std::vector<std::function<bool(const CommandBuffer &secondary, const CommandBuffer *primary, const vvl::Framebuffer *)>>
-        cmd_execute_commands_functions;
+    CallbackStream<bool(const CommandBuffer &secondary, const CommandBuffer *primary, const vvl::Framebuffer *)>
+        cmd_execute_commands_functions{command_arena};
 
-    using EventCallback = std::function<bool(CommandBuffer &cb_state, bool do_validate, EventMap &local_event_signal_info,
-                                             VkQueue waiting_queue, const Location &loc)>;
-    std::vector<EventCallback> eventUpdates;
+    using EventCallback = bool(CommandBuffer &cb_state, bool do_validate, EventMap &local_event_signal_info, VkQueue waiting_queue,
+                               const Location &loc);
+    CallbackStream<EventCallback> eventUpdates{command_arena};
 
-    std::vector<std::function<bool(CommandBuffer &cb_state, bool do_validate, VkQueryPool &firstPerfQueryPool,
-                                   uint32_t perfQueryPass, QueryMap *localQueryToStateMap)>>
-        queryUpdates;
+    using QueryCallback = bool(CommandBuffer &cb_state, bool do_validate, VkQueryPool &firstPerfQueryPool, uint32_t perfQueryPass,
+                               QueryMap *localQueryToStateMap);
+    CallbackStream<QueryCallback> queryUpdates{command_arena};
     bool performance_lock_acquired = false;
     bool performance_lock_released = false;
 
@@ -515,6 +521,8 @@ class CommandBuffer : public RefcountedStateObject {
         std::vector<std::byte> values{};
     };
     std::vector<PushConstantData> push_constant_data_chunks;
+    // Appends to push_constant_data_chunks, reusing the values storage of chunks that were cleared
+    PushConstantData &AddPushConstantData();
     std::array<VkPipelineLayout, BindPoint_Count> push_constant_latest_used_layout{};
     PushConstantRangesId push_constant_ranges_layout;
 
@@ -714,6 +722,14 @@ class CommandBuffer : public RefcountedStateObject {
 
   private:
     void ResetCBState();
+    void ClearPushConstantData();
+
+    // Values storage of cleared push_constant_data_chunks, handed back out by AddPushConstantData()
+    std::vector<std::vector<std::byte>> spare_push_constant_values_;
+
+    std::shared_ptr<ImageSubresourceLayoutMap> MakeImageSubresourceLayoutMap(const vvl::Image &image_state);
+    // image_layout_map of the previous recording, MakeImageSubresourceLayoutMap() takes the maps back out of it
+    ImageLayoutMap retained_image_layout_map_;
 
     // Keep track of how many CmdBeginDebugUtilsLabelEXT calls have been made without a matching CmdEndDebugUtilsLabelEXT.
     // Negative value for a secondary command buffer indicates invalid state.
@@ -470,6 +470,89 @@ vvl::DescriptorSetLayout::DescriptorSetLayout(const VkDescriptorSetLayoutCreateI
 
 void vvl::AllocateDescriptorSetsData::Init(uint32_t count) { layout_nodes.resize(count); }
 
+// Size of one descriptor's worth of data in pData, used to tell if an entry's descriptors can be written as one array
+static size_t GetTemplateDescriptorDataSize(VkDescriptorType type) {
+    switch (type) {
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+            return sizeof(VkDescriptorImageInfo);
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+            return sizeof(VkDescriptorBufferInfo);
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            return sizeof(VkBufferView);
+        case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+            return sizeof(VkAccelerationStructureKHR);
+        case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV:
+            return sizeof(VkAccelerationStructureNV);
+        default:
+            return 0;
+    }
+}
+
+void vvl::DecodeTemplateWriteEntries(const VkDescriptorUpdateTemplateCreateInfo &create_info,
+                                     const DescriptorSetLayout &layout_state, TemplateWriteEntries &write_entries) {
+    write_entries.clear();
+    for (uint32_t i = 0; i < create_info.descriptorUpdateEntryCount; i++) {
+        const VkDescriptorUpdateTemplateEntry &entry = create_info.pDescriptorUpdateEntries[i];
+        if (entry.descriptorCount == 0) {
+            continue;
+        }
+        uint32_t binding_being_updated = entry.dstBinding;
+        uint32_t dst_array_element = entry.dstArrayElement;
+
+        // descriptorCount is the number of bytes of the block, which is always written by a single update
+        if (entry.descriptorType == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK) {
+            write_entries.emplace_back(TemplateWriteEntry{binding_being_updated, dst_array_element, entry.descriptorCount,
+                                                          entry.descriptorType, entry.offset});
+            continue;
+        }
+
+        // Only descriptors laid out as a plain array in pData can share a write
+        const bool packed = entry.stride == GetTemplateDescriptorDataSize(entry.descriptorType);
+        const size_t first_write = write_entries.size();
+        uint32_t binding_count = layout_state.GetDescriptorCountFromBinding(binding_being_updated);
+        for (uint32_t j = 0; j < entry.descriptorCount; j++) {
+            if (dst_array_element >= binding_count) {
+                dst_array_element = 0;
+                binding_being_updated = layout_state.GetNextValidBinding(binding_being_updated);
+                binding_count = layout_state.GetDescriptorCountFromBinding(binding_being_updated);
+            }
+
+            // Writes never cross a binding, so errors are still reported against the binding they belong to
+            if (packed && write_entries.size() > first_write) {
+                auto &last = write_entries.back();
+                if (last.dst_binding == binding_being_updated &&
+                    last.dst_array_element + last.descriptor_count == dst_array_element) {
+                    last.descriptor_count++;
+                    dst_array_element++;
+                    continue;
+                }
+            }
+            write_entries.emplace_back(TemplateWriteEntry{binding_being_updated, dst_array_element, 1, entry.descriptorType,
+                                                          entry.offset + j * entry.stride});
+            dst_array_element++;
+        }
+    }
+}
+
+vvl::DescriptorUpdateTemplate::DescriptorUpdateTemplate(VkDescriptorUpdateTemplate handle,
+                                                        const VkDescriptorUpdateTemplateCreateInfo *pCreateInfo,
+                                                        const DescriptorSetLayout *layout_state)
+    : StateObject(handle, kVulkanObjectTypeDescriptorUpdateTemplate),
+      safe_create_info(pCreateInfo),
+      create_info(*safe_create_info.ptr()) {
+    if (create_info.templateType == VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET && layout_state) {
+        DecodeTemplateWriteEntries(create_info, *layout_state, write_entries);
+    }
+}
+
 vvl::DescriptorSet::DescriptorSet(const VkDescriptorSet handle, vvl::DescriptorPool *pool_state,
                                   const std::shared_ptr<DescriptorSetLayout const> &layout, uint32_t variable_count,
                                   vvl::DescriptorSet::StateTracker *state_data)
@@ -580,6 +663,38 @@ void vvl::DescriptorSet::NotifyInvalidate(const NodeList &invalid_nodes, bool un
     for (auto &binding : bindings_) {
         binding->NotifyInvalidate(invalid_nodes, unlink);
     }
+    // A referenced resource went away without the change count moving, anything validated before is stale
+    std::lock_guard<std::mutex> guard(draw_validation_lock_);
+    draw_validation_key_count_ = 0;
+    draw_validation_next_key_ = 0;
+}
+
+bool vvl::DescriptorSet::HasValidatedDrawState(const DrawValidationKey &key) const {
+    std::lock_guard<std::mutex> guard(draw_validation_lock_);
+    for (uint32_t i = 0; i < draw_validation_key_count_; ++i) {
+        if (draw_validation_keys_[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void vvl::DescriptorSet::SetValidatedDrawState(const DrawValidationKey &key) const {
+    std::lock_guard<std::mutex> guard(draw_validation_lock_);
+    // Results for older contents can never match again
+    if (draw_validation_key_count_ > 0 && draw_validation_keys_[0].change_count != key.change_count) {
+        draw_validation_key_count_ = 0;
+        draw_validation_next_key_ = 0;
+    }
+    for (uint32_t i = 0; i < draw_validation_key_count_; ++i) {
+        if (draw_validation_keys_[i] == key) {
+            return;
+        }
+    }
+    // Replace round robin once full, a set is rarely used by more than a few pipelines at the same time
+    draw_validation_keys_[draw_validation_next_key_] = key;
+    draw_validation_next_key_ = (draw_validation_next_key_ + 1) % kMaxDrawValidationKeys;
+    draw_validation_key_count_ = std::min(draw_validation_key_count_ + 1, kMaxDrawValidationKeys);
 }
 
 uint32_t vvl::DescriptorSet::GetDynamicOffsetIndexFromBinding(uint32_t dynamic_binding) const {
@@ -625,6 +740,11 @@ void vvl::DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorSet &update)
     ASSERT_AND_RETURN(!iter.AtEnd());
     auto &orig_binding = iter.CurrentBinding();
 
+    if (update.descriptorCount) {
+        some_update_ = true;
+    }
+    const uint64_t change_count = update.descriptorCount ? ++change_count_ : change_count_.load();
+
     // Verify next consecutive binding matches type, stage flags & immutable sampler use and if AtEnd
     for (uint32_t i = 0; i < descriptors_remaining; ++i, ++iter) {
         if (iter.AtEnd() || !orig_binding.IsConsistent(iter.CurrentBinding())) {
@@ -632,10 +752,7 @@ void vvl::DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorSet &update)
         }
         iter->WriteUpdate(*this, *state_data_, update, i, IsBindless(iter.CurrentBinding().binding_flags));
         iter.updated(true);
-    }
-    if (update.descriptorCount) {
-        some_update_ = true;
-        ++change_count_;
+        iter.CurrentBinding().MarkDirty(change_count, iter.CurrentIndex());
     }
 
     if (!IsPushDescriptor() && !(orig_binding.binding_flags & (VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
@@ -647,6 +764,7 @@ void vvl::DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorSet &update)
 void vvl::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet &update, const DescriptorSet &src_set) {
     auto src_iter = src_set.FindDescriptor(update.srcBinding, update.srcArrayElement);
     auto dst_iter = FindDescriptor(update.dstBinding, update.dstArrayElement);
+    const uint64_t change_count = update.descriptorCount ? ++change_count_ : change_count_.load();
     // Update parameters all look good so perform update
     for (uint32_t i = 0; i < update.descriptorCount; ++i, ++src_iter, ++dst_iter) {
         auto &src = *src_iter;
@@ -659,11 +777,12 @@ void vvl::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet &update, co
             }
             dst.CopyUpdate(*this, *state_data_, src, IsBindless(src_iter.CurrentBinding().binding_flags), type);
             some_update_ = true;
-            ++change_count_;
             dst_iter.updated(true);
         } else {
             dst_iter.updated(false);
         }
+        // Copying a never updated descriptor also changes what draw time validation sees
+        dst_iter.CurrentBinding().MarkDirty(change_count, dst_iter.CurrentIndex());
     }
 
     if (!(layout_->GetDescriptorBindingFlagsFromBinding(update.dstBinding) &
@@ -672,6 +791,49 @@ void vvl::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet &update, co
     }
 }
 
+void vvl::DescriptorBinding::MarkDirty(uint64_t change_count, uint32_t index) {
+    last_change_count_ = change_count;
+    if (!dirty_ranges_.empty()) {
+        auto &last = dirty_ranges_.back();
+        // Consecutive elements of the same update extend the previous range
+        if (last.change_count == change_count && last.range.end == index) {
+            last.range.end = index + 1;
+            return;
+        }
+    }
+    if (dirty_ranges_.size() == kMaxDirtyRanges) {
+        // Fold the two oldest entries together, tagged with the newer of the two change counts, so only the oldest history
+        // loses precision and recent writes keep their exact ranges.
+        auto &oldest = dirty_ranges_[0];
+        const auto &next = dirty_ranges_[1];
+        oldest.range.start = std::min(oldest.range.start, next.range.start);
+        oldest.range.end = std::max(oldest.range.end, next.range.end);
+        oldest.change_count = next.change_count;
+        for (uint32_t i = 2; i < dirty_ranges_.size(); ++i) {
+            dirty_ranges_[i - 1] = dirty_ranges_[i];
+        }
+        dirty_ranges_.resize(kMaxDirtyRanges - 1);
+    }
+    dirty_ranges_.emplace_back(DirtyRange{change_count, IndexRange(index, index + 1)});
+}
+
+void vvl::DescriptorBinding::GetDirtyRanges(std::optional<uint64_t> since_change_count, std::vector<IndexRange> &ranges) const {
+    if (!since_change_count) {
+        if (count) {
+            ranges.emplace_back(0, count);
+        }
+        return;
+    }
+    if (last_change_count_ <= *since_change_count) {
+        return;
+    }
+    for (const auto &dirty : dirty_ranges_) {
+        if (dirty.change_count > *since_change_count) {
+            ranges.emplace_back(dirty.range.start, std::min(dirty.range.end, count));
+        }
+    }
+}
+
 // Update the drawing state for the affected descriptors.
 // Set cb_state to this set and this set to cb_state.
 // Add the bindings of the descriptor
@@ -680,46 +842,53 @@ void vvl::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet &update, co
 // Prereq: This should be called for a set that has been confirmed to be active for the given cb_state, meaning it's going
 //   to be used in a draw by the given cb_state
 void vvl::DescriptorSet::UpdateDrawState(ValidationStateTracker *device_data, vvl::CommandBuffer *cb_state, vvl::Func command,
-                                         const vvl::Pipeline *pipe, const BindingVariableMap &binding_req_map) {
+                                         const vvl::Pipeline *pipe,
+                                         vvl::span<const DescriptorRequirementTable::Binding> binding_requirements,
+                                         std::optional<uint64_t> validated_change_count) {
     // Descriptor UpdateDrawState only call image layout validation callbacks. If it is disabled, skip the entire loop.
     if (device_data->disabled[image_layout_validation]) {
         return;
     }
 
+    std::vector<IndexRange> ranges;
     // For the active slots, use set# to look up descriptorSet from boundDescriptorSets, and bind all of that descriptor set's
     // resources
-    for (const auto &binding_req_pair : binding_req_map) {
-        auto *binding = GetBinding(binding_req_pair.first);
+    for (const auto &binding_requirement : binding_requirements) {
+        auto *binding = GetBinding(binding_requirement.info.first);
         ASSERT_AND_CONTINUE(binding);
 
         // core validation doesn't handle descriptor indexing, that is only done by GPU-AV
-        if (SkipBinding(*binding, binding_req_pair.second.variable->is_dynamic_accessed)) {
+        if (SkipBinding(*binding, binding_requirement.is_dynamic_accessed)) {
             continue;
         }
-        switch (binding->descriptor_class) {
-            case DescriptorClass::Image: {
-                auto *image_binding = static_cast<ImageBinding *>(binding);
-                for (uint32_t i = 0; i < image_binding->count; ++i) {
-                    image_binding->descriptors[i].UpdateDrawState(device_data, cb_state);
+        ranges.clear();
+        binding->GetDirtyRanges(validated_change_count, ranges);
+        for (const auto &range : ranges) {
+            switch (binding->descriptor_class) {
+                case DescriptorClass::Image: {
+                    auto *image_binding = static_cast<ImageBinding *>(binding);
+                    for (uint32_t i = range.start; i < range.end; ++i) {
+                        image_binding->descriptors[i].UpdateDrawState(device_data, cb_state);
+                    }
+                    break;
                 }
-                break;
-            }
-            case DescriptorClass::ImageSampler: {
-                auto *image_binding = static_cast<ImageSamplerBinding *>(binding);
-                for (uint32_t i = 0; i < image_binding->count; ++i) {
-                    image_binding->descriptors[i].UpdateDrawState(device_data, cb_state);
+                case DescriptorClass::ImageSampler: {
+                    auto *image_binding = static_cast<ImageSamplerBinding *>(binding);
+                    for (uint32_t i = range.start; i < range.end; ++i) {
+                        image_binding->descriptors[i].UpdateDrawState(device_data, cb_state);
+                    }
+                    break;
                 }
-                break;
-            }
-            case DescriptorClass::Mutable: {
-                auto *mutable_binding = static_cast<MutableBinding *>(binding);
-                for (uint32_t i = 0; i < mutable_binding->count; ++i) {
-                    mutable_binding->descriptors[i].UpdateDrawState(device_data, cb_state);
+                case DescriptorClass::Mutable: {
+                    auto *mutable_binding = static_cast<MutableBinding *>(binding);
+                    for (uint32_t i = range.start; i < range.end; ++i) {
+                        mutable_binding->descriptors[i].UpdateDrawState(device_data, cb_state);
+                    }
+                    break;
                 }
-                break;
+                default:
+                    break;
             }
-            default:
-                break;
         }
     }
 }
@@ -24,7 +24,10 @@
 #include "state_tracker/shader_stage_state.h"
 #include "generated/vk_object_types.h"
 #include <vulkan/utility/vk_safe_struct.hpp>
+#include <array>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -36,6 +39,7 @@ struct DeviceExtensions;
 namespace vvl {
 class Sampler;
 class DescriptorSet;
+class DescriptorSetLayout;
 class CommandBuffer;
 class ImageView;
 class Buffer;
@@ -101,15 +105,30 @@ class DescriptorPool : public StateObject {
     mutable std::shared_mutex lock_;
 };
 
+// A VkWriteDescriptorSet that a template update decodes to, with the offset into pData in place of the info pointers.
+// Descriptors of a template entry that are tightly packed in pData are coalesced into a single write.
+struct TemplateWriteEntry {
+    uint32_t dst_binding;
+    uint32_t dst_array_element;
+    uint32_t descriptor_count;
+    VkDescriptorType descriptor_type;
+    size_t offset;
+};
+using TemplateWriteEntries = std::vector<TemplateWriteEntry>;
+
+// Resolve the template entries against the set layout they will update, following the consecutive binding update rules
+void DecodeTemplateWriteEntries(const VkDescriptorUpdateTemplateCreateInfo &create_info, const DescriptorSetLayout &layout_state,
+                                TemplateWriteEntries &write_entries);
+
 class DescriptorUpdateTemplate : public StateObject {
   public:
     const vku::safe_VkDescriptorUpdateTemplateCreateInfo safe_create_info;
     const VkDescriptorUpdateTemplateCreateInfo &create_info;
+    // For VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET the layout is known up front, so the entries are only decoded once
+    TemplateWriteEntries write_entries;
 
-    DescriptorUpdateTemplate(VkDescriptorUpdateTemplate handle, const VkDescriptorUpdateTemplateCreateInfo *pCreateInfo)
-        : StateObject(handle, kVulkanObjectTypeDescriptorUpdateTemplate),
-          safe_create_info(pCreateInfo),
-          create_info(*safe_create_info.ptr()) {}
+    DescriptorUpdateTemplate(VkDescriptorUpdateTemplate handle, const VkDescriptorUpdateTemplateCreateInfo *pCreateInfo,
+                             const DescriptorSetLayout *layout_state);
 
     VkDescriptorUpdateTemplate VkHandle() const { return handle_.Cast<VkDescriptorUpdateTemplate>(); };
 };
@@ -694,6 +713,15 @@ class DescriptorBinding {
                has_immutable_samplers == other.has_immutable_samplers;
     }
 
+    // Record that array element |index| was written by the update that moved the parent set to |change_count|
+    void MarkDirty(uint64_t change_count, uint32_t index);
+    // Append to |ranges| the array elements written after the parent set was at |since_change_count|, or the whole binding
+    // when there is no change count to compare against. Ranges may overlap or contain elements that did not change, but
+    // never miss one that did.
+    void GetDirtyRanges(std::optional<uint64_t> since_change_count, std::vector<IndexRange> &ranges) const;
+    // Change count of the parent set when any element of this binding was last written
+    uint64_t GetLastChangeCount() const { return last_change_count_; }
+
     const uint32_t binding;
     const VkDescriptorType type;
     const DescriptorClass descriptor_class;
@@ -702,6 +730,17 @@ class DescriptorBinding {
     const uint32_t count;
     const bool has_immutable_samplers;
     small_vector<bool, 1, uint32_t> updated;
+
+  private:
+    // Bounded history of written element ranges, tagged with the set change count of the write, oldest first. When the
+    // history is full the two oldest entries are merged so lookups stay conservative.
+    struct DirtyRange {
+        uint64_t change_count;
+        IndexRange range;
+    };
+    static constexpr uint32_t kMaxDirtyRanges = 8;
+    small_vector<DirtyRange, kMaxDirtyRanges, uint32_t> dirty_ranges_;
+    uint64_t last_change_count_ = 0;
 };
 
 template <typename T>
@@ -758,11 +797,12 @@ using AccelerationStructureBinding = DescriptorBindingImpl<AccelerationStructure
 using MutableBinding = DescriptorBindingImpl<MutableDescriptor>;
 
 // Helper class to encapsulate the descriptor update template decoding logic
+// The storage is inline for typical templates, so decoding a template update does not touch the heap
 struct DecodedTemplateUpdate {
-    std::vector<VkWriteDescriptorSet> desc_writes;
-    std::vector<VkWriteDescriptorSetInlineUniformBlockEXT> inline_infos;
-    std::vector<VkWriteDescriptorSetAccelerationStructureKHR> inline_infos_khr;
-    std::vector<VkWriteDescriptorSetAccelerationStructureNV> inline_infos_nv;
+    small_vector<VkWriteDescriptorSet, 32> desc_writes;
+    small_vector<VkWriteDescriptorSetInlineUniformBlockEXT, 4> inline_infos;
+    small_vector<VkWriteDescriptorSetAccelerationStructureKHR, 4> inline_infos_khr;
+    small_vector<VkWriteDescriptorSetAccelerationStructureNV, 4> inline_infos_nv;
     DecodedTemplateUpdate(const ValidationStateTracker &device_data, VkDescriptorSet descriptorSet,
                           const DescriptorUpdateTemplate *template_state, const void *pData,
                           VkDescriptorSetLayout push_layout = VK_NULL_HANDLE);
@@ -829,8 +869,9 @@ class DescriptorSet : public StateObject {
     VkDescriptorSet VkHandle() const { return handle_.Cast<VkDescriptorSet>(); };
     // Bind given cmd_buffer to this descriptor set and
     // update CB image layout map with image/imagesampler descriptor image layouts
+    // If |validated_change_count| is set, only descriptors written since the set was at that change count are visited
     void UpdateDrawState(ValidationStateTracker *, vvl::CommandBuffer *cb_state, vvl::Func command, const vvl::Pipeline *,
-                         const BindingVariableMap &);
+                         vvl::span<const DescriptorRequirementTable::Binding>, std::optional<uint64_t> validated_change_count);
 
     // For a particular binding, get the global index
     const IndexRange GetGlobalIndexRangeFromBinding(const uint32_t binding, bool actual_length = false) const {
@@ -896,6 +937,27 @@ class DescriptorSet : public StateObject {
 
     uint64_t GetChangeCount() const { return change_count_; }
 
+    // Draw time validation of buffer, texel buffer, sampler and acceleration structure descriptors does not depend on the
+    // command buffer (other than whether it is protected), so a clean result is remembered on the set and shared by every
+    // command buffer that binds it. Image descriptors depend on per command buffer layouts and attachments, and are not covered.
+    struct DrawValidationKey {
+        StateObject::IdType requirements_id;  // Pipeline or shader object the binding requirements come from
+        uint32_t set_index;
+        uint64_t change_count;
+        bool unprotected;
+
+        bool operator==(const DrawValidationKey &rhs) const {
+            return requirements_id == rhs.requirements_id && set_index == rhs.set_index && change_count == rhs.change_count &&
+                   unprotected == rhs.unprotected;
+        }
+    };
+    static bool IsCommandBufferIndependent(DescriptorClass descriptor_class) {
+        return descriptor_class == DescriptorClass::GeneralBuffer || descriptor_class == DescriptorClass::TexelBuffer ||
+               descriptor_class == DescriptorClass::PlainSampler || descriptor_class == DescriptorClass::AccelerationStructure;
+    }
+    bool HasValidatedDrawState(const DrawValidationKey &key) const;
+    void SetValidatedDrawState(const DrawValidationKey &key) const;
+
     const std::vector<vku::safe_VkWriteDescriptorSet> &GetWrites() const { return push_descriptor_set_writes; }
 
     void Destroy() override;
@@ -1029,6 +1091,12 @@ class DescriptorSet : public StateObject {
     // If this descriptor set is a push descriptor set, the descriptor
     // set writes that were last pushed.
     std::vector<vku::safe_VkWriteDescriptorSet> push_descriptor_set_writes;
+
+    static constexpr uint32_t kMaxDrawValidationKeys = 4;
+    mutable std::mutex draw_validation_lock_;
+    mutable std::array<DrawValidationKey, kMaxDrawValidationKeys> draw_validation_keys_{};
+    mutable uint32_t draw_validation_key_count_ = 0;
+    mutable uint32_t draw_validation_next_key_ = 0;
 };
 
 }  // namespace vvl
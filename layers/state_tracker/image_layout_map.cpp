@@ -94,6 +94,11 @@ ImageSubresourceLayoutMap::ImageSubresourceLayoutMap(const vvl::Image& image_sta
       layouts_(encoder_.SubresourceCount()),
       initial_layout_states_() {}
 
+void ImageSubresourceLayoutMap::Reset() {
+    layouts_.clear();
+    initial_layout_states_.clear();
+}
+
 // Use the unwrapped maps from the BothMap in the actual implementation
 template <typename LayoutMap>
 static bool SetSubresourceRangeLayoutImpl(LayoutMap& layouts, InitialLayoutStates& initial_layout_states, RangeGenerator& range_gen,
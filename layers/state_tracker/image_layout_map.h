@@ -123,6 +123,8 @@ class ImageSubresourceLayoutMap {
     const LayoutMap& GetLayoutMap() const { return layouts_; }
     ImageSubresourceLayoutMap(const vvl::Image& image_state);
     ~ImageSubresourceLayoutMap() {}
+    // Back to the state of a newly constructed map, for the same image
+    void Reset();
     const vvl::Image* GetImageView() const { return &image_state_; };
 
     // This looks a bit ponderous but kAspectCount is a compile time constant
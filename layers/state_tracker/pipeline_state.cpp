@@ -55,6 +55,20 @@ static vku::safe_VkGraphicsPipelineCreateInfo MakeGraphicsCreateInfo(const VkGra
     return vku::safe_VkGraphicsPipelineCreateInfo(&ci, use_color, use_depth_stencil, &copy_state);
 }
 
+// Returns the stage state built by the library a linked sub-state came from, if any
+static const ShaderStageState *FindLibraryStageState(const Pipeline &pipe_state, const PipelineSubState *sub_state,
+                                                     VkShaderStageFlagBits stage) {
+    if (!sub_state || &sub_state->parent == &pipe_state) {
+        return nullptr;
+    }
+    for (const auto &stage_state : sub_state->parent.stage_states) {
+        if (stage_state.GetStage() == stage) {
+            return &stage_state;
+        }
+    }
+    return nullptr;
+}
+
 // static
 std::vector<ShaderStageState> Pipeline::GetStageStates(const ValidationStateTracker &state_data, const Pipeline &pipe_state,
                                                        spirv::StatelessData *stateless_data) {
@@ -91,7 +105,8 @@ std::vector<ShaderStageState> Pipeline::GetStageStates(const ValidationStateTrac
             // This support was also added in VK_KHR_maintenance5
             if (const auto shader_ci = vku::FindStructInPNextChain<VkShaderModuleCreateInfo>(stage_ci.pNext)) {
                 // don't need to worry about GroupDecoration in GPL
-                auto spirv_module = std::make_shared<spirv::Module>(shader_ci->codeSize, shader_ci->pCode, stateless_data);
+                auto spirv_module = std::make_shared<spirv::Module>(shader_ci->codeSize, shader_ci->pCode, stateless_data,
+                                                                    state_data.spirv_static_data_cache.get());
                 module_state = std::make_shared<vvl::ShaderModule>(VK_NULL_HANDLE, spirv_module);
                 if (stateless_data) {
                     stateless_data->pipeline_pnext_module = spirv_module;
@@ -168,6 +183,15 @@ std::vector<ShaderStageState> Pipeline::GetStageStates(const ValidationStateTrac
             continue;
         }
 
+        // The library already resolved this stage (entry point lookup included), share its stage state instead of rebuilding it
+        const PipelineSubState *sub_state = (stage_flag == VK_SHADER_STAGE_FRAGMENT_BIT)
+                                                ? static_cast<const PipelineSubState *>(pipe_state.fragment_shader_state.get())
+                                                : static_cast<const PipelineSubState *>(pipe_state.pre_raster_state.get());
+        if (const ShaderStageState *lib_stage_state = FindLibraryStageState(pipe_state, sub_state, stage_flag)) {
+            stage_states.emplace_back(*lib_stage_state);
+            continue;
+        }
+
         stage_states.emplace_back(stage_ci, nullptr, module_state, module_state->spirv);
     }
     return stage_states;
@@ -186,19 +210,28 @@ static uint32_t GetCreateInfoShaders(const Pipeline &pipe_state) {
     return result;
 }
 
-static uint32_t GetLinkingShaders(const VkPipelineLibraryCreateInfoKHR *link_info, const ValidationStateTracker &state_data) {
-    uint32_t result = 0;
+static std::vector<std::shared_ptr<const vvl::Pipeline>> GetLinkedLibraries(const VkPipelineLibraryCreateInfoKHR *link_info,
+                                                                             const ValidationStateTracker &state_data) {
+    std::vector<std::shared_ptr<const vvl::Pipeline>> result;
     if (link_info) {
+        result.reserve(link_info->libraryCount);
         for (uint32_t i = 0; i < link_info->libraryCount; ++i) {
-            const auto &state = state_data.Get<vvl::Pipeline>(link_info->pLibraries[i]);
-            if (state) {
-                result |= state->active_shaders;
+            if (auto state = state_data.Get<vvl::Pipeline>(link_info->pLibraries[i])) {
+                result.emplace_back(std::move(state));
             }
         }
     }
     return result;
 }
 
+static uint32_t GetLinkingShaders(const Pipeline &pipe_state) {
+    uint32_t result = 0;
+    for (const auto &lib : pipe_state.linked_libraries) {
+        result |= lib->active_shaders;
+    }
+    return result;
+}
+
 static CBDynamicFlags GetGraphicsDynamicState(Pipeline &pipe_state) {
     CBDynamicFlags flags = 0;
 
@@ -435,13 +468,10 @@ static bool UsesPipelineVertexRobustness(const void *pNext, const Pipeline &pipe
     return result;
 }
 
-static bool IgnoreColorAttachments(const ValidationStateTracker &state_data, Pipeline &pipe_state) {
+static bool IgnoreColorAttachments(const Pipeline &pipe_state) {
     // If the libraries used to create this pipeline are ignoring color attachments, this pipeline should as well
-    if (pipe_state.library_create_info) {
-        for (uint32_t i = 0; i < pipe_state.library_create_info->libraryCount; i++) {
-            const auto lib = state_data.Get<vvl::Pipeline>(pipe_state.library_create_info->pLibraries[i]);
-            if (lib->ignore_color_attachments) return true;
-        }
+    for (const auto &lib : pipe_state.linked_libraries) {
+        if (lib->ignore_color_attachments) return true;
     }
     // According to the spec, pAttachments is to be ignored if the pipeline is created with
     // VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT, VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT, VK_DYNAMIC_STATE_COLOR_BLEND_ADVANCED_EXT
@@ -525,7 +555,7 @@ std::shared_ptr<VertexInputState> Pipeline::CreateVertexInputState(const Pipelin
     }
 
     if (p.library_create_info) {
-        auto ss = GetLibSubState<VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT>(state, *p.library_create_info);
+        auto ss = GetLibSubState<VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT>(p.linked_libraries);
         if (ss) {
             return ss;
         }
@@ -549,7 +579,7 @@ std::shared_ptr<PreRasterState> Pipeline::CreatePreRasterState(
     }
 
     if (p.library_create_info) {
-        auto ss = GetLibSubState<VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT>(state, *p.library_create_info);
+        auto ss = GetLibSubState<VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT>(p.linked_libraries);
         if (ss) {
             return ss;
         }
@@ -575,7 +605,7 @@ std::shared_ptr<FragmentShaderState> Pipeline::CreateFragmentShaderState(
     }
 
     if (p.library_create_info) {
-        auto ss = GetLibSubState<VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT>(state, *p.library_create_info);
+        auto ss = GetLibSubState<VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT>(p.linked_libraries);
         if (ss && EnablesRasterizationStates(p.pre_raster_state)) {
             return ss;
         }
@@ -607,7 +637,7 @@ std::shared_ptr<FragmentOutputState> Pipeline::CreateFragmentOutputState(
     }
 
     if (p.library_create_info) {
-        auto ss = GetLibSubState<VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT>(state, *p.library_create_info);
+        auto ss = GetLibSubState<VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT>(p.linked_libraries);
         // If this pipeline is linking in a library that contains FO state, check to see if the FO state is valid before creating it
         // for this pipeline
         if (ss && EnablesRasterizationStates(p.pre_raster_state)) {
@@ -700,6 +730,7 @@ Pipeline::Pipeline(const ValidationStateTracker &state_data, const VkGraphicsPip
       create_flags(GetPipelineCreateFlags(GraphicsCreateInfo().pNext, GraphicsCreateInfo().flags)),
       shader_stages_ci(GraphicsCreateInfo().pStages, GraphicsCreateInfo().stageCount),
       uses_shader_module_id(UsesShaderModuleId(*this)),
+      linked_libraries(GetLinkedLibraries(library_create_info, state_data)),
       vertex_input_state(CreateVertexInputState(*this, state_data, GraphicsCreateInfo())),
       pre_raster_state(CreatePreRasterState(*this, state_data, GraphicsCreateInfo(), rpstate, stateless_data)),
       fragment_shader_state(
@@ -707,17 +738,18 @@ Pipeline::Pipeline(const ValidationStateTracker &state_data, const VkGraphicsPip
       fragment_output_state(CreateFragmentOutputState(*this, state_data, *pCreateInfo, GraphicsCreateInfo(), rpstate)),
       stage_states(GetStageStates(state_data, *this, stateless_data)),
       create_info_shaders(GetCreateInfoShaders(*this)),
-      linking_shaders(GetLinkingShaders(library_create_info, state_data)),
+      linking_shaders(GetLinkingShaders(*this)),
       active_shaders(create_info_shaders | linking_shaders),
       fragmentShader_writable_output_location_list(GetFSOutputLocations(stage_states)),
       active_slots(GetActiveSlots(stage_states)),
       max_active_slot(GetMaxActiveSlot(active_slots)),
+      descriptor_requirements(GetDescriptorRequirementTable(active_slots)),
       dynamic_state(GetGraphicsDynamicState(*this)),
       topology_at_rasterizer(GetTopologyAtRasterizer(*this)),
       descriptor_buffer_mode((create_flags & VK_PIPELINE_CREATE_2_DESCRIPTOR_BUFFER_BIT_EXT) != 0),
       uses_pipeline_robustness(UsesPipelineRobustness(GraphicsCreateInfo().pNext, *this)),
       uses_pipeline_vertex_robustness(UsesPipelineVertexRobustness(GraphicsCreateInfo().pNext, *this)),
-      ignore_color_attachments(IgnoreColorAttachments(state_data, *this)) {
+      ignore_color_attachments(IgnoreColorAttachments(*this)) {
     if (library_create_info) {
         const auto &exe_layout_state = state_data.Get<vvl::PipelineLayout>(GraphicsCreateInfo().layout);
         const auto *exe_layout = exe_layout_state.get();
@@ -732,13 +764,8 @@ Pipeline::Pipeline(const ValidationStateTracker &state_data, const VkGraphicsPip
         layouts[2] = pre_raster_layout;
         merged_graphics_layout = std::make_shared<vvl::PipelineLayout>(layouts);
 
-        // TODO Could store the graphics_lib_type in the sub-state rather than searching for it again here.
-        //      Or, could store a pointer back to the owning Pipeline.
-        for (uint32_t i = 0; i < library_create_info->libraryCount; ++i) {
-            const auto &state = state_data.Get<vvl::Pipeline>(library_create_info->pLibraries[i]);
-            if (state) {
-                graphics_lib_type |= state->graphics_lib_type;
-            }
+        for (const auto &lib : linked_libraries) {
+            graphics_lib_type |= lib->graphics_lib_type;
         }
     }
 }
@@ -758,11 +785,12 @@ Pipeline::Pipeline(const ValidationStateTracker &state_data, const VkComputePipe
       active_shaders(create_info_shaders),  // compute has no linking shaders
       active_slots(GetActiveSlots(stage_states)),
       max_active_slot(GetMaxActiveSlot(active_slots)),
+      descriptor_requirements(GetDescriptorRequirementTable(active_slots)),
       dynamic_state(0),  // compute has no dynamic state
       descriptor_buffer_mode((create_flags & VK_PIPELINE_CREATE_2_DESCRIPTOR_BUFFER_BIT_EXT) != 0),
       uses_pipeline_robustness(UsesPipelineRobustness(ComputeCreateInfo().pNext, *this)),
       uses_pipeline_vertex_robustness(false),
-      ignore_color_attachments(IgnoreColorAttachments(state_data, *this)),
+      ignore_color_attachments(IgnoreColorAttachments(*this)),
       merged_graphics_layout(layout) {
     assert(active_shaders == VK_SHADER_STAGE_COMPUTE_BIT);
 }
@@ -783,11 +811,12 @@ Pipeline::Pipeline(const ValidationStateTracker &state_data, const VkRayTracingP
       active_shaders(create_info_shaders),  // RTX has no linking shaders
       active_slots(GetActiveSlots(stage_states)),
       max_active_slot(GetMaxActiveSlot(active_slots)),
+      descriptor_requirements(GetDescriptorRequirementTable(active_slots)),
       dynamic_state(GetRayTracingDynamicState(*this)),
       descriptor_buffer_mode((RayTracingCreateInfo().flags & VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT) != 0),
       uses_pipeline_robustness(UsesPipelineRobustness(RayTracingCreateInfo().pNext, *this)),
       uses_pipeline_vertex_robustness(false),
-      ignore_color_attachments(IgnoreColorAttachments(state_data, *this)),
+      ignore_color_attachments(IgnoreColorAttachments(*this)),
       merged_graphics_layout(std::move(layout)) {
     assert(0 == (active_shaders & ~(kShaderStageAllRayTracing)));
 }
@@ -808,11 +837,12 @@ Pipeline::Pipeline(const ValidationStateTracker &state_data, const VkRayTracingP
       active_shaders(create_info_shaders),  // RTX has no linking shaders
       active_slots(GetActiveSlots(stage_states)),
       max_active_slot(GetMaxActiveSlot(active_slots)),
+      descriptor_requirements(GetDescriptorRequirementTable(active_slots)),
       dynamic_state(GetRayTracingDynamicState(*this)),
       descriptor_buffer_mode((RayTracingCreateInfo().flags & VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT) != 0),
       uses_pipeline_robustness(UsesPipelineRobustness(RayTracingCreateInfo().pNext, *this)),
       uses_pipeline_vertex_robustness(false),
-      ignore_color_attachments(IgnoreColorAttachments(state_data, *this)),
+      ignore_color_attachments(IgnoreColorAttachments(*this)),
       merged_graphics_layout(std::move(layout)) {
     assert(0 == (active_shaders & ~(kShaderStageAllRayTracing)));
 }
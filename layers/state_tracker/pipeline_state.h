@@ -94,6 +94,10 @@ class Pipeline : public StateObject {
     const vku::safe_VkPipelineLibraryCreateInfoKHR *ray_tracing_library_ci = nullptr;
     // If using a shader module identifier, the module itself is not validated, but the shader stage is still known
     const bool uses_shader_module_id;
+    // Graphics libraries from VkPipelineLibraryCreateInfoKHR::pLibraries, resolved once.
+    // Linked sub-states are shared with (not copied from) these libraries, holding them here keeps the sub-states' parent and
+    // the create info they point into alive even if the application destroys the library after linking.
+    const std::vector<std::shared_ptr<const vvl::Pipeline>> linked_libraries;
 
     // State split up based on library types
     const std::shared_ptr<VertexInputState> vertex_input_state;  // VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT
@@ -121,6 +125,8 @@ class Pipeline : public StateObject {
     // are updated at various times. Locking requirements are TBD.
     const ActiveSlotMap active_slots;
     const uint32_t max_active_slot = 0;  // the highest set number in active_slots for pipeline layout compatibility checks
+    // active_slots flattened for draw time validation
+    const DescriptorRequirementTable descriptor_requirements;
 
     // Which state is dynamic from pipeline creation, factors in GPL sub state as well
     CBDynamicFlags dynamic_state;
@@ -213,11 +219,10 @@ class Pipeline : public StateObject {
     std::shared_ptr<const vvl::ShaderModule> GetSubStateShader(VkShaderStageFlagBits state) const;
 
     template <VkGraphicsPipelineLibraryFlagBitsEXT type_flag>
-    static inline typename SubStateTraits<type_flag>::type GetLibSubState(const ValidationStateTracker &state,
-                                                                          const VkPipelineLibraryCreateInfoKHR &link_info) {
-        for (uint32_t i = 0; i < link_info.libraryCount; ++i) {
-            const auto lib_state = state.Get<vvl::Pipeline>(link_info.pLibraries[i]);
-            if (lib_state && ((lib_state->graphics_lib_type & type_flag) != 0)) {
+    static inline typename SubStateTraits<type_flag>::type GetLibSubState(
+        const std::vector<std::shared_ptr<const vvl::Pipeline>> &libraries) {
+        for (const auto &lib_state : libraries) {
+            if ((lib_state->graphics_lib_type & type_flag) != 0) {
                 return GetSubState<type_flag>(*lib_state);
             }
         }
@@ -231,6 +236,12 @@ class Pipeline : public StateObject {
     // TODO - This could probably just be a check to VkGraphicsPipelineLibraryCreateInfoEXT::flags
     bool OwnsSubState(const std::shared_ptr<PipelineSubState> sub_state) const { return sub_state && (&sub_state->parent == this); }
 
+    // True if both sub-states were linked in from the same library. Checks that only involve those two sub-states already ran
+    // when the library was created, so linking only needs to validate what crosses library boundaries.
+    bool LinkedFromSameLibrary(const std::shared_ptr<PipelineSubState> &a, const std::shared_ptr<PipelineSubState> &b) const {
+        return a && b && (&a->parent == &b->parent) && (&a->parent != this);
+    }
+
     const std::shared_ptr<const vvl::RenderPass> RenderPassState() const {
         // TODO A render pass object is required for all of these sub-states. Which one should be used for an "executable pipeline"?
         if (fragment_output_state && fragment_output_state->rp_state) {
@@ -691,6 +702,8 @@ struct LastBound {
         const vvl::DescriptorSet *validated_set{nullptr};
         uint64_t validated_set_change_count{~0ULL};
         uint64_t validated_set_image_layout_change_count{~0ULL};
+        // GetId() of the pipeline or shader object whose descriptor requirements were last validated against validated_set
+        vvl::StateObject::IdType validated_requirements_id{0};
 
         void Reset() {
             bound_descriptor_set.reset();
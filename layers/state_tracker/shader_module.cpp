@@ -15,14 +15,26 @@
 
 #include "state_tracker/shader_module.h"
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <queue>
 
 #include "utils/hash_util.h"
+#include "utils/vk_layer_utils.h"
 #include "generated/spirv_grammar_helper.h"
+#include "generated/shader_reflection_hash.h"
 #include "spirv/1.2/GLSL.std.450.h"
 
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace spirv {
 
 void DecorationBase::Add(uint32_t decoration, uint32_t value) {
@@ -764,19 +776,20 @@ ImageAccess::ImageAccess(const Module& module_state, const Instruction& image_in
     }
 }
 
-EntryPoint::EntryPoint(const Module& module_state, const Instruction& entrypoint_insn, const ImageAccessMap& image_access_map,
+std::atomic<uint64_t> EntryPoint::next_unique_id{1};
+
+EntryPoint::EntryPoint(const Module& module_state, const Instruction& entrypoint_insn,
                        const AccessChainVariableMap& access_chain_map, const VariableAccessMap& variable_access_map,
-                       const DebugNameMap& debug_name_map)
+                       const DebugNameMap& debug_name_map, EntryPointReflection* reflection)
     : entrypoint_insn(entrypoint_insn),
       execution_model(spv::ExecutionModel(entrypoint_insn.Word(1))),
       stage(static_cast<VkShaderStageFlagBits>(ExecutionModelToShaderStageFlagBits(execution_model))),
       id(entrypoint_insn.Word(2)),
       name(entrypoint_insn.GetAsString(3)),
       execution_mode(module_state.GetExecutionModeSet(id)),
-      emit_vertex_geometry(false),
-      accessible_ids(GetAccessibleIds(module_state, *this)),
-      resource_interface_variables(GetResourceInterfaceVariables(module_state, *this, image_access_map, access_chain_map,
-                                                                 variable_access_map, debug_name_map)),
+      unique_id(next_unique_id++),
+      emit_vertex_geometry(reflection ? reflection->emit_vertex_geometry : false),
+      accessible_ids(reflection ? std::move(reflection->accessible_ids) : GetAccessibleIds(module_state, *this)),
       stage_interface_variables(GetStageInterfaceVariables(module_state, *this, variable_access_map, debug_name_map)) {
     // After all variables are made, can get references from them
     // Also can set per-Entrypoint values now
@@ -840,6 +853,16 @@ EntryPoint::EntryPoint(const Module& module_state, const Instruction& entrypoint
     }
 }
 
+void EntryPoint::BuildResourceInterface(const Module& module_state) {
+    std::call_once(resource_interface_once_, [this, &module_state]() {
+        const auto& static_data = module_state.static_data_;
+        const ImageAccessMap& image_access_map = static_data.GetImageAccessMap(module_state);
+        resource_interface_variables =
+            GetResourceInterfaceVariables(module_state, *this, image_access_map, static_data.access_chain_map,
+                                          static_data.variable_access_map, static_data.debug_name_map);
+    });
+}
+
 std::optional<VkPrimitiveTopology> Module::GetTopology(const EntryPoint& entrypoint) const {
     std::optional<VkPrimitiveTopology> result;
 
@@ -853,8 +876,318 @@ std::optional<VkPrimitiveTopology> Module::GetTopology(const EntryPoint& entrypo
     return result;
 }
 
-Module::StaticData::StaticData(const Module& module_state, StatelessData* stateless_data) {
-    if (!module_state.valid_spirv) return;
+Module::Module(vvl::span<const uint32_t> code)
+    : valid_spirv(true),
+      words_(code.begin(), code.end()),
+      static_data_storage_(std::make_shared<StaticData>()),
+      static_data_(*static_data_storage_) {
+    static_data_storage_->Build(*this, nullptr);
+}
+
+Module::Module(size_t codeSize, const uint32_t* pCode, StatelessData* stateless_data, StaticDataCache* cache)
+    : valid_spirv(pCode && pCode[0] == spv::MagicNumber && ((codeSize % 4) == 0)),
+      words_(pCode, pCode + codeSize / sizeof(uint32_t)),
+      static_data_storage_(AcquireStaticData(cache, stateless_data)),
+      static_data_(*static_data_storage_) {
+    if (static_data_shared_) return;
+
+    const bool use_cache = cache && stateless_data && valid_spirv;
+    std::shared_ptr<const std::vector<uint32_t>> persisted_reflection;
+    const bool persist = use_cache && cache->PersistsReflection();
+    if (persist) {
+        persisted_reflection = cache->FindReflection(cache_key_);
+    }
+    const bool restored = static_data_storage_->Build(*this, stateless_data, persisted_reflection.get());
+
+    // Modules with group decorations are re-created from the flattened SPIR-V, nothing worth sharing
+    if (use_cache && !stateless_data->has_group_decoration) {
+        if (persist && !restored) {
+            static_data_storage_->RecordReflectionTo(cache->weak_from_this(), cache_key_);
+        }
+        cache->Insert(cache_key_, static_data_storage_, *stateless_data);
+    }
+}
+
+std::shared_ptr<Module::StaticData> Module::AcquireStaticData(StaticDataCache* cache, StatelessData* stateless_data) {
+    // Without StatelessData the parsing doesn't stop at group decorations, so only share what was built with it
+    if (cache && stateless_data && valid_spirv) {
+        cache_key_ = hash_util::ShaderHash128(words_.data(), words_.size() * sizeof(uint32_t));
+        auto shared = cache->Find(cache_key_, *stateless_data);
+        if (shared) {
+            static_data_shared_ = true;
+            return shared;
+        }
+    }
+    return std::make_shared<StaticData>();
+}
+
+std::shared_ptr<Module::StaticData> StaticDataCache::Find(const hash_util::Hash128& key, StatelessData& stateless_data) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return nullptr;
+    auto static_data = it->second.static_data.lock();
+    if (!static_data) {
+        entries_.erase(it);
+        return nullptr;
+    }
+    auto pipeline_pnext_module = std::move(stateless_data.pipeline_pnext_module);
+    stateless_data = it->second.stateless_data;
+    stateless_data.pipeline_pnext_module = std::move(pipeline_pnext_module);
+    return static_data;
+}
+
+void StaticDataCache::Insert(const hash_util::Hash128& key, const std::shared_ptr<Module::StaticData>& static_data,
+                             const StatelessData& stateless_data) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (entries_.size() >= sweep_size_) {
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            if (it->second.static_data.expired()) {
+                it = entries_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        sweep_size_ = std::max<size_t>(64, entries_.size() * 2);
+    }
+    Entry& entry = entries_[key];
+    entry.static_data = static_data;
+    entry.stateless_data = stateless_data;
+    // Would keep the Module alive from the cache
+    entry.stateless_data.pipeline_pnext_module.reset();
+}
+
+std::shared_ptr<const std::vector<uint32_t>> StaticDataCache::FindReflection(const hash_util::Hash128& key) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = reflection_records_.find(key);
+    if (it == reflection_records_.end()) return nullptr;
+    it->second.used = true;
+    return it->second.words;
+}
+
+void StaticDataCache::InsertReflection(const hash_util::Hash128& key, std::vector<uint32_t>&& record) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!persist_reflection_) return;
+    reflection_records_[key] = {std::make_shared<const std::vector<uint32_t>>(std::move(record)), true};
+    reflection_dirty_ = true;
+}
+
+// File layout (all uint32_t):
+//   magic, build key (4 words), record count
+//   [hash low (2 words), hash high (2 words), word count, words...] * record count
+static constexpr uint32_t kReflectionCacheMagic = 0x52565653;  // "SVVR"
+static constexpr size_t kReflectionHeaderSize = 6;
+
+// Records are only valid for the code that computed them, so the key is the hash of the sources doing the reflection
+static void GetReflectionBuildKey(uint32_t* out) {
+    const char* source_hash = SHADER_REFLECTION_SOURCE_HASH;
+    const hash_util::Hash128 build_key = hash_util::ShaderHash128(source_hash, std::strlen(source_hash));
+    out[0] = static_cast<uint32_t>(build_key.low);
+    out[1] = static_cast<uint32_t>(build_key.low >> 32);
+    out[2] = static_cast<uint32_t>(build_key.high);
+    out[3] = static_cast<uint32_t>(build_key.high >> 32);
+}
+
+void StaticDataCache::LoadReflection(const std::string& path) {
+    std::lock_guard<std::mutex> guard(lock_);
+    persist_reflection_ = true;
+
+    std::ifstream read_file(path.c_str(), std::ios::in | std::ios::binary);
+    if (!read_file) return;  // may not exist yet
+    std::vector<char> bytes((std::istreambuf_iterator<char>(read_file)), std::istreambuf_iterator<char>());
+    if (bytes.size() % sizeof(uint32_t) != 0) return;
+    std::vector<uint32_t> words(bytes.size() / sizeof(uint32_t));
+    std::memcpy(words.data(), bytes.data(), bytes.size());
+
+    // Anything written by another build of the layer is thrown away, it will be rewritten on exit
+    uint32_t build_key[4];
+    GetReflectionBuildKey(build_key);
+    if (words.size() < kReflectionHeaderSize || words[0] != kReflectionCacheMagic ||
+        std::memcmp(&words[1], build_key, sizeof(build_key)) != 0) {
+        return;
+    }
+    const uint32_t record_count = words[5];
+    size_t offset = kReflectionHeaderSize;
+    for (uint32_t i = 0; i < record_count; ++i) {
+        if (offset + 5 > words.size()) break;
+        hash_util::Hash128 key;
+        key.low = uint64_t(words[offset]) | (uint64_t(words[offset + 1]) << 32);
+        key.high = uint64_t(words[offset + 2]) | (uint64_t(words[offset + 3]) << 32);
+        const uint32_t word_count = words[offset + 4];
+        offset += 5;
+        if (word_count > words.size() - offset) break;
+        reflection_records_[key].words =
+            std::make_shared<const std::vector<uint32_t>>(words.begin() + offset, words.begin() + offset + word_count);
+        offset += word_count;
+    }
+}
+
+bool StaticDataCache::SaveReflection(const std::string& path) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!persist_reflection_ || !reflection_dirty_) return true;
+
+    // Keep the file bounded, records of SPIR-V this run didn't see go first
+    if (reflection_records_.size() > kMaxReflectionRecords) {
+        for (auto it = reflection_records_.begin();
+             it != reflection_records_.end() && reflection_records_.size() > kMaxReflectionRecords;) {
+            it = it->second.used ? std::next(it) : reflection_records_.erase(it);
+        }
+        for (auto it = reflection_records_.begin(); reflection_records_.size() > kMaxReflectionRecords;) {
+            it = reflection_records_.erase(it);
+        }
+    }
+
+    std::vector<uint32_t> words(kReflectionHeaderSize);
+    words[0] = kReflectionCacheMagic;
+    GetReflectionBuildKey(&words[1]);
+    words[5] = static_cast<uint32_t>(reflection_records_.size());
+    for (const auto& [key, record] : reflection_records_) {
+        words.insert(words.end(), {static_cast<uint32_t>(key.low), static_cast<uint32_t>(key.low >> 32),
+                                   static_cast<uint32_t>(key.high), static_cast<uint32_t>(key.high >> 32),
+                                   static_cast<uint32_t>(record.words->size())});
+        words.insert(words.end(), record.words->begin(), record.words->end());
+    }
+
+    // Write next to the cache and rename over it, so another process loading the cache (or one exiting at the same time)
+    // never sees a partially written file
+#if defined(_WIN32)
+    const std::string temp_path = path + "." + std::to_string(_getpid()) + ".tmp";
+#else
+    const std::string temp_path = path + "." + std::to_string(getpid()) + ".tmp";
+#endif
+    {
+        std::ofstream write_file(temp_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!write_file) return false;
+        write_file.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint32_t));
+        write_file.close();
+        if (!write_file) {
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+#if defined(_WIN32)
+    // rename() doesn't replace an existing file on Windows
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    reflection_dirty_ = false;
+    return true;
+}
+
+// A reflection record is made of (all uint32_t):
+//   entry point count, [emit_vertex_geometry, accessible id count, ids...] * entry point count
+//   image access count, [flags, access_mask, image chain index, sampler chain index, texel count,
+//                        image variable count, instruction index..., sampler variable count, instruction index...] * count
+// Instructions are stored as their index into StaticData::instructions so the record doesn't depend on the address.
+enum ImageAccessRecordFlag : uint32_t {
+    kRecordValidAccess = 1u << 0,
+    kRecordIsDref = 1u << 1,
+    kRecordIsSamplerImplicitLodDrefProj = 1u << 2,
+    kRecordIsSamplerSampled = 1u << 3,
+    kRecordIsNotSamplerSampled = 1u << 4,
+    kRecordIsSamplerBiasOffset = 1u << 5,
+    kRecordIsSamplerOffset = 1u << 6,
+    kRecordIsSignExtended = 1u << 7,
+    kRecordIsZeroExtended = 1u << 8,
+};
+
+static void EncodeReflection(const std::vector<Instruction>& instructions,
+                             const std::vector<std::shared_ptr<EntryPoint>>& entry_points,
+                             const std::vector<std::shared_ptr<ImageAccess>>& image_accesses, std::vector<uint32_t>& out) {
+    out.clear();
+    out.push_back(static_cast<uint32_t>(entry_points.size()));
+    for (const auto& entry_point : entry_points) {
+        out.push_back(entry_point->emit_vertex_geometry ? 1u : 0u);
+        out.push_back(static_cast<uint32_t>(entry_point->accessible_ids.size()));
+        out.insert(out.end(), entry_point->accessible_ids.begin(), entry_point->accessible_ids.end());
+    }
+
+    auto push_instructions = [&out, &instructions](const std::vector<const Instruction*>& list) {
+        out.push_back(static_cast<uint32_t>(list.size()));
+        for (const Instruction* insn : list) {
+            out.push_back(static_cast<uint32_t>(insn - instructions.data()));
+        }
+    };
+    out.push_back(static_cast<uint32_t>(image_accesses.size()));
+    for (const auto& access : image_accesses) {
+        uint32_t flags = 0;
+        flags |= access->valid_access ? kRecordValidAccess : 0;
+        flags |= access->is_dref ? kRecordIsDref : 0;
+        flags |= access->is_sampler_implicitLod_dref_proj ? kRecordIsSamplerImplicitLodDrefProj : 0;
+        flags |= access->is_sampler_sampled ? kRecordIsSamplerSampled : 0;
+        flags |= access->is_not_sampler_sampled ? kRecordIsNotSamplerSampled : 0;
+        flags |= access->is_sampler_bias_offset ? kRecordIsSamplerBiasOffset : 0;
+        flags |= access->is_sampler_offset ? kRecordIsSamplerOffset : 0;
+        flags |= access->is_sign_extended ? kRecordIsSignExtended : 0;
+        flags |= access->is_zero_extended ? kRecordIsZeroExtended : 0;
+        out.insert(out.end(), {flags, access->access_mask, access->image_access_chain_index, access->sampler_access_chain_index,
+                               access->texel_component_count});
+        push_instructions(access->variable_image_insn);
+        push_instructions(access->variable_sampler_insn);
+    }
+}
+
+// Returns false if the record doesn't match the module (in which case the outputs are in an undefined state)
+static bool DecodeReflection(const std::vector<uint32_t>& record, const std::vector<Instruction>& instructions,
+                             size_t entry_point_count, const std::vector<const Instruction*>& image_instructions,
+                             std::vector<EntryPointReflection>& entry_point_reflections,
+                             std::vector<std::shared_ptr<ImageAccess>>& image_accesses) {
+    size_t offset = 0;
+    auto read = [&record, &offset](uint32_t& value) {
+        if (offset >= record.size()) return false;
+        value = record[offset++];
+        return true;
+    };
+    auto read_instructions = [&read, &instructions](std::vector<const Instruction*>& list) {
+        uint32_t count = 0;
+        if (!read(count)) return false;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t index = 0;
+            if (!read(index) || index >= instructions.size()) return false;
+            list.push_back(&instructions[index]);
+        }
+        return true;
+    };
+
+    uint32_t count = 0;
+    if (!read(count) || count != entry_point_count) return false;
+    entry_point_reflections.resize(count);
+    for (auto& reflection : entry_point_reflections) {
+        uint32_t emit = 0;
+        uint32_t id_count = 0;
+        if (!read(emit) || !read(id_count) || id_count > record.size() - offset) return false;
+        reflection.emit_vertex_geometry = emit != 0;
+        reflection.accessible_ids.insert(record.begin() + offset, record.begin() + offset + id_count);
+        offset += id_count;
+    }
+
+    if (!read(count) || count != image_instructions.size()) return false;
+    for (const Instruction* image_insn : image_instructions) {
+        auto access = image_accesses.emplace_back(std::make_shared<ImageAccess>(*image_insn));
+        uint32_t flags = 0;
+        if (!read(flags) || !read(access->access_mask) || !read(access->image_access_chain_index) ||
+            !read(access->sampler_access_chain_index) || !read(access->texel_component_count) ||
+            !read_instructions(access->variable_image_insn) || !read_instructions(access->variable_sampler_insn)) {
+            return false;
+        }
+        access->valid_access = (flags & kRecordValidAccess) != 0;
+        access->is_dref = (flags & kRecordIsDref) != 0;
+        access->is_sampler_implicitLod_dref_proj = (flags & kRecordIsSamplerImplicitLodDrefProj) != 0;
+        access->is_sampler_sampled = (flags & kRecordIsSamplerSampled) != 0;
+        access->is_not_sampler_sampled = (flags & kRecordIsNotSamplerSampled) != 0;
+        access->is_sampler_bias_offset = (flags & kRecordIsSamplerBiasOffset) != 0;
+        access->is_sampler_offset = (flags & kRecordIsSamplerOffset) != 0;
+        access->is_sign_extended = (flags & kRecordIsSignExtended) != 0;
+        access->is_zero_extended = (flags & kRecordIsZeroExtended) != 0;
+    }
+    return offset == record.size();
+}
+
+bool Module::StaticData::Build(const Module& module_state, StatelessData* stateless_data,
+                               const std::vector<uint32_t>* persisted_reflection) {
+    if (!module_state.valid_spirv) return false;
 
     // Parse the words first so we have instruction class objects to use
     {
@@ -870,7 +1203,7 @@ Module::StaticData::StaticData(const Module& module_state, StatelessData* statel
                 if (stateless_data) {
                     assert(stateless_data->has_group_decoration == false);  // if assert, spirv-opt didn't flatten it
                     stateless_data->has_group_decoration = true;
-                    return;  // no need to continue parsing
+                    return false;  // no need to continue parsing
                 }
             }
 
@@ -882,30 +1215,29 @@ Module::StaticData::StaticData(const Module& module_state, StatelessData* statel
     // These have their own object class, but need entire module parsed first
     std::vector<const Instruction*> entry_point_instructions;
     std::vector<const Instruction*> type_struct_instructions;
-    std::vector<const Instruction*> image_instructions;
     std::vector<const Instruction*> func_call_instructions;
     // both OpDecorate and OpMemberDecorate builtin instructions
     std::vector<const Instruction*> builtin_decoration_instructions;
 
-    DebugNameMap debug_name_map;
-
     std::vector<uint32_t> store_pointer_ids;
     std::vector<uint32_t> load_pointer_ids;
     std::vector<uint32_t> atomic_store_pointer_ids;
     std::vector<uint32_t> atomic_load_pointer_ids;
 
-    AccessChainVariableMap access_chain_map;
-
     uint32_t last_func_id = 0;
     // < Function ID, OpFunctionParameter Ids >
     vvl::unordered_map<uint32_t, std::vector<uint32_t>> func_parameter_list;
 
+    // Every valid result ID is below the bound in the header, ignore any other (spirv-val will report them)
+    const uint32_t id_bound = std::min(module_state.words_.size() > 3 ? module_state.words_[3] : 0u, kMaxIdBound);
+    definitions.resize(id_bound, nullptr);
+
     // Loop through once and build up the static data
     // Also process the entry points
     for (const Instruction& insn : instructions) {
         // Build definition list
         const uint32_t result_id = insn.ResultId();
-        if (result_id != 0) {
+        if (result_id != 0 && result_id < id_bound) {
             definitions[result_id] = &insn;
         }
 
@@ -1121,7 +1453,6 @@ Module::StaticData::StaticData(const Module& module_state, StatelessData* statel
         }
     }
 
-    FuncParameterMap func_parameter_map;
     const uint32_t first_arg_word = 4;
     for (const auto& func_def : func_parameter_list) {
         const uint32_t func_id = func_def.first;
@@ -1141,8 +1472,7 @@ Module::StaticData::StaticData(const Module& module_state, StatelessData* statel
 
     // parsing, take every load/store find the variable it touches
     // (image access are done later)
-    VariableAccessMap variable_access_map;
-    auto mark_variable_access = [&module_state, &variable_access_map](const std::vector<uint32_t>& ids, uint32_t access) {
+    auto mark_variable_access = [this, &module_state](const std::vector<uint32_t>& ids, uint32_t access) {
         for (const auto& object_id : ids) {
             uint32_t variable_id = object_id;
             const Instruction* insn = module_state.FindDef(object_id);
@@ -1194,24 +1524,69 @@ Module::StaticData::StaticData(const Module& module_state, StatelessData* statel
         type_struct_map[new_struct->id] = new_struct;
     }
 
-    // Need to get ImageAccesses as EntryPoint's variables depend on it
-    std::vector<std::shared_ptr<ImageAccess>> image_accesses;
-    ImageAccessMap image_access_map;
-
-    for (const auto& insn : image_instructions) {
-        auto new_access = image_accesses.emplace_back(std::make_shared<ImageAccess>(module_state, *insn, func_parameter_map));
-        if (!new_access->variable_image_insn.empty() && new_access->valid_access) {
-            for (const Instruction* image_insn : new_access->variable_image_insn) {
-                image_access_map[image_insn->ResultId()].push_back(new_access);
-            }
+    // The image dataflow and the call tree walk of each EntryPoint are the expensive parts, use the persisted results if
+    // they are from this exact module
+    std::vector<EntryPointReflection> entry_point_reflections;
+    std::vector<std::shared_ptr<ImageAccess>> restored_accesses;
+    bool restored = false;
+    if (persisted_reflection) {
+        restored = DecodeReflection(*persisted_reflection, instructions, entry_point_instructions.size(), image_instructions,
+                                    entry_point_reflections, restored_accesses);
+        if (!restored) {
+            entry_point_reflections.clear();
+            restored_accesses.clear();
         }
     }
 
     // Need to build the definitions table for FindDef before looking for which instructions each entry point uses
-    for (const auto& insn : entry_point_instructions) {
-        entry_points.emplace_back(std::make_shared<EntryPoint>(module_state, *insn, image_access_map, access_chain_map,
-                                                               variable_access_map, debug_name_map));
+    for (size_t i = 0; i < entry_point_instructions.size(); ++i) {
+        entry_points.emplace_back(std::make_shared<EntryPoint>(module_state, *entry_point_instructions[i], access_chain_map,
+                                                               variable_access_map, debug_name_map,
+                                                               restored ? &entry_point_reflections[i] : nullptr));
+    }
+
+    // Restoring is cheap, otherwise the image accesses are left for the first GetImageAccessMap()
+    if (restored) {
+        BuildImageAccesses(module_state, std::move(restored_accesses));
     }
+    return restored;
+}
+
+void Module::StaticData::RecordReflectionTo(const std::weak_ptr<StaticDataCache>& cache, const hash_util::Hash128& key) {
+    reflection_cache_ = cache;
+    reflection_key_ = key;
+}
+
+void Module::StaticData::BuildImageAccesses(const Module& module_state,
+                                            std::vector<std::shared_ptr<ImageAccess>>&& restored_accesses) const {
+    std::call_once(image_access_once_, [this, &module_state, &restored_accesses]() {
+        if (!restored_accesses.empty()) {
+            image_accesses_ = std::move(restored_accesses);
+        } else {
+            image_accesses_.reserve(image_instructions.size());
+            for (const auto& insn : image_instructions) {
+                image_accesses_.emplace_back(std::make_shared<ImageAccess>(module_state, *insn, func_parameter_map));
+            }
+            // Only modules that got this far are worth a record, and the EntryPoints were all built with the StaticData
+            if (auto cache = reflection_cache_.lock()) {
+                std::vector<uint32_t> record;
+                EncodeReflection(instructions, entry_points, image_accesses_, record);
+                cache->InsertReflection(reflection_key_, std::move(record));
+            }
+        }
+        for (const auto& new_access : image_accesses_) {
+            if (!new_access->variable_image_insn.empty() && new_access->valid_access) {
+                for (const Instruction* image_insn : new_access->variable_image_insn) {
+                    image_access_map_[image_insn->ResultId()].push_back(new_access);
+                }
+            }
+        }
+    });
+}
+
+const ImageAccessMap& Module::StaticData::GetImageAccessMap(const Module& module_state) const {
+    BuildImageAccesses(module_state, {});
+    return image_access_map_;
 }
 
 std::string Module::GetDecorations(uint32_t id) const {
@@ -1355,6 +1730,7 @@ std::shared_ptr<const EntryPoint> Module::FindEntrypoint(char const* name, VkSha
     if (!name) return nullptr;
     for (const auto& entry_point : static_data_.entry_points) {
         if (entry_point->name.compare(name) == 0 && entry_point->stage == stageBits) {
+            entry_point->BuildResourceInterface(*this);
             return entry_point;
         }
     }
@@ -17,14 +17,21 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "state_tracker/shader_instruction.h"
 #include "state_tracker/state_object.h"
 #include "state_tracker/sampler_state.h"
+#include "utils/hash_util.h"
 #include <spirv/unified1/spirv.hpp>
 
 namespace vvl {
@@ -40,6 +47,74 @@ static constexpr uint32_t kInvalidValue = std::numeric_limits<uint32_t>::max();
 // Need to find a way to know if actually array lenght of zero, or a runtime array.
 static constexpr uint32_t kRuntimeArray = std::numeric_limits<uint32_t>::max();
 
+// spirv-val rejects modules with a larger ID bound (the "Result <id> bound" universal limit), dense tables are not sized past it
+static constexpr uint32_t kMaxIdBound = 0x3FFFFF;
+
+// Map from a SPIR-V result ID to a value.
+// IDs are dense and bounded by the module header, so the ID indexes into pages of slots instead of being hashed. Pages are only
+// allocated once an ID in their range is added, so tables that only a few IDs use (execution modes, spec constants) stay small.
+// Values are kept contiguous in insertion order and, like a map, iterate as <ID, value> pairs.
+// References to values are only stable once the table stops growing.
+template <typename T>
+class IdTable {
+  public:
+    using value_type = std::pair<uint32_t, T>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    T &operator[](uint32_t id) {
+        uint32_t &slot = Slot(id);
+        if (slot == kNoSlot) {
+            slot = static_cast<uint32_t>(entries_.size());
+            entries_.emplace_back(id, T{});
+        }
+        return entries_[slot].second;
+    }
+
+    // Returns nullptr if the ID has no value
+    const T *Find(uint32_t id) const {
+        uint32_t slot = kNoSlot;
+        if (id >= kMaxIdBound) {
+            const auto it = overflow_slots_.find(id);
+            if (it != overflow_slots_.end()) slot = it->second;
+        } else if ((id >> kPageBits) < pages_.size() && pages_[id >> kPageBits]) {
+            slot = (*pages_[id >> kPageBits])[id & kPageMask];
+        }
+        return slot == kNoSlot ? nullptr : &entries_[slot].second;
+    }
+
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+  private:
+    static constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t kPageBits = 8;
+    static constexpr uint32_t kPageMask = (1u << kPageBits) - 1;
+    using Page = std::array<uint32_t, 1u << kPageBits>;
+
+    uint32_t &Slot(uint32_t id) {
+        // Only invalid SPIR-V gets here, still handle it without sizing the pages for it
+        if (id >= kMaxIdBound) {
+            return overflow_slots_.emplace(id, kNoSlot).first->second;
+        }
+        const uint32_t page_index = id >> kPageBits;
+        if (page_index >= pages_.size()) {
+            pages_.resize(page_index + 1);
+        }
+        auto &page = pages_[page_index];
+        if (!page) {
+            page = std::make_unique<Page>();
+            page->fill(kNoSlot);
+        }
+        return (*page)[id & kPageMask];
+    }
+
+    std::vector<std::unique_ptr<Page>> pages_;
+    std::vector<value_type> entries_;
+    vvl::unordered_map<uint32_t, uint32_t> overflow_slots_;
+};
+
 // This is the common info for both OpDecorate and OpMemberDecorate
 // Used to keep track of all decorations applied to any instruction
 struct DecorationBase {
@@ -241,6 +316,8 @@ struct ImageAccess {
     uint32_t texel_component_count = kInvalidValue;
 
     ImageAccess(const Module &module_state, const Instruction &image_insn, const FuncParameterMap &func_parameter_map);
+    // Fields are filled in from a persisted reflection record
+    explicit ImageAccess(const Instruction &image_insn) : image_insn(image_insn) {}
 };
 
 // <Image OpVariable Result ID, [ImageAccess, ImageAccess, etc] > - used for faster lookup
@@ -481,6 +558,12 @@ struct PushConstantVariable : public VariableBase {
                          const VariableAccessMap &variable_access_map, const DebugNameMap &debug_name_map);
 };
 
+// Per EntryPoint analysis that can be restored from a persisted reflection record instead of walking the call tree
+struct EntryPointReflection {
+    bool emit_vertex_geometry = false;
+    vvl::unordered_set<uint32_t> accessible_ids;
+};
+
 // Represents a single Entrypoint into a Shader Module
 struct EntryPoint {
     // "A module must not have two OpEntryPoint instructions with the same Execution Model and the same Name string."
@@ -492,6 +575,8 @@ struct EntryPoint {
     const uint32_t id;
     const std::string name;
     const ExecutionModeSet &execution_mode;
+    // Never reused by another EntryPoint, so results about an entry point can be remembered without keeping it alive
+    const uint64_t unique_id;
 
     // Values found while gather the Accessible Ids
     bool emit_vertex_geometry;
@@ -500,9 +585,11 @@ struct EntryPoint {
     // being accessed doesn't guarantee it is statically used
     const vvl::unordered_set<uint32_t> accessible_ids;
 
+    // The resource interface (and push constant block) is only built once the EntryPoint is looked up with
+    // Module::FindEntrypoint, most modules are never used from more than a few of their entry points.
     // only one Push Constant block is allowed per entry point
     std::shared_ptr<const PushConstantVariable> push_constant_variable;
-    const std::vector<ResourceInterfaceVariable> resource_interface_variables;
+    std::vector<ResourceInterfaceVariable> resource_interface_variables;
     const std::vector<StageInterfaceVariable> stage_interface_variables;
     // Easier to lookup without having to check for the is_builtin bool
     // "Built-in interface variables" - vkspec.html#interfaces-iointerfaces-builtin
@@ -532,13 +619,19 @@ struct EntryPoint {
     bool has_passthrough{false};
     bool has_alpha_to_coverage_variable{false};  // only for Fragment shaders
 
-    EntryPoint(const Module &module_state, const Instruction &entrypoint_insn, const ImageAccessMap &image_access_map,
-               const AccessChainVariableMap &access_chain_map, const VariableAccessMap &variable_access_map,
-               const DebugNameMap &debug_name_map);
+    EntryPoint(const Module &module_state, const Instruction &entrypoint_insn, const AccessChainVariableMap &access_chain_map,
+               const VariableAccessMap &variable_access_map, const DebugNameMap &debug_name_map,
+               EntryPointReflection *reflection = nullptr);
 
     bool HasBuiltIn(spv::BuiltIn built_in) const;
 
+    // Thread safe, only the first call does any work
+    void BuildResourceInterface(const Module &module_state);
+
   protected:
+    std::once_flag resource_interface_once_;
+    static std::atomic<uint64_t> next_unique_id;
+
     static vvl::unordered_set<uint32_t> GetAccessibleIds(const Module &module_state, EntryPoint &entrypoint);
     static std::vector<StageInterfaceVariable> GetStageInterfaceVariables(const Module &module_state, const EntryPoint &entrypoint,
                                                                           const VariableAccessMap &variable_access_map,
@@ -574,6 +667,8 @@ struct StatelessData {
     bool has_group_decoration{false};
 };
 
+class StaticDataCache;
+
 // Represents a SPIR-V Module
 // This holds the SPIR-V source and parse it
 struct Module {
@@ -581,27 +676,36 @@ struct Module {
     // The goal of this struct is to move everything that is ready only into here
     struct StaticData {
         StaticData() = default;
-        StaticData(const Module &module_state, StatelessData *stateless_data = nullptr);
-        StaticData &operator=(StaticData &&) = default;
-        StaticData(StaticData &&) = default;
+        StaticData &operator=(const StaticData &) = delete;
+        StaticData(const StaticData &) = delete;
+
+        // Parses the module, it uses the Module (which is already pointing at this StaticData) as it builds itself up.
+        // If persisted_reflection is a valid record for this module, the expensive analysis is restored from it instead of
+        // being recomputed. Returns if it was.
+        bool Build(const Module &module_state, StatelessData *stateless_data,
+                   const std::vector<uint32_t> *persisted_reflection = nullptr);
+        // Must be called before the StaticData is shared. The first time the image accesses are walked, the analysis is
+        // encoded into a reflection record for the cache (if it is still around), nothing is encoded for modules never used.
+        void RecordReflectionTo(const std::weak_ptr<StaticDataCache> &cache, const hash_util::Hash128 &key);
 
         // List of all instructions in the order they appear in the binary
         std::vector<Instruction> instructions;
         // Instructions that can be referenced by Ids
         // A mapping of <id> to the first word of its def. this is useful because walking type
         // trees, constant expressions, etc requires jumping all over the instruction stream.
-        vvl::unordered_map<uint32_t, const Instruction *> definitions;
+        // Nearly every ID has a definition, so this is indexed directly by the ID (nullptr if there is none)
+        std::vector<const Instruction *> definitions;
 
-        vvl::unordered_map<uint32_t, DecorationSet> decorations;
+        IdTable<DecorationSet> decorations;
         DecorationSet empty_decoration;  // all zero values, allows use to return a reference and not a copy each time
 
         // Execution Modes are tied to a Function <id>, multiple EntryPoints can point to the same Funciton <id>
         // Keep a mapping so each EntryPoint can grab a reference to it
-        vvl::unordered_map<uint32_t, ExecutionModeSet> execution_modes;
+        IdTable<ExecutionModeSet> execution_modes;
         ExecutionModeSet empty_execution_mode;  // all zero values, allows use to return a reference and not a copy each time
 
         // [OpSpecConstant Result ID -> OpDecorate SpecID value] mapping
-        vvl::unordered_map<uint32_t, uint32_t> id_to_spec_id;
+        IdTable<uint32_t> id_to_spec_id;
         // Find all decoration instructions to prevent relooping module later - many checks need this info
         std::vector<const Instruction *> decoration_inst;
         std::vector<const Instruction *> member_decoration_inst;
@@ -632,11 +736,32 @@ struct Module {
 
         std::vector<std::shared_ptr<TypeStructInfo>> type_structs;  // All OpTypeStruct objects
         // <OpTypeStruct ID, info> - used for faster lookup as there can many structs
-        vvl::unordered_map<uint32_t, std::shared_ptr<const TypeStructInfo>> type_struct_map;
+        IdTable<std::shared_ptr<const TypeStructInfo>> type_struct_map;
 
         // Tracks accesses (load, store, atomic) to the instruction calling them
         // Example: the OpLoad does the "access" but need to know if a OpImageRead uses that OpLoad later
         vvl::unordered_map<const Instruction *, uint32_t> image_write_load_id_map;  // <OpImageWrite, load id>
+
+        // Found while parsing and kept to build the on demand parts of the reflection later
+        AccessChainVariableMap access_chain_map;
+        VariableAccessMap variable_access_map;
+        DebugNameMap debug_name_map;
+        FuncParameterMap func_parameter_map;
+        std::vector<const Instruction *> image_instructions;
+
+        // The ImageAccess dataflow of the whole module, it is only walked the first time a resource interface needs it.
+        // Any Module made from these words can be passed in, they all share this StaticData.
+        const ImageAccessMap &GetImageAccessMap(const Module &module_state) const;
+
+      private:
+        void BuildImageAccesses(const Module &module_state, std::vector<std::shared_ptr<ImageAccess>> &&restored_accesses) const;
+
+        mutable std::once_flag image_access_once_;
+        mutable std::vector<std::shared_ptr<ImageAccess>> image_accesses_;
+        mutable ImageAccessMap image_access_map_;
+
+        std::weak_ptr<StaticDataCache> reflection_cache_;
+        hash_util::Hash128 reflection_key_;
     };
 
     // VK_KHR_maintenance5 allows VkShaderModuleCreateInfo (the SPIR-V binary) to be passed at pipeline creation time, because the
@@ -647,45 +772,51 @@ struct Module {
     // This is the SPIR-V module data content
     const std::vector<uint32_t> words_;
 
-    const StaticData static_data_;
+  private:
+    // Set when static_data_storage_ came from a StaticDataCache and is already built
+    bool static_data_shared_ = false;
+    // Hash of words_, only computed when a StaticDataCache is used
+    hash_util::Hash128 cache_key_;
+    // Can be shared with every other Module created from the same words, never modified once built
+    std::shared_ptr<StaticData> static_data_storage_;
+    std::shared_ptr<StaticData> AcquireStaticData(StaticDataCache *cache, StatelessData *stateless_data);
+
+  public:
+    const StaticData &static_data_;
 
     // Hold a handle so error message can know where the SPIR-V was from (VkShaderModule or VkShaderEXT)
     VulkanTypedHandle handle_;                            // Will be updated once its known its valid SPIR-V
     VulkanTypedHandle handle() const { return handle_; }  // matches normal convention to get handle
 
     // Used for when modifying the SPIR-V (spirv-opt, GPU-AV instrumentation, etc) and need reparse it for VVL validation
-    Module(vvl::span<const uint32_t> code) : valid_spirv(true), words_(code.begin(), code.end()), static_data_(*this) {}
+    Module(vvl::span<const uint32_t> code);
 
     // StatelessData is a pointer as we have cases were we don't need it and simpler to just null check the few cases that use it
-    Module(size_t codeSize, const uint32_t *pCode, StatelessData *stateless_data = nullptr)
-        : valid_spirv(pCode && pCode[0] == spv::MagicNumber && ((codeSize % 4) == 0)),
-          words_(pCode, pCode + codeSize / sizeof(uint32_t)),
-          static_data_(*this, stateless_data) {}
+    // When a cache is given, the parsed StaticData is shared with any other live Module created from the same words
+    Module(size_t codeSize, const uint32_t *pCode, StatelessData *stateless_data = nullptr, StaticDataCache *cache = nullptr);
 
     const Instruction *FindDef(uint32_t id) const {
-        auto it = static_data_.definitions.find(id);
-        if (it == static_data_.definitions.end()) return nullptr;
-        return it->second;
+        return id < static_data_.definitions.size() ? static_data_.definitions[id] : nullptr;
     }
 
     const std::vector<Instruction> &GetInstructions() const { return static_data_.instructions; }
 
     const DecorationSet &GetDecorationSet(uint32_t id) const {
         // return the actual decorations for this id, or a default empty set.
-        const auto it = static_data_.decorations.find(id);
-        return (it != static_data_.decorations.end()) ? it->second : static_data_.empty_decoration;
+        const DecorationSet *decoration_set = static_data_.decorations.Find(id);
+        return decoration_set ? *decoration_set : static_data_.empty_decoration;
     }
 
     const ExecutionModeSet &GetExecutionModeSet(uint32_t function_id) const {
         // return the actual execution modes for this id, or a default empty set.
-        const auto it = static_data_.execution_modes.find(function_id);
-        return (it != static_data_.execution_modes.end()) ? it->second : static_data_.empty_execution_mode;
+        const ExecutionModeSet *execution_mode_set = static_data_.execution_modes.Find(function_id);
+        return execution_mode_set ? *execution_mode_set : static_data_.empty_execution_mode;
     }
 
     std::shared_ptr<const TypeStructInfo> GetTypeStructInfo(uint32_t struct_id) const {
         // return the actual execution modes for this id, or a default empty set.
-        const auto it = static_data_.type_struct_map.find(struct_id);
-        return (it != static_data_.type_struct_map.end()) ? it->second : nullptr;
+        const auto *type_struct_info = static_data_.type_struct_map.Find(struct_id);
+        return type_struct_info ? *type_struct_info : nullptr;
     }
     // Overload to walk down and find the OpTypeStruct
     std::shared_ptr<const TypeStructInfo> GetTypeStructInfo(const Instruction *insn) const {
@@ -745,6 +876,48 @@ struct Module {
     }
 };
 
+// Device level cache so Modules created from identical SPIR-V (e.g. the same VkShaderModuleCreateInfo chained into many
+// pipelines) are only parsed once. Only weak references are held, the StaticData goes away with the last Module using it.
+//
+// It can also persist the expensive part of the reflection (the call tree walk of each EntryPoint and the ImageAccess
+// dataflow) to disk, so the next run of the application doesn't have to recompute it for SPIR-V it has seen before.
+class StaticDataCache : public std::enable_shared_from_this<StaticDataCache> {
+  public:
+    // On a hit, also fills stateless_data with what was found while parsing (minus pipeline_pnext_module)
+    std::shared_ptr<Module::StaticData> Find(const hash_util::Hash128 &key, StatelessData &stateless_data);
+    void Insert(const hash_util::Hash128 &key, const std::shared_ptr<Module::StaticData> &static_data,
+                const StatelessData &stateless_data);
+
+    // Reflection records are only kept once LoadReflection() was called (even if the file didn't exist yet)
+    bool PersistsReflection() const { return persist_reflection_; }
+    std::shared_ptr<const std::vector<uint32_t>> FindReflection(const hash_util::Hash128 &key);
+    void InsertReflection(const hash_util::Hash128 &key, std::vector<uint32_t> &&record);
+    void LoadReflection(const std::string &path);
+    bool SaveReflection(const std::string &path);
+
+  private:
+    struct Entry {
+        std::weak_ptr<Module::StaticData> static_data;
+        // The Instruction pointers inside point into static_data, only used while it is alive
+        StatelessData stateless_data;
+    };
+
+    std::mutex lock_;
+    vvl::unordered_map<hash_util::Hash128, Entry, hash_util::Hash128::Hasher> entries_;
+    // Expired entries are swept when the map grows to this size
+    size_t sweep_size_ = 64;
+
+    // Upper bound of records written back, the ones not used by this run are evicted first
+    static constexpr size_t kMaxReflectionRecords = 4096;
+    struct ReflectionRecord {
+        std::shared_ptr<const std::vector<uint32_t>> words;
+        bool used = false;  // looked up or inserted during this run
+    };
+    bool persist_reflection_ = false;
+    bool reflection_dirty_ = false;
+    vvl::unordered_map<hash_util::Hash128, ReflectionRecord, hash_util::Hash128::Hasher> reflection_records_;
+};
+
 }  // namespace spirv
 
 // Represents a VkShaderModule handle
@@ -43,6 +43,8 @@ struct ShaderObject : public StateObject {
     // are updated at various times. Locking requirements are TBD.
     const ActiveSlotMap active_slots;
     const uint32_t max_active_slot = 0;  // the highest set number in active_slots for pipeline layout compatibility checks
+    // active_slots flattened for draw time validation
+    const DescriptorRequirementTable descriptor_requirements;
 
     using SetLayoutVector = std::vector<std::shared_ptr<vvl::DescriptorSetLayout const>>;
     const SetLayoutVector set_layouts;
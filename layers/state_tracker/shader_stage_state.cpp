@@ -18,6 +18,8 @@
 
 #include "shader_stage_state.h"
 
+#include <algorithm>
+
 #include "state_tracker/shader_module.h"
 #include <vulkan/utility/vk_safe_struct.hpp>
 
@@ -50,6 +52,35 @@ ActiveSlotMap GetActiveSlots(const std::shared_ptr<const spirv::EntryPoint> &ent
     return active_slots;
 }
 
+DescriptorRequirementTable GetDescriptorRequirementTable(const ActiveSlotMap &active_slots) {
+    DescriptorRequirementTable table;
+    table.sets.reserve(active_slots.size());
+    for (const auto &set_binding_pair : active_slots) {
+        table.sets.emplace_back(DescriptorRequirementTable::Set{set_binding_pair.first, 0, 0});
+    }
+    std::sort(table.sets.begin(), table.sets.end(),
+              [](const DescriptorRequirementTable::Set &a, const DescriptorRequirementTable::Set &b) { return a.set < b.set; });
+
+    for (auto &set : table.sets) {
+        const BindingVariableMap &binding_req_map = active_slots.at(set.set);
+        set.first_binding = static_cast<uint32_t>(table.bindings.size());
+        set.binding_count = static_cast<uint32_t>(binding_req_map.size());
+        for (const auto &binding_req_pair : binding_req_map) {
+            DescriptorRequirementTable::Binding binding;
+            binding.info.first = binding_req_pair.first;
+            binding.info.second.emplace_back(binding_req_pair.second);
+            binding.is_dynamic_accessed = binding_req_pair.second.variable->is_dynamic_accessed;
+            table.bindings.emplace_back(std::move(binding));
+        }
+        const auto begin = table.bindings.begin() + set.first_binding;
+        std::stable_sort(begin, table.bindings.end(),
+                         [](const DescriptorRequirementTable::Binding &a, const DescriptorRequirementTable::Binding &b) {
+                             return a.info.first < b.info.first;
+                         });
+    }
+    return table;
+}
+
 uint32_t GetMaxActiveSlot(const ActiveSlotMap &active_slots) {
     uint32_t max_active_slot = 0;
     for (const auto &entry : active_slots) {
@@ -86,10 +117,10 @@ bool ShaderStageState::GetInt32ConstantValue(const spirv::Instruction &insn, uin
     } else if (insn.Opcode() == spv::OpSpecConstant) {
         *value = insn.Word(3);  // default value
         const auto *spec_info = GetSpecializationInfo();
-        const uint32_t spec_id = spirv_state->static_data_.id_to_spec_id.at(insn.Word(2));
-        if (spec_info && spec_id < spec_info->mapEntryCount) {
-            memcpy(value, (uint8_t *)spec_info->pData + spec_info->pMapEntries[spec_id].offset,
-                   spec_info->pMapEntries[spec_id].size);
+        const uint32_t *spec_id = spirv_state->static_data_.id_to_spec_id.Find(insn.Word(2));
+        if (spec_info && spec_id && *spec_id < spec_info->mapEntryCount) {
+            memcpy(value, (uint8_t *)spec_info->pData + spec_info->pMapEntries[*spec_id].offset,
+                   spec_info->pMapEntries[*spec_id].size);
         }
         return true;
     }
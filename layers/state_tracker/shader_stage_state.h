@@ -82,6 +82,34 @@ typedef std::unordered_multimap<uint32_t, DescriptorRequirement> BindingVariable
 // Capture which slots (set#->bindings) are actually used by the shaders of this pipeline
 using ActiveSlotMap = vvl::unordered_map<uint32_t, BindingVariableMap>;
 
+// Flattened copy of an ActiveSlotMap, built once when the pipeline or shader object is created.
+// Draw time validation walks these contiguous arrays instead of iterating the nested hash maps (and building a requirement
+// vector per binding) on every draw.
+struct DescriptorRequirementTable {
+    struct Binding {
+        // < binding index : requirement >, already in the form DescriptorValidator::ValidateBinding() takes.
+        // There is one entry per variable, so a binding used by several variables/stages shows up more than once.
+        std::pair<uint32_t, std::vector<DescriptorRequirement>> info;
+        // Core validation can't validate dynamically accessed descriptors, those are left to GPU-AV
+        bool is_dynamic_accessed;
+    };
+    struct Set {
+        uint32_t set;
+        uint32_t first_binding;  // index into bindings
+        uint32_t binding_count;
+    };
+
+    std::vector<Set> sets;          // sorted by set number
+    std::vector<Binding> bindings;  // grouped by set, sorted by binding number
+
+    vvl::span<const Binding> SetBindings(const Set &set) const {
+        return vvl::make_span(bindings.data() + set.first_binding, set.binding_count);
+    }
+    bool empty() const { return sets.empty(); }
+};
+
+DescriptorRequirementTable GetDescriptorRequirementTable(const ActiveSlotMap &active_slots);
+
 void GetActiveSlots(ActiveSlotMap &active_slots, const std::shared_ptr<const spirv::EntryPoint> &entrypoint);
 ActiveSlotMap GetActiveSlots(const std::vector<ShaderStageState> &stage_states);
 ActiveSlotMap GetActiveSlots(const std::shared_ptr<const spirv::EntryPoint> &entrypoint);
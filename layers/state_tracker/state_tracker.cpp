@@ -391,6 +391,7 @@ void ValidationStateTracker::PostCallRecordCreateBuffer(VkDevice device, const V
 
             BufferAddressInfillUpdateOps ops{{buffer_state.get()}};
             sparse_container::infill_update_range(buffer_address_map_, address_range, ops);
+            buffer_device_address_ranges_version++;
         }
 
         const VkBufferUsageFlags descriptor_buffer_usages =
@@ -558,6 +559,7 @@ void ValidationStateTracker::PreCallRecordDestroyBuffer(VkDevice device, VkBuffe
 
                 return false;
             });
+            buffer_device_address_ranges_version++;
         }
     }
     Destroy<vvl::Buffer>(buffer);
@@ -711,6 +713,7 @@ std::shared_ptr<vvl::Queue> ValidationStateTracker::CreateQueue(VkQueue handle,
 
 void ValidationStateTracker::PostCreateDevice(const VkDeviceCreateInfo *pCreateInfo, const Location &loc) {
     GetEnabledDeviceFeatures(pCreateInfo, &enabled_features, api_version);
+    spirv_static_data_cache = std::make_shared<spirv::StaticDataCache>();
 
     const auto *device_group_ci = vku::FindStructInPNextChain<VkDeviceGroupDeviceCreateInfo>(pCreateInfo->pNext);
     if (device_group_ci) {
@@ -2926,20 +2929,18 @@ void ValidationStateTracker::PostCallRecordCmdPushConstants(VkCommandBuffer comm
     auto layout_state = Get<vvl::PipelineLayout>(layout);
     cb_state->ResetPushConstantRangesLayoutIfIncompatible(*layout_state);
 
-    vvl::CommandBuffer::PushConstantData push_constant_data;
-    push_constant_data.layout = layout;
-    push_constant_data.stage_flags = stageFlags;
-    push_constant_data.offset = offset;
-    push_constant_data.values.resize(size);
-    auto byte_values = static_cast<const std::byte *>(pValues);
-    std::copy(byte_values, byte_values + size, push_constant_data.values.data());
     // Always add submitted push constant values, even if the same data is already stored.
     // Storing duplicated data, or data submitted by one vkCmdPushConstants call
     // and overridden by a subsequent one is not a problem.
     // push_constant_data_chunks is intended to be parsed from 0 to N,
     // thus going through the history in order, so even though it is
     // possibly suboptimal push constant data is correct.
-    cb_state->push_constant_data_chunks.emplace_back(push_constant_data);
+    vvl::CommandBuffer::PushConstantData &push_constant_data = cb_state->AddPushConstantData();
+    push_constant_data.layout = layout;
+    push_constant_data.stage_flags = stageFlags;
+    push_constant_data.offset = offset;
+    auto byte_values = static_cast<const std::byte *>(pValues);
+    push_constant_data.values.assign(byte_values, byte_values + size);
 }
 
 void ValidationStateTracker::PostCallRecordCmdPushConstants2KHR(VkCommandBuffer commandBuffer,
@@ -4328,7 +4329,12 @@ void ValidationStateTracker::PostCallRecordCreateDescriptorUpdateTemplate(VkDevi
                                                                           VkDescriptorUpdateTemplate *pDescriptorUpdateTemplate,
                                                                           const RecordObject &record_obj) {
     if (VK_SUCCESS != record_obj.result) return;
-    Add(std::make_shared<vvl::DescriptorUpdateTemplate>(*pDescriptorUpdateTemplate, pCreateInfo));
+    // descriptorSetLayout is ignored for push descriptor templates
+    std::shared_ptr<const vvl::DescriptorSetLayout> layout_state;
+    if (pCreateInfo->templateType == VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET) {
+        layout_state = Get<vvl::DescriptorSetLayout>(pCreateInfo->descriptorSetLayout);
+    }
+    Add(std::make_shared<vvl::DescriptorUpdateTemplate>(*pDescriptorUpdateTemplate, pCreateInfo, layout_state.get()));
 }
 
 void ValidationStateTracker::PostCallRecordCreateDescriptorUpdateTemplateKHR(
@@ -4826,8 +4832,8 @@ void ValidationStateTracker::PreCallRecordCreateShaderModule(VkDevice device, co
         return;
     }
 
-    chassis_state.module_state =
-        std::make_shared<spirv::Module>(pCreateInfo->codeSize, pCreateInfo->pCode, &chassis_state.stateless_data);
+    chassis_state.module_state = std::make_shared<spirv::Module>(pCreateInfo->codeSize, pCreateInfo->pCode,
+                                                                 &chassis_state.stateless_data, spirv_static_data_cache.get());
     if (chassis_state.module_state && chassis_state.stateless_data.has_group_decoration) {
         spv_target_env spirv_environment = PickSpirvEnv(api_version, IsExtEnabled(device_extensions.vk_khr_spirv_1_4));
         spvtools::Optimizer optimizer(spirv_environment);
@@ -4841,8 +4847,9 @@ void ValidationStateTracker::PreCallRecordCreateShaderModule(VkDevice device, co
             // Easier to just re-create the ShaderModule as StaticData uses itself when building itself up
             // It is really rare this will get here as Group Decorations have been deprecated and before this was added no one ever
             // raised an issue for a bug that would crash the layers that was around for many releases
-            chassis_state.module_state = std::make_shared<spirv::Module>(optimized_binary.size() * sizeof(uint32_t),
-                                                                         optimized_binary.data(), &chassis_state.stateless_data);
+            chassis_state.module_state =
+                std::make_shared<spirv::Module>(optimized_binary.size() * sizeof(uint32_t), optimized_binary.data(),
+                                                &chassis_state.stateless_data, spirv_static_data_cache.get());
         }
     }
 }
@@ -4857,8 +4864,9 @@ void ValidationStateTracker::PreCallRecordCreateShadersEXT(VkDevice device, uint
         }
         // don't need to worry about GroupDecoration with VK_EXT_shader_object
         if (pCreateInfos[i].codeType == VK_SHADER_CODE_TYPE_SPIRV_EXT) {
-            chassis_state.module_states[i] = std::make_shared<spirv::Module>(
-                pCreateInfos[i].codeSize, static_cast<const uint32_t *>(pCreateInfos[i].pCode), &chassis_state.stateless_data[i]);
+            chassis_state.module_states[i] =
+                std::make_shared<spirv::Module>(pCreateInfos[i].codeSize, static_cast<const uint32_t *>(pCreateInfos[i].pCode),
+                                                &chassis_state.stateless_data[i], spirv_static_data_cache.get());
         }
     }
 }
@@ -79,6 +79,7 @@ struct CreateShaderModule;
 
 namespace spirv {
 struct StatelessData;
+class StaticDataCache;
 }  // namespace spirv
 
 #define VALSTATETRACK_MAP_AND_TRAITS_IMPL(handle_type, state_type, map_member, instance_scope)        \
@@ -422,19 +423,16 @@ class ValidationStateTracker : public ValidationObject {
         return found_it->second;
     }
 
-    // Return a count pair, {written addresses count, total address ranges count}
+    // Copies every address range, returns the buffer_device_address_ranges_version they were taken at
     using BufferAddressRange = sparse_container::range<VkDeviceAddress>;
-    [[nodiscard]] std::pair<size_t, size_t> GetBufferAddressRanges(BufferAddressRange* ranges, size_t ranges_size) const {
+    uint32_t GetBufferAddressRanges(std::vector<BufferAddressRange>& ranges) const {
         ReadLockGuard guard(buffer_address_lock_);
-
-        size_t written_count = 0;
+        ranges.clear();
+        ranges.reserve(buffer_address_map_.size());
         for (const auto& [address_range, buffers] : buffer_address_map_) {
-            if (written_count == ranges_size) {
-                break;
-            }
-            ranges[written_count++] = address_range;
+            ranges.emplace_back(address_range);
         }
-        return {written_count, buffer_address_map_.size()};
+        return buffer_device_address_ranges_version;
     }
 
     using SetImageViewInitialLayoutCallback = std::function<void(vvl::CommandBuffer*, const vvl::ImageView&, VkImageLayout)>;
@@ -1874,9 +1872,12 @@ class ValidationStateTracker : public ValidationObject {
     std::vector<QueueFamilyExtensionProperties> queue_family_ext_props;
 
     bool performance_lock_acquired = false;
-    uint32_t buffer_device_address_ranges_version = 0;
+    // Bumped whenever buffer_address_map_ changes, can be read without buffer_address_lock_ to know if ranges are stale
+    std::atomic<uint32_t> buffer_device_address_ranges_version = 0;
 
     mutable vvl::VideoProfileDesc::Cache video_profile_cache_;
+    // Lets identical SPIR-V share one parsed spirv::Module::StaticData, created with the device
+    std::shared_ptr<spirv::StaticDataCache> spirv_static_data_cache;
 
     using BufferAddressMapStore = small_vector<vvl::Buffer*, 1, size_t>;
     using BufferAddressRangeMap = sparse_container::range_map<VkDeviceAddress, BufferAddressMapStore>;
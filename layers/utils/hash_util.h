@@ -161,6 +161,25 @@ uint32_t VuidHash(std::string_view vuid);
 
 uint32_t ShaderHash(const void *pCode, const size_t codeSize);
 
+// Wide enough to be used as the identity of the hashed content (collisions are not a practical concern)
+struct Hash128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const Hash128 &other) const { return low == other.low && high == other.high; }
+    bool operator!=(const Hash128 &other) const { return !(*this == other); }
+
+    struct Hasher {
+        size_t operator()(const Hash128 &hash) const { return static_cast<size_t>(hash.low ^ hash.high); }
+    };
+};
+
+// A seed of zero gives the plain XXH3 128-bit hash
+Hash128 ShaderHash128(const void *pCode, const size_t codeSize, uint64_t seed = 0);
+
+// A seed of zero gives the plain XXH3 64-bit hash
+uint64_t ShaderHash64(const void *pCode, const size_t codeSize, uint64_t seed = 0);
+
 uint64_t DescriptorVariableHash(const void *info, const size_t info_size);
 
 }  // namespace hash_util
@@ -19,11 +19,42 @@
 
 #include "shader_utils.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#if defined(VVL_VALIDATION_CACHE_MMAP)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+#include "containers/custom_containers.h"
 #include "generated/device_features.h"
 #include "utils/hash_util.h"
 
 #include "generated/spirv_tools_commit_id.h"
 
+ValidationCache::ValidationCache(uint32_t spirv_val_option_hash) {
+    const char *commit_id = SPIRV_TOOLS_COMMIT_ID;
+    key_seed_ = (uint64_t(hash_util::ShaderHash(commit_id, std::strlen(commit_id))) << 32) | spirv_val_option_hash;
+
+    tables_.emplace_back(std::make_unique<Table>(kInitialCapacity));
+    table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+ValidationCache::~ValidationCache() {
+#if defined(VVL_VALIDATION_CACHE_MMAP)
+    if (file_fd_ >= 0) {
+        close(file_fd_);
+    }
+#endif
+}
+
 void ValidationCache::GetUUID(uint8_t *uuid) {
     const char *sha1_str = SPIRV_TOOLS_COMMIT_ID;
     // Convert sha1_str from a hex string to binary. We only need VK_UUID_SIZE bytes of
@@ -43,56 +74,145 @@ void ValidationCache::GetUUID(uint8_t *uuid) {
         uuid[i] = static_cast<uint8_t>(std::strtoul(byte_str, nullptr, 16));
     }
 
-    // Replace the last 4 bytes (likely padded with zero anyway)
-    std::memcpy(uuid + (VK_UUID_SIZE - sizeof(uint32_t)), &spirv_val_option_hash_, sizeof(uint32_t));
+    // Replace the last 4 bytes (likely padded with zero anyway) with the layout of the data.
+    // The spirv-val options are part of every key, so they don't need to match to use the data.
+    std::memcpy(uuid + (VK_UUID_SIZE - sizeof(uint32_t)), &kFormatVersion, sizeof(uint32_t));
 }
 
-void ValidationCache::Load(VkValidationCacheCreateInfoEXT const *pCreateInfo) {
-    const auto headerSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
-    auto size = headerSize;
-    if (!pCreateInfo->pInitialData || pCreateInfo->initialDataSize < size) return;
-
-    uint32_t const *data = (uint32_t const *)pCreateInfo->pInitialData;
-    if (data[0] != size) return;
-    if (data[1] != VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT) return;
+bool ValidationCache::IsValidHeader(const uint8_t *data, size_t size) {
+    if (size < kHeaderSize) return false;
+    uint32_t header[2];
+    std::memcpy(header, data, sizeof(header));
+    if (header[0] != kHeaderSize) return false;
+    if (header[1] != VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT) return false;
     uint8_t expected_uuid[VK_UUID_SIZE];
     GetUUID(expected_uuid);
-    if (memcmp(&data[2], expected_uuid, VK_UUID_SIZE) != 0) return;  // different version
+    return memcmp(data + sizeof(header), expected_uuid, VK_UUID_SIZE) == 0;  // different version if not
+}
+
+void ValidationCache::WriteHeader(uint8_t *out) {
+    // 4 bytes for header size + 4 bytes for version number + UUID
+    const uint32_t header[2] = {static_cast<uint32_t>(kHeaderSize), VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT};
+    std::memcpy(out, header, sizeof(header));
+    GetUUID(out + sizeof(header));
+}
+
+ValidationCache::Key ValidationCache::MakeKey(const void *code, size_t code_size) const {
+    Key key = hash_util::ShaderHash128(code, code_size, key_seed_);
+    key.low |= 1;  // zero marks an empty slot
+    return key;
+}
+
+bool ValidationCache::Contains(const Key &key) const {
+    const Table *table = table_.load(std::memory_order_acquire);
+    for (size_t i = key.low & table->mask;; i = (i + 1) & table->mask) {
+        const Slot &slot = table->slots[i];
+        const uint64_t low = slot.low.load(std::memory_order_acquire);
+        if (low == 0) {
+            return false;
+        }
+        if (low == key.low && slot.high.load(std::memory_order_relaxed) == key.high) {
+            return true;
+        }
+    }
+}
+
+void ValidationCache::Insert(const Key &key) {
+    std::vector<Key> to_append;
+    {
+        std::lock_guard<std::mutex> guard(insert_lock_);
+        if (!InsertLocked(key) || file_path_.empty()) {
+            return;
+        }
+        file_pending_.emplace_back(key);
+        if (file_pending_.size() < kFileFlushBatch) {
+            return;
+        }
+        to_append.swap(file_pending_);
+    }
+    AppendToFile(to_append);
+}
 
-    data = (uint32_t const *)(reinterpret_cast<uint8_t const *>(data) + headerSize);
+bool ValidationCache::InsertLocked(const Key &key) {
+    if (Contains(key)) {
+        return false;
+    }
 
-    auto guard = WriteLock();
-    for (; size < pCreateInfo->initialDataSize; data++, size += sizeof(uint32_t)) {
-        good_shader_hashes_.insert(*data);
+    // Keep the load factor at or under 1/2 so probe sequences stay short
+    Table *table = table_.load(std::memory_order_relaxed);
+    const size_t count = count_.load(std::memory_order_relaxed) + 1;
+    if (count * 2 > table->mask + 1) {
+        auto &grown = tables_.emplace_back(std::make_unique<Table>((table->mask + 1) * 2));
+        for (size_t i = 0; i <= table->mask; ++i) {
+            const Slot &slot = table->slots[i];
+            const uint64_t low = slot.low.load(std::memory_order_relaxed);
+            if (low != 0) {
+                StoreLocked(*grown, Key{low, slot.high.load(std::memory_order_relaxed)});
+            }
+        }
+        table = grown.get();
+        table_.store(table, std::memory_order_release);
     }
+
+    StoreLocked(*table, key);
+    count_.store(count, std::memory_order_relaxed);
+    return true;
+}
+
+void ValidationCache::StoreLocked(Table &table, const Key &key) {
+    size_t i = key.low & table.mask;
+    while (table.slots[i].low.load(std::memory_order_relaxed) != 0) {
+        i = (i + 1) & table.mask;
+    }
+    // Readers find the slot through low, so high has to be visible first
+    table.slots[i].high.store(key.high, std::memory_order_relaxed);
+    table.slots[i].low.store(key.low, std::memory_order_release);
+}
+
+void ValidationCache::LoadRecordsLocked(const uint8_t *records, size_t size) {
+    for (size_t offset = 0; offset + kRecordSize <= size; offset += kRecordSize) {
+        Key key;
+        std::memcpy(&key.low, records + offset, sizeof(uint64_t));
+        std::memcpy(&key.high, records + offset + sizeof(uint64_t), sizeof(uint64_t));
+        if (key.low & 1) {  // anything else is not a key this cache made
+            InsertLocked(key);
+        }
+    }
+}
+
+void ValidationCache::Load(VkValidationCacheCreateInfoEXT const *pCreateInfo) {
+    if (!pCreateInfo->pInitialData) return;
+    const uint8_t *data = static_cast<const uint8_t *>(pCreateInfo->pInitialData);
+    if (!IsValidHeader(data, pCreateInfo->initialDataSize)) return;
+
+    std::lock_guard<std::mutex> guard(insert_lock_);
+    LoadRecordsLocked(data + kHeaderSize, pCreateInfo->initialDataSize - kHeaderSize);
 }
 
 void ValidationCache::Write(size_t *pDataSize, void *pData) {
-    const auto header_size = 2 * sizeof(uint32_t) + VK_UUID_SIZE;  // 4 bytes for header size + 4 bytes for version number + UUID
     if (!pData) {
-        *pDataSize = header_size + good_shader_hashes_.size() * sizeof(uint32_t);
+        *pDataSize = kHeaderSize + count_.load(std::memory_order_acquire) * kRecordSize;
         return;
     }
 
-    if (*pDataSize < header_size) {
+    if (*pDataSize < kHeaderSize) {
         *pDataSize = 0;
         return;  // Too small for even the header!
     }
 
-    uint32_t *out = (uint32_t *)pData;
-    size_t actual_size = header_size;
+    uint8_t *out = static_cast<uint8_t *>(pData);
+    WriteHeader(out);
+    size_t actual_size = kHeaderSize;
 
-    // Write the header
-    *out++ = header_size;
-    *out++ = VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT;
-    GetUUID(reinterpret_cast<uint8_t *>(out));
-    out = (uint32_t *)(reinterpret_cast<uint8_t *>(out) + VK_UUID_SIZE);
-
-    {
-        auto guard = ReadLock();
-        for (auto it = good_shader_hashes_.begin(); it != good_shader_hashes_.end() && actual_size < *pDataSize;
-             it++, out++, actual_size += sizeof(uint32_t)) {
-            *out = *it;
+    const Table *table = table_.load(std::memory_order_acquire);
+    for (size_t i = 0; i <= table->mask && actual_size + kRecordSize <= *pDataSize; ++i) {
+        const Slot &slot = table->slots[i];
+        const uint64_t low = slot.low.load(std::memory_order_acquire);
+        if (low != 0) {
+            const uint64_t high = slot.high.load(std::memory_order_relaxed);
+            std::memcpy(out + actual_size, &low, sizeof(uint64_t));
+            std::memcpy(out + actual_size + sizeof(uint64_t), &high, sizeof(uint64_t));
+            actual_size += kRecordSize;
         }
     }
 
@@ -104,10 +224,227 @@ void ValidationCache::Merge(ValidationCache const *other) {
     if (other == this) {
         return;
     }
-    auto other_guard = other->ReadLock();
-    auto guard = WriteLock();
-    good_shader_hashes_.reserve(good_shader_hashes_.size() + other->good_shader_hashes_.size());
-    for (auto h : other->good_shader_hashes_) good_shader_hashes_.insert(h);
+    // Reading other doesn't lock, so two caches can be merged into each other at the same time
+    const Table *other_table = other->table_.load(std::memory_order_acquire);
+    std::lock_guard<std::mutex> guard(insert_lock_);
+    for (size_t i = 0; i <= other_table->mask; ++i) {
+        const Slot &slot = other_table->slots[i];
+        const uint64_t low = slot.low.load(std::memory_order_acquire);
+        if (low != 0) {
+            const Key key{low, slot.high.load(std::memory_order_relaxed)};
+            if (InsertLocked(key) && !file_path_.empty()) {
+                file_pending_.emplace_back(key);
+            }
+        }
+    }
+}
+
+#if defined(VVL_VALIDATION_CACHE_MMAP)
+
+bool ValidationCache::AttachFile(const std::string &path) {
+    std::lock_guard<std::mutex> guard(insert_lock_);
+    assert(file_path_.empty());
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    file_path_ = path;
+    file_fd_ = fd;
+
+    // The header is only written (or, for a file of another version, replaced) with the file locked,
+    // so two processes starting at the same time can't both write one
+    flock(fd, LOCK_EX);
+    struct stat info;
+    bool valid = fstat(fd, &info) == 0;
+    if (valid && info.st_size > 0) {
+        const size_t size = static_cast<size_t>(info.st_size);
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            const uint8_t *data = static_cast<const uint8_t *>(mapping);
+            if (IsValidHeader(data, size)) {
+                LoadRecordsLocked(data + kHeaderSize, size - kHeaderSize);
+                // A record cut short by a crashed writer would misalign everything after it
+                file_size_ = size - (size - kHeaderSize) % kRecordSize;
+            }
+            munmap(mapping, size);
+        }
+    }
+    if (valid && file_size_ == 0) {
+        uint8_t header[kHeaderSize];
+        WriteHeader(header);
+        valid = ftruncate(fd, 0) == 0 && write(fd, header, kHeaderSize) == static_cast<ssize_t>(kHeaderSize);
+        file_size_ = kHeaderSize;
+    } else if (valid && file_size_ != static_cast<size_t>(info.st_size)) {
+        valid = ftruncate(fd, static_cast<off_t>(file_size_)) == 0;
+    }
+    flock(fd, LOCK_UN);
+    return valid;
+}
+
+bool ValidationCache::AppendToFile(const std::vector<Key> &keys) {
+    std::lock_guard<std::mutex> file_guard(file_lock_);
+    if (file_fd_ < 0) {
+        return false;
+    }
+
+    flock(file_fd_, LOCK_EX);
+    bool success = true;
+
+    // Pick up what other processes appended since the last time, and don't append it again
+    // (if the file shrank, it was compacted or replaced by another build, and there is nothing to pick up)
+    struct stat info;
+    if (fstat(file_fd_, &info) == 0) {
+        size_t size = static_cast<size_t>(info.st_size);
+        if (size > file_size_) {
+            // A record cut short by a crashed writer would misalign everything appended after it
+            const size_t aligned_size = size - (size - file_size_) % kRecordSize;
+            if (aligned_size != size && ftruncate(file_fd_, static_cast<off_t>(aligned_size)) == 0) {
+                size = aligned_size;
+            }
+            std::vector<uint8_t> appended(aligned_size - file_size_);
+            if (!appended.empty() && pread(file_fd_, appended.data(), appended.size(), static_cast<off_t>(file_size_)) ==
+                                         static_cast<ssize_t>(appended.size())) {
+                std::lock_guard<std::mutex> guard(insert_lock_);
+                LoadRecordsLocked(appended.data(), appended.size());
+            }
+        }
+        file_size_ = size;
+    }
+
+    if (!keys.empty()) {
+        std::vector<uint8_t> records(keys.size() * kRecordSize);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            std::memcpy(records.data() + i * kRecordSize, &keys[i].low, sizeof(uint64_t));
+            std::memcpy(records.data() + i * kRecordSize + sizeof(uint64_t), &keys[i].high, sizeof(uint64_t));
+        }
+        success = write(file_fd_, records.data(), records.size()) == static_cast<ssize_t>(records.size());
+        if (success) {
+            file_size_ += records.size();
+        }
+    }
+
+    // Other processes only ever read past what they already read, so rewriting the file in place while holding the lock is
+    // safe, they see it shrink and go on appending to it
+    if (success && file_size_ > kHeaderSize &&
+        NeedsCompaction((file_size_ - kHeaderSize) / kRecordSize, count_.load(std::memory_order_relaxed))) {
+        std::vector<uint8_t> records(file_size_ - kHeaderSize);
+        if (pread(file_fd_, records.data(), records.size(), static_cast<off_t>(kHeaderSize)) ==
+            static_cast<ssize_t>(records.size())) {
+            const std::vector<uint8_t> compacted = CompactRecords(records.data(), records.size());
+            success = ftruncate(file_fd_, static_cast<off_t>(kHeaderSize)) == 0 &&
+                      write(file_fd_, compacted.data(), compacted.size()) == static_cast<ssize_t>(compacted.size());
+            file_size_ = kHeaderSize + (success ? compacted.size() : 0);
+        }
+    }
+
+    flock(file_fd_, LOCK_UN);
+    return success;
+}
+
+#else
+
+bool ValidationCache::AttachFile(const std::string &path) {
+    std::lock_guard<std::mutex> guard(insert_lock_);
+    assert(file_path_.empty());
+    file_path_ = path;
+
+    std::vector<uint8_t> data;
+    std::ifstream read_file(path.c_str(), std::ios::in | std::ios::binary);
+    if (read_file) {
+        std::copy(std::istreambuf_iterator<char>(read_file), {}, std::back_inserter(data));
+        read_file.close();
+    }
+    if (IsValidHeader(data.data(), data.size())) {
+        LoadRecordsLocked(data.data() + kHeaderSize, data.size() - kHeaderSize);
+        file_size_ = data.size() - (data.size() - kHeaderSize) % kRecordSize;
+        if (NeedsCompaction((file_size_ - kHeaderSize) / kRecordSize, count_.load(std::memory_order_relaxed))) {
+            std::vector<uint8_t> compacted = CompactRecords(data.data() + kHeaderSize, file_size_ - kHeaderSize);
+            data.resize(kHeaderSize);
+            data.insert(data.end(), compacted.begin(), compacted.end());
+            file_size_ = data.size();
+        } else if (file_size_ == data.size()) {
+            return true;
+        }
+        data.resize(file_size_);
+    } else {
+        data.resize(kHeaderSize);
+        WriteHeader(data.data());
+        file_size_ = kHeaderSize;
+    }
+
+    // There is no file locking here, so the file is only rewritten when it is first attached (to compact it, or when it can't
+    // be appended to as it is)
+    std::ofstream write_file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!write_file) {
+        return false;
+    }
+    write_file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    return static_cast<bool>(write_file);
+}
+
+bool ValidationCache::AppendToFile(const std::vector<Key> &keys) {
+    std::lock_guard<std::mutex> file_guard(file_lock_);
+    if (file_path_.empty()) {
+        return false;
+    }
+    if (keys.empty()) {
+        return true;
+    }
+
+    std::ofstream write_file(file_path_.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+    for (const Key &key : keys) {
+        write_file.write(reinterpret_cast<const char *>(&key.low), sizeof(uint64_t));
+        write_file.write(reinterpret_cast<const char *>(&key.high), sizeof(uint64_t));
+    }
+    const bool success = static_cast<bool>(write_file);
+    if (success) {
+        file_size_ += keys.size() * kRecordSize;
+    }
+    return success;
+}
+
+#endif
+
+bool ValidationCache::FlushToFile() {
+    std::vector<Key> to_append;
+    {
+        std::lock_guard<std::mutex> guard(insert_lock_);
+        if (file_path_.empty()) {
+            return false;
+        }
+        to_append.swap(file_pending_);
+    }
+    return AppendToFile(to_append);
+}
+
+bool ValidationCache::NeedsCompaction(size_t file_records, size_t key_count) {
+    // Every key in the file is also in the cache, so past this the file is mostly keys appended more than once
+    return file_records > kMaxFileRecords || file_records > 2 * key_count + kFileFlushBatch;
+}
+
+std::vector<uint8_t> ValidationCache::CompactRecords(const uint8_t *records, size_t size) {
+    const size_t record_count = size / kRecordSize;
+    const size_t max_kept = std::min(record_count, kMaxFileRecords / 2);
+
+    // Walk from the newest record so the latest position of a key is the one kept
+    vvl::unordered_set<Key, Key::Hasher> seen;
+    std::vector<size_t> kept;
+    kept.reserve(max_kept);
+    for (size_t i = record_count; i > 0 && kept.size() < max_kept; --i) {
+        Key key;
+        std::memcpy(&key.low, records + (i - 1) * kRecordSize, sizeof(uint64_t));
+        std::memcpy(&key.high, records + (i - 1) * kRecordSize + sizeof(uint64_t), sizeof(uint64_t));
+        if ((key.low & 1) && seen.insert(key).second) {
+            kept.push_back(i - 1);
+        }
+    }
+
+    std::vector<uint8_t> compacted(kept.size() * kRecordSize);
+    uint8_t *out = compacted.data();
+    for (auto it = kept.rbegin(); it != kept.rend(); ++it, out += kRecordSize) {
+        std::memcpy(out, records + *it * kRecordSize, kRecordSize);
+    }
+    return compacted;
 }
 
 spv_target_env PickSpirvEnv(const APIVersion &api_version, bool spirv_1_4) {
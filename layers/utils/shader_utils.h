@@ -21,10 +21,22 @@
 #pragma once
 
 #include "vulkan/vulkan.h"
+#include "utils/hash_util.h"
 #include "utils/vk_layer_utils.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <spirv-tools/libspirv.hpp>
 
+// The shared validation cache file is mapped and locked with POSIX calls where they exist
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__GNU__)
+#define VVL_VALIDATION_CACHE_MMAP
+#endif
+
 struct DeviceFeatures;
 struct DeviceExtensions;
 class APIVersion;
@@ -68,45 +80,99 @@ inline ShaderObjectStage VkShaderStageToShaderObjectStage(VkShaderStageFlagBits
     return ShaderObjectStage::LAST;
 }
 
+// Set of SPIR-V modules that passed spirv-val before and don't need to be validated again.
+//
+// Keys are 128-bit XXH3 hashes of the code, seeded with the SPIRV-Tools commit and the spirv-val options. The same code
+// validated by another spirv-val, or with other options, never aliases, so caches of any device or build can be merged.
+//
+// Lookups don't lock. The keys live in an open addressing table that is only appended to; when it fills up it is replaced by a
+// bigger copy and the old one is kept alive until the cache is destroyed, so readers that still hold it stay valid. Inserts
+// are serialized by a mutex, which is the only lock Merge takes, so caches can be merged into each other concurrently.
+//
+// A cache can also be attached to a file that several processes share (AttachFile). The file is the same blob
+// vkGetValidationCacheDataEXT returns, but it is appended to. The keys found here are appended in batches under an advisory
+// lock, picking up what other processes appended since. The file I/O happens outside of the insert mutex. Once the file is
+// mostly keys appended twice, or holds more than kMaxFileRecords, it is rewritten in place with each key once, the most
+// recently appended ones first to go in.
 class ValidationCache {
   public:
+    using Key = hash_util::Hash128;
+
     static VkValidationCacheEXT Create(VkValidationCacheCreateInfoEXT const *pCreateInfo, uint32_t spirv_val_option_hash) {
         auto cache = new ValidationCache(spirv_val_option_hash);
         cache->Load(pCreateInfo);
         return VkValidationCacheEXT(cache);
     }
+    ~ValidationCache();
 
     void Load(VkValidationCacheCreateInfoEXT const *pCreateInfo);
     void Write(size_t *pDataSize, void *pData);
     void Merge(ValidationCache const *other);
 
-    bool Contains(uint32_t hash) {
-        auto guard = ReadLock();
-        return good_shader_hashes_.count(hash) != 0;
-    }
+    Key MakeKey(const void *code, size_t code_size) const;
+    bool Contains(const Key &key) const;
+    void Insert(const Key &key);
 
-    void Insert(uint32_t hash) {
-        auto guard = WriteLock();
-        good_shader_hashes_.insert(hash);
-    }
+    // Loads the keys stored in the file (creating it if needed), later inserts are appended to it
+    bool AttachFile(const std::string &path);
+    // Appends the keys not written to the attached file yet
+    bool FlushToFile();
 
   private:
-    ValidationCache(uint32_t spirv_val_option_hash) : spirv_val_option_hash_(spirv_val_option_hash) {}
-    ReadLockGuard ReadLock() const { return ReadLockGuard(lock_); }
-    WriteLockGuard WriteLock() { return WriteLockGuard(lock_); }
-
-    void GetUUID(uint8_t *uuid);
-
-    // Can hit cases where error appear/disappear if spirv-val settings are adjusted
-    // see https://github.com/KhronosGroup/Vulkan-ValidationLayers/issues/8031
-    uint32_t spirv_val_option_hash_;
-
-    // hashes of shaders that have passed validation before, and can be skipped.
-    // we don't store negative results, as we would have to also store what was
-    // wrong with them; also, we expect they will get fixed, so we're less
-    // likely to see them again.
-    vvl::unordered_set<uint32_t> good_shader_hashes_;
-    mutable std::shared_mutex lock_;
+    // 16-byte records after the header, the low bit of Key::low is always set so an all zero slot means empty
+    static constexpr uint32_t kFormatVersion = 2;
+    static constexpr size_t kHeaderSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+    static constexpr size_t kRecordSize = sizeof(uint64_t) * 2;
+    static constexpr size_t kInitialCapacity = 256;
+    // Keys are appended to the file once this many are pending, so concurrent processes see them early
+    static constexpr size_t kFileFlushBatch = 64;
+    // A compacted file keeps at most half of this, so it isn't compacted again right away
+    static constexpr size_t kMaxFileRecords = 1 << 20;
+
+    struct Slot {
+        std::atomic<uint64_t> low{0};
+        std::atomic<uint64_t> high{0};
+    };
+    struct Table {
+        explicit Table(size_t capacity) : mask(capacity - 1), slots(new Slot[capacity]) {}
+        const size_t mask;
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    ValidationCache(uint32_t spirv_val_option_hash);
+
+    static void GetUUID(uint8_t *uuid);
+    static bool IsValidHeader(const uint8_t *data, size_t size);
+    static void WriteHeader(uint8_t *out);
+
+    // All of these need insert_lock_
+    bool InsertLocked(const Key &key);
+    void StoreLocked(Table &table, const Key &key);
+    void LoadRecordsLocked(const uint8_t *records, size_t size);
+
+    // Takes file_lock_, insert_lock_ must not be held
+    bool AppendToFile(const std::vector<Key> &keys);
+    static bool NeedsCompaction(size_t file_records, size_t key_count);
+    // Each key of records once, in the order they were appended, keeping the newest when there are too many
+    static std::vector<uint8_t> CompactRecords(const uint8_t *records, size_t size);
+
+    // Seed of every key, see class comment
+    uint64_t key_seed_;
+
+    std::atomic<Table *> table_{nullptr};
+    std::vector<std::unique_ptr<Table>> tables_;  // current table and every one it replaced
+    std::atomic<size_t> count_{0};
+    mutable std::mutex insert_lock_;
+
+    // Attached file, file_path_ is only set by AttachFile
+    std::string file_path_;
+    std::vector<Key> file_pending_;  // needs insert_lock_
+    // Serializes the file I/O of this process, always taken without insert_lock_ held
+    std::mutex file_lock_;
+#if defined(VVL_VALIDATION_CACHE_MMAP)
+    int file_fd_ = -1;
+#endif
+    size_t file_size_ = 0;  // bytes of the file already read
 };
 
 spv_target_env PickSpirvEnv(const APIVersion &api_version, bool spirv_1_4);
@@ -0,0 +1,476 @@
+/* Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/spirv_cache.h"
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "utils/hash_util.h"
+
+// The instrumented shader cache file is read and locked with POSIX calls where they exist
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__GNU__)
+#define VVL_SPIRV_CACHE_MMAP
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <algorithm>
+#endif
+
+namespace vvl {
+
+SpirvCache::~SpirvCache() {
+#if defined(VVL_SPIRV_CACHE_MMAP)
+    if (file_fd_ >= 0) {
+        close(file_fd_);
+    }
+#endif
+}
+
+uint64_t SpirvCache::MakeKey(const void *code, size_t code_size) const {
+    return hash_util::ShaderHash64(code, code_size, key_seed_);
+}
+
+bool SpirvCache::IsEmpty() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return entries_.empty();
+}
+
+bool SpirvCache::Get(uint64_t key, std::vector<uint32_t> &out_spirv) {
+    if (GetIndexed(key, out_spirv)) {
+        return true;
+    }
+    // Another process might have instrumented it since, or compacted the file
+    return RefreshFromFile() && GetIndexed(key, out_spirv);
+}
+
+bool SpirvCache::GetIndexed(uint64_t key, std::vector<uint32_t> &out_spirv) {
+    // Only where to find the SPIR-V is taken under lock_, it is read from the file after releasing it
+    Entry file_entry;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return false;
+        }
+        if (it->second.file_offset == 0) {
+            out_spirv = it->second.spirv;
+            return true;
+        }
+        file_entry.file_offset = it->second.file_offset;
+        file_entry.dword_count = it->second.dword_count;
+    }
+    if (ReadRecord(key, file_entry, out_spirv)) {
+        return true;
+    }
+    // Gone from the file, let Add() store it again
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.file_offset == file_entry.file_offset) {
+        entries_.erase(it);
+        --file_keys_;
+    }
+    return false;
+}
+
+void SpirvCache::Add(uint64_t key, const std::vector<uint32_t> &spirv) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (entries_.find(key) != entries_.end()) {
+            return;
+        }
+    }
+    if (!file_path_.empty() && AppendToFile(key, spirv)) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(lock_);
+    if (entries_.find(key) == entries_.end()) {
+        Entry &entry = entries_[key];
+        entry.dword_count = static_cast<uint32_t>(spirv.size());
+        entry.spirv = spirv;
+    }
+}
+
+std::vector<uint8_t> SpirvCache::MakeRecord(uint64_t key, const std::vector<uint32_t> &spirv) {
+    const uint32_t dword_count = static_cast<uint32_t>(spirv.size());
+    const uint32_t checksum = hash_util::ShaderHash(spirv.data(), spirv.size() * sizeof(uint32_t));
+    std::vector<uint8_t> record(kRecordHeaderSize + spirv.size() * sizeof(uint32_t));
+    std::memcpy(record.data(), &key, sizeof(key));
+    std::memcpy(record.data() + sizeof(key), &dword_count, sizeof(dword_count));
+    std::memcpy(record.data() + sizeof(key) + sizeof(dword_count), &checksum, sizeof(checksum));
+    std::memcpy(record.data() + kRecordHeaderSize, spirv.data(), spirv.size() * sizeof(uint32_t));
+    return record;
+}
+
+size_t SpirvCache::ParseRecords(const uint8_t *data, size_t begin, size_t end, std::vector<FileRecord> &records) {
+    size_t offset = begin;
+    while (offset + kRecordHeaderSize <= end) {
+        uint64_t key;
+        uint32_t dword_count;
+        uint32_t checksum;
+        std::memcpy(&key, data + offset, sizeof(key));
+        std::memcpy(&dword_count, data + offset + sizeof(key), sizeof(dword_count));
+        std::memcpy(&checksum, data + offset + sizeof(key) + sizeof(dword_count), sizeof(checksum));
+        const size_t spirv_offset = offset + kRecordHeaderSize;
+        const size_t spirv_size = size_t(dword_count) * sizeof(uint32_t);
+        if (spirv_size > end - spirv_offset || hash_util::ShaderHash(data + spirv_offset, spirv_size) != checksum) {
+            break;  // cut short by a writer that crashed
+        }
+        records.push_back({key, spirv_offset, dword_count});
+        offset = spirv_offset + spirv_size;
+    }
+    return offset;
+}
+
+void SpirvCache::IndexRecordsLocked(const std::vector<FileRecord> &records) {
+    for (const FileRecord &record : records) {
+        ++file_records_;
+        Entry &entry = entries_[record.key];
+        if (entry.file_offset == 0) {
+            entry.file_offset = record.spirv_offset;
+            entry.dword_count = record.dword_count;
+            entry.spirv.clear();
+            ++file_keys_;
+        }
+    }
+}
+
+void SpirvCache::DropFileEntriesLocked() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        it = (it->second.file_offset != 0) ? entries_.erase(it) : std::next(it);
+    }
+    file_records_ = 0;
+    file_keys_ = 0;
+}
+
+bool SpirvCache::NeedsCompaction(size_t file_size, size_t file_records, size_t file_keys) {
+    // A key is only appended again when its record went missing, past this the file is mostly those
+    return file_size > kMaxFileSize || file_records > 2 * file_keys + kDuplicateRecordSlack;
+}
+
+std::vector<uint8_t> SpirvCache::CompactRecords(const uint8_t *data, size_t begin, size_t end) {
+    std::vector<FileRecord> records;
+    ParseRecords(data, begin, end, records);
+
+    // Walk from the newest record so the latest copy of a key is the one kept
+    vvl::unordered_set<uint64_t> seen;
+    std::vector<const FileRecord *> kept;
+    size_t kept_size = 0;
+    for (auto it = records.rbegin(); it != records.rend(); ++it) {
+        const size_t record_size = kRecordHeaderSize + size_t(it->dword_count) * sizeof(uint32_t);
+        if (kept_size + record_size > kMaxFileSize / 2) {
+            break;
+        }
+        if (seen.insert(it->key).second) {
+            kept.push_back(&*it);
+            kept_size += record_size;
+        }
+    }
+
+    std::vector<uint8_t> compacted;
+    compacted.reserve(kept_size);
+    for (auto it = kept.rbegin(); it != kept.rend(); ++it) {
+        const uint8_t *record = data + (*it)->spirv_offset - kRecordHeaderSize;
+        compacted.insert(compacted.end(), record, record + kRecordHeaderSize + size_t((*it)->dword_count) * sizeof(uint32_t));
+    }
+    return compacted;
+}
+
+#if defined(VVL_SPIRV_CACHE_MMAP)
+
+bool SpirvCache::RefreshFromFile() {
+    std::lock_guard<std::mutex> file_guard(file_lock_);
+    if (file_fd_ < 0) {
+        return false;
+    }
+    flock(file_fd_, LOCK_EX);
+    const bool valid = ReadFileLocked();
+    flock(file_fd_, LOCK_UN);
+    return valid;
+}
+
+// Indexes what other processes appended since the last call. With the file lock held, a record that doesn't check out is one
+// a crashed writer left behind, it is cut off so what gets appended next stays reachable.
+bool SpirvCache::ReadFileLocked() {
+    struct stat info;
+    if (fstat(file_fd_, &info) != 0) {
+        return false;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+
+    uint32_t header[3] = {};
+    if (size < kHeaderSize || pread(file_fd_, header, kHeaderSize, 0) != static_cast<ssize_t>(kHeaderSize) ||
+        header[0] != kFileMagic || header[1] != kFormatVersion) {
+        // New file, unknown content or another format version, start it over
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            DropFileEntriesLocked();
+        }
+        const uint32_t new_header[3] = {kFileMagic, kFormatVersion, 0};
+        file_size_ = 0;
+        file_generation_ = 0;
+        if (ftruncate(file_fd_, 0) != 0 || write(file_fd_, new_header, kHeaderSize) != static_cast<ssize_t>(kHeaderSize)) {
+            return false;
+        }
+        file_size_ = kHeaderSize;
+        return true;
+    }
+    if (file_size_ == 0 || size < file_size_ || header[2] != file_generation_) {
+        // First read, or another process compacted the file since, what was indexed from it moved
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            DropFileEntriesLocked();
+        }
+        file_size_ = kHeaderSize;
+        file_generation_ = header[2];
+    }
+    if (size == file_size_) {
+        return true;
+    }
+
+    // Only mapped while the file lock is held, nothing can truncate it under the mapping
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file_fd_, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    std::vector<FileRecord> records;
+    const size_t indexed_end = ParseRecords(static_cast<const uint8_t *>(mapping), file_size_, size, records);
+    munmap(mapping, size);
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        IndexRecordsLocked(records);
+    }
+    file_size_ = indexed_end;
+    return indexed_end == size || ftruncate(file_fd_, static_cast<off_t>(indexed_end)) == 0;
+}
+
+// Other processes only ever read past what they already indexed, and check the generation in the header first, so rewriting
+// the file in place while holding the file lock is safe. They see it changed and index it again.
+bool SpirvCache::CompactFileLocked() {
+    void *mapping = mmap(nullptr, file_size_, PROT_READ, MAP_SHARED, file_fd_, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    const std::vector<uint8_t> compacted = CompactRecords(static_cast<const uint8_t *>(mapping), kHeaderSize, file_size_);
+    munmap(mapping, file_size_);
+
+    const uint32_t header[3] = {kFileMagic, kFormatVersion, file_generation_ + 1};
+    std::vector<uint8_t> contents(kHeaderSize);
+    std::memcpy(contents.data(), header, kHeaderSize);
+    contents.insert(contents.end(), compacted.begin(), compacted.end());
+    std::vector<FileRecord> records;
+    ParseRecords(contents.data(), kHeaderSize, contents.size(), records);
+
+    const bool written = ftruncate(file_fd_, 0) == 0 &&
+                         write(file_fd_, contents.data(), contents.size()) == static_cast<ssize_t>(contents.size());
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        DropFileEntriesLocked();
+        if (written) {
+            IndexRecordsLocked(records);
+        }
+    }
+    if (!written) {
+        // What is left can't be trusted, the next read starts the file over
+        (void)ftruncate(file_fd_, 0);
+        file_size_ = 0;
+        return false;
+    }
+    file_size_ = contents.size();
+    file_generation_ = header[2];
+    return true;
+}
+
+// Another process can truncate or compact the file while it is read, without the file lock. Whatever was read is checked
+// against the key and the checksum before it is used.
+bool SpirvCache::ReadRecord(uint64_t key, const Entry &entry, std::vector<uint32_t> &out_spirv) const {
+    const size_t spirv_size = size_t(entry.dword_count) * sizeof(uint32_t);
+    std::vector<uint8_t> record(kRecordHeaderSize + spirv_size);
+    if (pread(file_fd_, record.data(), record.size(), static_cast<off_t>(entry.file_offset - kRecordHeaderSize)) !=
+        static_cast<ssize_t>(record.size())) {
+        return false;
+    }
+
+    uint64_t record_key;
+    uint32_t dword_count;
+    uint32_t checksum;
+    std::memcpy(&record_key, record.data(), sizeof(record_key));
+    std::memcpy(&dword_count, record.data() + sizeof(record_key), sizeof(dword_count));
+    std::memcpy(&checksum, record.data() + sizeof(record_key) + sizeof(dword_count), sizeof(checksum));
+    const uint8_t *spirv = record.data() + kRecordHeaderSize;
+    if (record_key != key || dword_count != entry.dword_count || hash_util::ShaderHash(spirv, spirv_size) != checksum) {
+        return false;
+    }
+    out_spirv.resize(dword_count);
+    std::memcpy(out_spirv.data(), spirv, spirv_size);
+    return true;
+}
+
+bool SpirvCache::AppendToFile(uint64_t key, const std::vector<uint32_t> &spirv) {
+    const std::vector<uint8_t> record = MakeRecord(key, spirv);
+    std::lock_guard<std::mutex> file_guard(file_lock_);
+    if (file_fd_ < 0) {
+        return false;
+    }
+    flock(file_fd_, LOCK_EX);
+    bool stored = false;
+    bool needs_compaction = false;
+    // Once everything other processes appended is indexed, the record lands at file_size_
+    if (ReadFileLocked()) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stored = entries_.find(key) != entries_.end();
+        }
+        if (!stored && write(file_fd_, record.data(), record.size()) == static_cast<ssize_t>(record.size())) {
+            const FileRecord file_record = {key, file_size_ + kRecordHeaderSize, static_cast<uint32_t>(spirv.size())};
+            file_size_ += record.size();
+            std::lock_guard<std::mutex> guard(lock_);
+            IndexRecordsLocked({file_record});
+            needs_compaction = NeedsCompaction(file_size_, file_records_, file_keys_);
+            stored = true;
+        } else if (!stored) {
+            // Don't leave a partial record behind
+            (void)ftruncate(file_fd_, static_cast<off_t>(file_size_));
+        }
+    }
+    if (needs_compaction) {
+        CompactFileLocked();
+    }
+    flock(file_fd_, LOCK_UN);
+    return stored;
+}
+
+bool SpirvCache::AttachFile(const std::string &path) {
+    std::lock_guard<std::mutex> file_guard(file_lock_);
+    assert(file_path_.empty());
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    file_path_ = path;
+    file_fd_ = fd;
+
+    flock(file_fd_, LOCK_EX);
+    bool valid = ReadFileLocked();
+    if (valid) {
+        bool needs_compaction = false;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            needs_compaction = NeedsCompaction(file_size_, file_records_, file_keys_);
+        }
+        if (needs_compaction) {
+            valid = CompactFileLocked();
+        }
+    }
+    flock(file_fd_, LOCK_UN);
+    return valid;
+}
+
+#else
+
+bool SpirvCache::RefreshFromFile() { return false; }
+bool SpirvCache::ReadFileLocked() { return false; }
+bool SpirvCache::CompactFileLocked() { return false; }
+bool SpirvCache::ReadRecord(uint64_t, const Entry &, std::vector<uint32_t> &) const { return false; }
+
+// Without file locking, the file is read once and the SPIR-V is kept in memory
+bool SpirvCache::AttachFile(const std::string &path) {
+    std::lock_guard<std::mutex> file_guard(file_lock_);
+    assert(file_path_.empty());
+
+    std::vector<uint8_t> data;
+    std::ifstream read_file(path.c_str(), std::ios::in | std::ios::binary);
+    if (read_file) {
+        std::copy(std::istreambuf_iterator<char>(read_file), {}, std::back_inserter(data));
+        read_file.close();
+    }
+    uint32_t header[3] = {};
+    if (data.size() >= kHeaderSize) {
+        std::memcpy(header, data.data(), kHeaderSize);
+    }
+    bool rewrite = true;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        file_path_ = path;
+        if (header[0] == kFileMagic && header[1] == kFormatVersion) {
+            std::vector<FileRecord> records;
+            const size_t valid_size = ParseRecords(data.data(), kHeaderSize, data.size(), records);
+            IndexRecordsLocked(records);
+            if (NeedsCompaction(valid_size, file_records_, file_keys_)) {
+                const std::vector<uint8_t> compacted = CompactRecords(data.data(), kHeaderSize, valid_size);
+                header[2]++;
+                data.resize(kHeaderSize);
+                std::memcpy(data.data(), header, kHeaderSize);
+                data.insert(data.end(), compacted.begin(), compacted.end());
+                records.clear();
+                ParseRecords(data.data(), kHeaderSize, data.size(), records);
+                DropFileEntriesLocked();
+                IndexRecordsLocked(records);
+            } else {
+                rewrite = valid_size != data.size();
+                data.resize(valid_size);
+            }
+            for (auto &[key, entry] : entries_) {
+                if (entry.file_offset != 0) {
+                    entry.spirv.resize(entry.dword_count);
+                    std::memcpy(entry.spirv.data(), data.data() + entry.file_offset, entry.dword_count * sizeof(uint32_t));
+                    entry.file_offset = 0;
+                }
+            }
+        } else {
+            data.resize(kHeaderSize);
+            header[0] = kFileMagic;
+            header[1] = kFormatVersion;
+            header[2] = 0;
+            std::memcpy(data.data(), header, kHeaderSize);
+        }
+    }
+    file_size_ = data.size();
+    if (!rewrite) {
+        return true;
+    }
+
+    // There is no file locking here, so the file is only rewritten when it is first attached (to compact it, or when it can't
+    // be appended to as it is)
+    std::ofstream write_file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!write_file) {
+        return false;
+    }
+    write_file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    return static_cast<bool>(write_file);
+}
+
+// The entry is kept in memory, returning false lets Add() store it
+bool SpirvCache::AppendToFile(uint64_t key, const std::vector<uint32_t> &spirv) {
+    const std::vector<uint8_t> record = MakeRecord(key, spirv);
+    std::lock_guard<std::mutex> file_guard(file_lock_);
+    std::ofstream write_file(file_path_.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+    write_file.write(reinterpret_cast<const char *>(record.data()), record.size());
+    if (write_file) {
+        file_size_ += record.size();
+    }
+    return false;
+}
+
+#endif
+
+}  // namespace vvl
@@ -0,0 +1,114 @@
+/* Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "containers/custom_containers.h"
+
+namespace vvl {
+
+// Instrumented SPIR-V keyed by a 64-bit hash of the original SPIR-V. The hash is seeded with everything that changes the
+// instrumentation (settings, GPU-AV shaders), so one cache can hold the output of several configurations.
+//
+// The cache can be backed by a file (AttachFile) that is only ever appended to. Each shader is appended as soon as it is
+// instrumented, so a crash only loses the shader being instrumented at that moment. The file is indexed by key and the SPIR-V
+// is only read back from it on a hit. Several processes can share the file: appends are done under an advisory lock, and a
+// miss picks up what other processes appended since. The file I/O happens outside of the mutex guarding the index. Once the
+// file is mostly keys appended twice, or grows past kMaxFileSize, it is rewritten in place with each key once, the most
+// recently appended ones first to go in.
+class SpirvCache {
+  public:
+    ~SpirvCache();
+
+    void SetKeySeed(uint64_t seed) { key_seed_ = seed; }
+    uint64_t MakeKey(const void *code, size_t code_size) const;
+
+    void Add(uint64_t key, const std::vector<uint32_t> &spirv);
+    bool Get(uint64_t key, std::vector<uint32_t> &out_spirv);
+    bool IsEmpty() const;
+
+    // Indexes the records already in the file (creating it if needed), later Add() calls append to it
+    bool AttachFile(const std::string &path);
+
+  private:
+    // After a 12-byte header, each record is [key, SPIR-V dword count, checksum of the SPIR-V] followed by the SPIR-V.
+    // The last header word is bumped each time the file is compacted, so other processes know their offsets moved.
+    static constexpr uint32_t kFileMagic = 0x56564943;  // "VVIC"
+    static constexpr uint32_t kFormatVersion = 2;
+    static constexpr size_t kHeaderSize = 3 * sizeof(uint32_t);
+    static constexpr size_t kRecordHeaderSize = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+    // A compacted file keeps at most half of this, so it isn't compacted again right away
+    static constexpr size_t kMaxFileSize = size_t(256) << 20;
+    // Keys appended more than once that are tolerated before compacting
+    static constexpr size_t kDuplicateRecordSlack = 64;
+
+    struct Entry {
+        size_t file_offset = 0;  // offset of the SPIR-V in the file, zero if the entry only lives in memory
+        uint32_t dword_count = 0;
+        std::vector<uint32_t> spirv;
+    };
+    struct FileRecord {
+        uint64_t key;
+        size_t spirv_offset;
+        uint32_t dword_count;
+    };
+
+    // Looks up what is already indexed, takes lock_ but reads the file without it
+    bool GetIndexed(uint64_t key, std::vector<uint32_t> &out_spirv);
+    // Take file_lock_, lock_ must not be held
+    bool RefreshFromFile();
+    bool AppendToFile(uint64_t key, const std::vector<uint32_t> &spirv);
+    // Need file_lock_ and the file lock, they take lock_ only to update the index
+    bool ReadFileLocked();
+    bool CompactFileLocked();
+    // Needs no lock, what is read is checked against the key and the checksum
+    bool ReadRecord(uint64_t key, const Entry &entry, std::vector<uint32_t> &out_spirv) const;
+
+    // Need lock_
+    void IndexRecordsLocked(const std::vector<FileRecord> &records);
+    void DropFileEntriesLocked();
+
+    // Returns the end of the last complete record in [begin, end) of the file contents
+    static size_t ParseRecords(const uint8_t *data, size_t begin, size_t end, std::vector<FileRecord> &records);
+    static std::vector<uint8_t> MakeRecord(uint64_t key, const std::vector<uint32_t> &spirv);
+    static bool NeedsCompaction(size_t file_size, size_t file_records, size_t file_keys);
+    // Each key of the records in [begin, end) once, in the order they were appended, keeping the newest when there are too many
+    static std::vector<uint8_t> CompactRecords(const uint8_t *data, size_t begin, size_t end);
+
+    uint64_t key_seed_ = 0;
+    mutable std::mutex lock_;
+    vvl::unordered_map<uint64_t, Entry> entries_;
+    // Need lock_, the records indexed from the file (counting keys appended more than once) and the entries backed by it
+    size_t file_records_ = 0;
+    size_t file_keys_ = 0;
+
+    // Attached file, file_path_ and file_fd_ are only set by AttachFile
+    std::string file_path_;
+    int file_fd_ = -1;
+    // Serializes the file I/O of this process (the advisory lock belongs to the open file, not to a thread), always taken
+    // without lock_ held. The members below need it.
+    std::mutex file_lock_;
+    size_t file_size_ = 0;  // bytes of the file that were indexed
+    uint32_t file_generation_ = 0;
+};
+
+}  // namespace vvl
@@ -0,0 +1,124 @@
+/* Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace vvl {
+
+uint32_t ThreadPool::DefaultThreadCount() {
+    const uint32_t hardware_threads = std::thread::hardware_concurrency();
+    return std::max(hardware_threads, 2u) - 1;
+}
+
+ThreadPool::ThreadPool(uint32_t thread_count) {
+    threads_.reserve(thread_count);
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        stopping_ = true;
+    }
+    task_ready_.notify_all();
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::Post(std::function<void()> &&task) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        tasks_.emplace_back(std::move(task));
+    }
+    task_ready_.notify_one();
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock_);
+            task_ready_.wait(guard, [this]() { return stopping_ || !tasks_.empty(); });
+            // Queued work is still done when stopping, callers may be waiting on it
+            if (tasks_.empty()) return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            ++running_tasks_;
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            if (--running_tasks_ == 0 && tasks_.empty()) {
+                idle_.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::WaitIdle() {
+    std::unique_lock<std::mutex> guard(lock_);
+    idle_.wait(guard, [this]() { return tasks_.empty() && running_tasks_ == 0; });
+}
+
+void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t index)> &func) {
+    if (count == 0) return;
+    if (count == 1 || threads_.empty()) {
+        for (uint32_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    // Indices are handed out one at a time, the cost of each one can be very different (e.g. pipelines with big shaders)
+    struct SharedState {
+        std::atomic<uint32_t> next_index{0};
+        std::mutex lock;
+        std::condition_variable done;
+        uint32_t helpers_running = 0;
+    } state;
+
+    auto run = [&state, &func, count]() {
+        for (uint32_t i = state.next_index++; i < count; i = state.next_index++) {
+            func(i);
+        }
+    };
+
+    const uint32_t helper_count = std::min(ThreadCount(), count - 1);
+    state.helpers_running = helper_count;
+    for (uint32_t i = 0; i < helper_count; ++i) {
+        Post([&state, &run]() {
+            run();
+            std::lock_guard<std::mutex> guard(state.lock);
+            if (--state.helpers_running == 0) {
+                state.done.notify_one();
+            }
+        });
+    }
+    run();
+
+    // The helpers reference this stack frame, so wait for all of them and not only for the last index
+    std::unique_lock<std::mutex> guard(state.lock);
+    state.done.wait(guard, [&state]() { return state.helpers_running == 0; });
+}
+
+}  // namespace vvl
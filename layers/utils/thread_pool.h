@@ -0,0 +1,66 @@
+/* Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vvl {
+
+// Fixed set of worker threads for validation work that can be split up (e.g. the create infos of a single vkCreate*Pipelines
+// call). Owned by a validation object and destroyed with the device, the destructor waits for any queued work.
+class ThreadPool {
+  public:
+    // Uses one thread less than the hardware has, the calling thread is expected to help in ParallelFor
+    static uint32_t DefaultThreadCount();
+
+    explicit ThreadPool(uint32_t thread_count = DefaultThreadCount());
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    uint32_t ThreadCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+    // Runs the task on a worker thread, in the order they were posted
+    void Post(std::function<void()> &&task);
+
+    // Calls func(i) for every i in [0, count), returns once all calls are done.
+    // The calling thread takes part, so this can't deadlock even if every worker is busy.
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t index)> &func);
+
+    // Blocks until every posted task has finished
+    void WaitIdle();
+
+  private:
+    void WorkerLoop();
+
+    std::mutex lock_;
+    std::condition_variable task_ready_;
+    std::condition_variable idle_;
+    std::deque<std::function<void()>> tasks_;
+    uint32_t running_tasks_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace vvl
@@ -24,4 +24,4 @@
 
 #pragma once
 
-#define GPU_AV_SHADER_GIT_HASH "da39a3ee5e6b4b0d3255bfef95601890afd80709"
+#define GPU_AV_SHADER_GIT_HASH "309b6bd214de33209fcc608a5f308ba6b0ae66fa"
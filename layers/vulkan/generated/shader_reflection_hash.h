@@ -0,0 +1,26 @@
+// *** THIS FILE IS GENERATED - DO NOT EDIT ***
+// See shader_reflection_hash_generator.py for modifications
+
+/***************************************************************************
+ *
+ * Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************/
+
+#pragma once
+
+// SHA1 of shader_instruction.cpp, shader_instruction.h, shader_module.cpp, shader_module.h
+#define SHADER_REFLECTION_SOURCE_HASH "7bce6b8933cc580d0a6cb86023bf3a0ed20480cb"
@@ -74,6 +74,7 @@ def RunGenerators(api: str, registry: str, grammar: str, directory: str, styleFi
     from generators.valid_enum_values_generator import ValidEnumValuesOutputGenerator
     from generators.valid_flag_values_generator import ValidFlagValuesOutputGenerator
     from generators.spirv_tool_commit_id_generator import SpirvToolCommitIdOutputGenerator
+    from generators.shader_reflection_hash_generator import ShaderReflectionHashOutputGenerator
     from generators.error_location_helper_generator import ErrorLocationHelperOutputGenerator
     from generators.pnext_chain_extraction_generator import PnextChainExtractionGenerator
     from generators.device_features_generator import DeviceFeaturesOutputGenerator
@@ -252,6 +253,10 @@ def RunGenerators(api: str, registry: str, grammar: str, directory: str, styleFi
             'genCombined': False,
             'generator' : SpirvToolCommitIdOutputGenerator,
         },
+        'shader_reflection_hash.h' : {
+            'genCombined': False,
+            'generator' : ShaderReflectionHashOutputGenerator,
+        },
         'command_validation.cpp' : {
             'generator' : CommandValidationOutputGenerator,
             'genCombined': True,
@@ -193,8 +193,9 @@ extern const uint32_t {name}[];
 def write_inst_hash(shaders_to_compile, outdir=None):
     # Build a hash of the git hash for all instrumentation shaders
     hash_string = ''
-    for shader in shaders_to_compile:
-        if os.path.basename(shader).find('instrumentation') == -1:
+    # Sorted so the hash doesn't depend on the directory listing order
+    for shader in sorted(shaders_to_compile):
+        if os.path.basename(os.path.dirname(shader)) != 'instrumentation':
             continue
         result = subprocess.run(["git", "hash-object", shader], capture_output=True, text=True)
         git_hash = result.stdout.rstrip('\n')
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Khronos Group Inc.
+# Copyright (c) 2024 Valve Corporation
+# Copyright (c) 2024 LunarG, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import hashlib
+from generators.base_generator import BaseGenerator
+
+# The persisted SPIR-V reflection is computed and encoded by these, any change to them invalidates records written before
+REFLECTION_SOURCES = [
+    'layers/state_tracker/shader_instruction.cpp',
+    'layers/state_tracker/shader_instruction.h',
+    'layers/state_tracker/shader_module.cpp',
+    'layers/state_tracker/shader_module.h',
+]
+
+class ShaderReflectionHashOutputGenerator(BaseGenerator):
+    def __init__(self):
+        BaseGenerator.__init__(self)
+
+    def generate(self):
+        repo_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+
+        # Read as text so the hash is the same for checkouts with CRLF line endings
+        source_hash = hashlib.sha1()
+        for source in REFLECTION_SOURCES:
+            with open(os.path.join(repo_dir, source), 'r', encoding='utf-8') as source_file:
+                source_hash.update(source.encode('utf-8'))
+                source_hash.update(source_file.read().encode('utf-8'))
+
+        out = []
+        out.append(f'''// *** THIS FILE IS GENERATED - DO NOT EDIT ***
+            // See {os.path.basename(__file__)} for modifications
+
+            /***************************************************************************
+            *
+            * Copyright (c) 2024 The Khronos Group Inc.
+            * Copyright (c) 2024 Valve Corporation
+            * Copyright (c) 2024 LunarG, Inc.
+            *
+            * Licensed under the Apache License, Version 2.0 (the "License");
+            * you may not use this file except in compliance with the License.
+            * You may obtain a copy of the License at
+            *
+            *     http://www.apache.org/licenses/LICENSE-2.0
+            *
+            * Unless required by applicable law or agreed to in writing, software
+            * distributed under the License is distributed on an "AS IS" BASIS,
+            * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+            * See the License for the specific language governing permissions and
+            * limitations under the License.
+            ****************************************************************************/
+
+            #pragma once
+
+            ''')
+
+        out.append(f'// SHA1 of {", ".join(os.path.basename(x) for x in REFLECTION_SOURCES)}\n')
+        out.append(f'#define SHADER_REFLECTION_SOURCE_HASH "{source_hash.hexdigest()}"')
+        self.write("".join(out))
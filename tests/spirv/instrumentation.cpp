@@ -9,11 +9,18 @@
  */
 
 #include <stdio.h>
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <filesystem>
 #include <vector>
 #include <cstring>
 #include <chrono>
+#include <string>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 #include "module.h"
 
@@ -21,6 +28,8 @@ static constexpr uint32_t kDefaultShaderId = 23;
 static constexpr uint32_t kInstDefaultDescriptorSet = 3;
 
 static bool timer = false;
+static bool benchmark = false;
+static uint32_t benchmark_iterations = 1;
 static bool print_debug_info = false;
 static bool all_passes = false;
 static bool bindless_descriptor_pass = false;
@@ -35,8 +44,9 @@ void PrintUsage(const char* program) {
 %s - Test the SPIR-V Instrumentation used for GPU-AV
 
 USAGE: %s <input> -o <output> <passes>
+       %s <input directory> --benchmark [--iterations <count>] [-o <output json>]
 )",
-           program, program);
+           program, program, program);
 
     printf(R"(
   --all-passes
@@ -55,6 +65,12 @@ USAGE: %s <input> -o <output> <passes>
                Runs DebugPrintfPass
   --timer
                Prints time it takes to instrument entire module
+  --benchmark
+               Loads every SPIR-V file under the input directory once, then instruments all of them with each
+               pass on its own and with all GPU-AV passes together. The results are written as JSON to the output
+               file (or stdout). Pass flags are ignored.
+  --iterations <count>
+               How many times the benchmark instruments the corpus for each pass (default 1)
   --print-debug-info
                Prints debug info for each pass
   -h, --help
@@ -78,6 +94,15 @@ bool ParseFlags(int argc, char** argv, const char** out_file) {
             }
         } else if (0 == strcmp(cur_arg, "--timer")) {
             timer = true;
+        } else if (0 == strcmp(cur_arg, "--benchmark")) {
+            benchmark = true;
+        } else if (0 == strcmp(cur_arg, "--iterations")) {
+            if (argi + 1 < argc && atoi(argv[argi + 1]) > 0) {
+                benchmark_iterations = static_cast<uint32_t>(atoi(argv[++argi]));
+            } else {
+                PrintUsage(argv[0]);
+                return false;
+            }
         } else if (0 == strcmp(cur_arg, "--print-debug-info")) {
             print_debug_info = true;
         } else if (0 == strcmp(cur_arg, "--all-passes")) {
@@ -104,8 +129,196 @@ bool ParseFlags(int argc, char** argv, const char** out_file) {
     return true;  // valid
 }
 
+static gpu::spirv::Settings GetModuleSettings(bool has_bindless_descriptors) {
+    gpu::spirv::Settings module_settings{};
+    module_settings.shader_id = kDefaultShaderId;
+    module_settings.output_buffer_descriptor_set = kInstDefaultDescriptorSet;
+    module_settings.print_debug_info = print_debug_info;
+    module_settings.max_instrumented_count = 0;
+    module_settings.support_int64 = true;
+    module_settings.support_memory_model_device_scope = true;
+    module_settings.has_bindless_descriptors = has_bindless_descriptors;
+    return module_settings;
+}
+
+static bool ReadSpirv(const char* path, std::vector<uint32_t>& spirv_data) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return false;
+    }
+
+    const int buf_size = 1024;
+    uint32_t buf[buf_size];
+    while (size_t len = fread(buf, sizeof(uint32_t), buf_size, fp)) {
+        spirv_data.insert(spirv_data.end(), buf, buf + len);
+    }
+    fclose(fp);
+    return true;
+}
+
+static uint64_t CountInstructions(const std::vector<uint32_t>& spirv_data) {
+    uint64_t count = 0;
+    size_t offset = 5;  // skip header
+    while (offset < spirv_data.size()) {
+        const uint32_t length = spirv_data[offset] >> 16;
+        if (length == 0) {
+            break;  // malformed, don't loop forever
+        }
+        offset += length;
+        count++;
+    }
+    return count;
+}
+
+// Peak resident set size of the whole process, 0 if not known on this platform
+static uint64_t PeakRssBytes() {
+#if defined(__linux__) || defined(__APPLE__)
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return static_cast<uint64_t>(usage.ru_maxrss);  // already bytes
+#else
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // kilobytes
+#endif
+    }
+#endif
+    return 0;
+}
+
+struct BenchmarkConfig {
+    const char* name;
+    gpu::spirv::InstrumentationPasses passes;
+    bool debug_printf;
+};
+
+// Instruments every shader of the corpus with each pass on its own, then with all the GPU-AV passes together. The
+// "all-gpu-av-passes" and "debug-printf" configs go through the same steps as GpuShaderInstrumentor::InstrumentShader() does for
+// GPU-AV and DebugPrintf, including stopping early if nothing was instrumented. The wall time of a config covers the whole
+// shader, not only its passes: parsing into the IR, linking the GLSL helpers, PostProcess() and ToBinary() are included.
+//
+// Peak memory is given two ways: the largest module arena seen for the pass (the IR memory of one shader), and the peak RSS of
+// the process after the pass, which only ever grows so it is mostly useful for the first pass and for comparing runs.
+static int RunBenchmark(const char* corpus_path, const char* out_file) {
+    std::vector<std::vector<uint32_t>> corpus;
+    uint64_t corpus_words = 0;
+    uint64_t corpus_instructions = 0;
+    std::vector<std::filesystem::path> files;
+    if (std::filesystem::is_directory(corpus_path)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(corpus_path)) {
+            if (entry.is_regular_file()) {
+                files.emplace_back(entry.path());
+            }
+        }
+    } else {
+        files.emplace_back(corpus_path);
+    }
+    for (const auto& file : files) {
+        std::vector<uint32_t> spirv_data;
+        if (!ReadSpirv(file.string().c_str(), spirv_data) || spirv_data.size() < 5 || spirv_data[0] != spv::MagicNumber) {
+            continue;  // not every file in a corpus directory is SPIR-V
+        }
+        corpus_words += spirv_data.size();
+        corpus_instructions += CountInstructions(spirv_data);
+        corpus.emplace_back(std::move(spirv_data));
+    }
+    if (corpus.empty()) {
+        std::cout << "ERROR: No SPIR-V found in " << corpus_path << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BenchmarkConfig> configs(7);
+    configs[0].name = "bindless-descriptor";
+    configs[0].passes.bindless_descriptor = true;
+    configs[1].name = "non-bindless-oob-buffer";
+    configs[1].passes.non_bindless_oob_buffer = true;
+    configs[2].name = "non-bindless-oob-texel-buffer";
+    configs[2].passes.non_bindless_oob_texel_buffer = true;
+    configs[3].name = "buffer-device-address";
+    configs[3].passes.buffer_device_address = true;
+    configs[4].name = "ray-query";
+    configs[4].passes.ray_query = true;
+    configs[5].name = "debug-printf";
+    configs[5].debug_printf = true;
+    configs[6].name = "all-gpu-av-passes";
+    configs[6].passes = {true, true, true, true, true};
+
+    std::string json = "{\n";
+    json += "  \"shaders\": " + std::to_string(corpus.size()) + ",\n";
+    json += "  \"input_words\": " + std::to_string(corpus_words) + ",\n";
+    json += "  \"input_instructions\": " + std::to_string(corpus_instructions) + ",\n";
+    json += "  \"iterations\": " + std::to_string(benchmark_iterations) + ",\n";
+    json += "  \"passes\": [\n";
+    for (size_t config_i = 0; config_i < configs.size(); config_i++) {
+        const BenchmarkConfig& config = configs[config_i];
+        const bool has_bindless_descriptors = config.passes.bindless_descriptor;
+
+        uint64_t instrumented_shaders = 0;
+        uint64_t output_words = 0;
+        size_t peak_arena_bytes = 0;
+        std::vector<uint32_t> out_data;
+
+        const auto start_time = std::chrono::steady_clock::now();
+        for (uint32_t iteration = 0; iteration < benchmark_iterations; iteration++) {
+            for (const auto& spirv_data : corpus) {
+                gpu::spirv::Module module(spirv_data, nullptr, GetModuleSettings(has_bindless_descriptors));
+                bool modified = module.RunInstrumentationPasses(config.passes);
+                if (config.debug_printf) {
+                    modified |= module.RunPassDebugPrintf();
+                }
+                for (const auto& info : module.link_info_) {
+                    module.LinkFunction(info);
+                }
+
+                size_t out_size = spirv_data.size();
+                if (modified) {
+                    module.PostProcess();
+                    out_data.clear();
+                    module.ToBinary(out_data);
+                    out_size = out_data.size();
+                }
+                peak_arena_bytes = std::max(peak_arena_bytes, module.arena_.BytesReserved());
+
+                if (iteration == 0) {
+                    instrumented_shaders += modified ? 1 : 0;
+                    output_words += out_size;
+                }
+            }
+        }
+        const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start_time;
+
+        const double seconds = duration.count() / benchmark_iterations;
+        const double instructions_per_second = seconds > 0.0 ? static_cast<double>(corpus_instructions) / seconds : 0.0;
+        const double size_growth = static_cast<double>(output_words) / static_cast<double>(corpus_words);
+
+        json += "    {\n";
+        json += "      \"name\": \"" + std::string(config.name) + "\",\n";
+        json += "      \"wall_time_ms\": " + std::to_string(seconds * 1000.0) + ",\n";
+        json += "      \"instructions_per_second\": " + std::to_string(instructions_per_second) + ",\n";
+        json += "      \"instrumented_shaders\": " + std::to_string(instrumented_shaders) + ",\n";
+        json += "      \"output_words\": " + std::to_string(output_words) + ",\n";
+        json += "      \"size_growth\": " + std::to_string(size_growth) + ",\n";
+        json += "      \"peak_arena_bytes\": " + std::to_string(peak_arena_bytes) + ",\n";
+        json += "      \"peak_rss_bytes\": " + std::to_string(PeakRssBytes()) + "\n";
+        json += (config_i + 1 < configs.size()) ? "    },\n" : "    }\n";
+    }
+    json += "  ]\n}\n";
+
+    if (out_file) {
+        FILE* fp = fopen(out_file, "wb");
+        if (!fp) {
+            std::cout << "ERROR: Unable to open the output file " << out_file << '\n';
+            return EXIT_FAILURE;
+        }
+        fwrite(json.data(), 1, json.size(), fp);
+        fclose(fp);
+    } else {
+        std::cout << json;
+    }
+    return 0;
+}
+
 int main(int argc, char** argv) {
-    if (argc < 5) {
+    if (argc < 3) {
         PrintUsage(argv[0]);
         return EXIT_FAILURE;
     } else if (!std::filesystem::exists(argv[1])) {
@@ -118,56 +331,36 @@ int main(int argc, char** argv) {
         return EXIT_FAILURE;
     }
 
+    if (benchmark) {
+        return RunBenchmark(argv[1], out_file);
+    }
+
     if (out_file == nullptr) {
         std::cout << "ERROR: output file is required ( -o )";
         return EXIT_FAILURE;
     }
 
-    FILE* fp = fopen(argv[1], "rb");
-    if (!fp) {
+    std::vector<uint32_t> spirv_data;
+    if (!ReadSpirv(argv[1], spirv_data)) {
         std::cout << "ERROR: Unable to open the input file " << argv[1] << '\n';
         return EXIT_FAILURE;
     }
 
-    std::vector<uint32_t> spirv_data;
-    const int buf_size = 1024;
-    uint32_t buf[buf_size];
-    while (size_t len = fread(buf, sizeof(uint32_t), buf_size, fp)) {
-        spirv_data.insert(spirv_data.end(), buf, buf + len);
-    }
-    fclose(fp);
-
     std::chrono::time_point<std::chrono::high_resolution_clock> start_time;
     if (timer) {
         start_time = std::chrono::high_resolution_clock::now();
     }
 
-    gpu::spirv::Settings module_settings{};
-    module_settings.shader_id = kDefaultShaderId;
-    module_settings.output_buffer_descriptor_set = kInstDefaultDescriptorSet;
-    module_settings.print_debug_info = print_debug_info;
-    module_settings.max_instrumented_count = 0;
-    module_settings.support_int64 = true;
-    module_settings.support_memory_model_device_scope = true;
     // for all passes, test worst case of using bindless
-    module_settings.has_bindless_descriptors = all_passes || bindless_descriptor_pass;
-
+    gpu::spirv::Settings module_settings = GetModuleSettings(all_passes || bindless_descriptor_pass);
     gpu::spirv::Module module(spirv_data, nullptr, module_settings);
-    if (all_passes || bindless_descriptor_pass) {
-        module.RunPassBindlessDescriptor();
-    }
-    if (all_passes || non_bindless_oob_buffer_pass) {
-        module.RunPassNonBindlessOOBBuffer();
-    }
-    if (all_passes || non_bindless_oob_texel_buffer_pass) {
-        module.RunPassNonBindlessOOBTexelBuffer();
-    }
-    if (all_passes || buffer_device_address_pass) {
-        module.RunPassBufferDeviceAddress();
-    }
-    if (all_passes || ray_query_pass) {
-        module.RunPassRayQuery();
-    }
+    gpu::spirv::InstrumentationPasses passes;
+    passes.bindless_descriptor = all_passes || bindless_descriptor_pass;
+    passes.non_bindless_oob_buffer = all_passes || non_bindless_oob_buffer_pass;
+    passes.non_bindless_oob_texel_buffer = all_passes || non_bindless_oob_texel_buffer_pass;
+    passes.buffer_device_address = all_passes || buffer_device_address_pass;
+    passes.ray_query = all_passes || ray_query_pass;
+    module.RunInstrumentationPasses(passes);
     if (all_passes || debug_printf_pass) {
         module.RunPassDebugPrintf();
     }
@@ -185,7 +378,7 @@ int main(int argc, char** argv) {
         std::cout << "Time = " << duration.count() << "ms\n";
     }
 
-    fp = fopen(out_file, "wb");
+    FILE* fp = fopen(out_file, "wb");
     if (!fp) {
         std::cout << "ERROR: Unable to open the output file " << out_file << '\n';
         return EXIT_FAILURE;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <spirv-tools/libspirv.hpp>
+
+#include "module.h"
+
+static std::vector<uint32_t> Assemble(const char *source) {
+    spvtools::SpirvTools tools(SPV_ENV_VULKAN_1_2);
+    std::vector<uint32_t> words;
+    EXPECT_TRUE(tools.Assemble(source, &words));
+    return words;
+}
+
+static gpu::spirv::Settings GetModuleSettings() {
+    gpu::spirv::Settings module_settings{};
+    module_settings.shader_id = 23;
+    module_settings.output_buffer_descriptor_set = 3;
+    module_settings.support_int64 = true;
+    module_settings.support_memory_model_device_scope = true;
+    return module_settings;
+}
+
+// With all the passes enabled, but only one of them finding anything to instrument, sharing a walk of the module must not change
+// anything compared to running the passes one after the other
+TEST(GpuAVSpirv, FusedPassesMatchSequentialPasses) {
+    const std::vector<uint32_t> shader = Assemble(R"(
+               OpCapability Shader
+               OpCapability PhysicalStorageBufferAddresses
+               OpMemoryModel PhysicalStorageBuffer64 GLSL450
+               OpEntryPoint GLCompute %main "main"
+               OpExecutionMode %main LocalSize 1 1 1
+               OpDecorate %Data Block
+               OpMemberDecorate %Data 0 Offset 0
+               OpMemberDecorate %Data 1 Offset 4
+               OpDecorate %pc_struct Block
+               OpMemberDecorate %pc_struct 0 Offset 0
+       %void = OpTypeVoid
+       %func = OpTypeFunction %void
+       %uint = OpTypeInt 32 0
+        %int = OpTypeInt 32 1
+      %int_0 = OpConstant %int 0
+      %int_1 = OpConstant %int 1
+       %Data = OpTypeStruct %uint %uint
+   %ptr_Data = OpTypePointer PhysicalStorageBuffer %Data
+%ptr_pc_data = OpTypePointer PushConstant %ptr_Data
+  %pc_struct = OpTypeStruct %ptr_Data
+     %ptr_pc = OpTypePointer PushConstant %pc_struct
+         %pc = OpVariable %ptr_pc PushConstant
+   %ptr_uint = OpTypePointer PhysicalStorageBuffer %uint
+       %main = OpFunction %void None %func
+      %label = OpLabel
+   %data_ptr = OpAccessChain %ptr_pc_data %pc %int_0
+       %data = OpLoad %ptr_Data %data_ptr
+          %a = OpAccessChain %ptr_uint %data %int_0
+          %b = OpAccessChain %ptr_uint %data %int_1
+     %a_load = OpLoad %uint %a Aligned 4
+     %b_load = OpLoad %uint %b Aligned 4
+        %sum = OpIAdd %uint %a_load %b_load
+               OpStore %a %sum Aligned 4
+               OpStore %b %sum Aligned 4
+               OpReturn
+               OpFunctionEnd
+    )");
+    ASSERT_FALSE(shader.empty());
+
+    gpu::spirv::Module sequential_module(shader, nullptr, GetModuleSettings());
+    bool sequential_changed = sequential_module.RunPassBindlessDescriptor();
+    sequential_changed |= sequential_module.RunPassNonBindlessOOBBuffer();
+    sequential_changed |= sequential_module.RunPassNonBindlessOOBTexelBuffer();
+    sequential_changed |= sequential_module.RunPassBufferDeviceAddress();
+    sequential_changed |= sequential_module.RunPassRayQuery();
+    std::vector<uint32_t> sequential;
+    sequential_module.ToBinary(sequential);
+
+    gpu::spirv::Module fused_module(shader, nullptr, GetModuleSettings());
+    gpu::spirv::InstrumentationPasses passes;
+    passes.bindless_descriptor = true;
+    passes.non_bindless_oob_buffer = true;
+    passes.non_bindless_oob_texel_buffer = true;
+    passes.buffer_device_address = true;
+    passes.ray_query = true;
+    const bool fused_changed = fused_module.RunInstrumentationPasses(passes);
+    std::vector<uint32_t> fused;
+    fused_module.ToBinary(fused);
+
+    EXPECT_TRUE(sequential_changed);
+    EXPECT_TRUE(fused_changed);
+    // 2 loads and 2 stores, each wrapped in its own check
+    EXPECT_EQ(fused_module.functions_[0]->blocks_.size(), 1u + 4u * 3u);
+    EXPECT_EQ(sequential, fused);
+}
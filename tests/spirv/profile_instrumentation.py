@@ -19,15 +19,48 @@
 
 import os
 import sys
+import json
 import argparse
 import tempfile
 import subprocess
 
+# Runs the instrumentation in --benchmark mode, which loads the corpus once and measures every pass in the same process.
+# Results are printed as a table and can be saved as JSON to later be given back as a --baseline to compare against.
+def RunBenchmark(exe_path, shaders, iterations, output, baseline):
+    with tempfile.TemporaryDirectory(prefix='vvl_spirv_instrumentation_') as temp_dir:
+        json_file = os.path.join(temp_dir, 'benchmark.json')
+        subprocess.check_call([exe_path, shaders, '--benchmark', '--iterations', str(iterations), '-o', json_file])
+        with open(json_file, 'r') as f:
+            results = json.load(f)
+
+    if output:
+        with open(output, 'w') as f:
+            json.dump(results, f, indent=2)
+
+    baseline_times = {}
+    if baseline:
+        with open(baseline, 'r') as f:
+            baseline_times = {p['name']: p['wall_time_ms'] for p in json.load(f)['passes']}
+
+    print(f'{results["shaders"]} shaders, {results["input_instructions"]} instructions, {results["iterations"]} iteration(s)')
+    print(f'{"pass":<32}{"time (ms)":>12}{"M inst/s":>10}{"growth":>8}{"arena (KB)":>12}{"rss (MB)":>10}{"vs baseline":>13}')
+    for p in results['passes']:
+        line = (f'{p["name"]:<32}{p["wall_time_ms"]:>12.3f}{p["instructions_per_second"] / 1e6:>10.2f}'
+                f'{p["size_growth"]:>8.3f}{p["peak_arena_bytes"] / 1024:>12.1f}{p["peak_rss_bytes"] / (1024 * 1024):>10.1f}')
+        if p['name'] in baseline_times and baseline_times[p['name']] > 0:
+            change = (p['wall_time_ms'] / baseline_times[p['name']] - 1.0) * 100.0
+            line += f'{change:>+12.1f}%'
+        print(line)
+
 if __name__ == '__main__':
     parser = argparse.ArgumentParser(description='run instrumentation against a directory of SPIR-V files')
     parser.add_argument('--exe', action='store', type=str, help='path to instrumentation executable')
     parser.add_argument('--shaders', action='store', required=True, type=str, help='path to directory with shaders')
     parser.add_argument('--passes', action='store', type=str, help='set which pass to run (Default "all-passes")')
+    parser.add_argument('--benchmark', action='store_true', help='measure every pass over the directory loaded once, instead of one process per shader')
+    parser.add_argument('--iterations', action='store', type=int, default=1, help='how many times the benchmark goes over the directory')
+    parser.add_argument('--output', action='store', type=str, help='save the benchmark results as JSON')
+    parser.add_argument('--baseline', action='store', type=str, help='benchmark JSON from a previous --output to compare the times with')
     args = parser.parse_args()
 
     root_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
@@ -42,6 +75,10 @@ if __name__ == '__main__':
     if not os.path.isdir(args.shaders):
         sys.exit("Cannot find valid directory for shaders: " + args.shaders)
 
+    if args.benchmark:
+        RunBenchmark(exe_path, args.shaders, args.iterations, args.output, args.baseline)
+        sys.exit(0)
+
     passes = (f'--{args.passes}') if args.passes else "--all-passes"
 
     # generate in temp directory so we can compare or copy later
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include <spirv-tools/libspirv.hpp>
+
+#include "module.h"
+#include "containers/custom_containers.h"
+
+static constexpr spv_target_env kTargetEnv = SPV_ENV_VULKAN_1_1;
+
+static std::vector<uint32_t> Assemble(const char *source) {
+    spvtools::SpirvTools tools(kTargetEnv);
+    std::vector<uint32_t> words;
+    EXPECT_TRUE(tools.Assemble(source, &words));
+    return words;
+}
+
+static gpu::spirv::Settings GetModuleSettings() {
+    gpu::spirv::Settings module_settings{};
+    module_settings.shader_id = 23;
+    module_settings.output_buffer_descriptor_set = 3;
+    module_settings.support_int64 = true;
+    module_settings.support_memory_model_device_scope = true;
+    return module_settings;
+}
+
+static vvl::unordered_set<uint32_t> GlobalResultIds(const gpu::spirv::Module &module) {
+    vvl::unordered_set<uint32_t> ids;
+    for (const auto &inst : module.types_values_constants_) {
+        ids.insert(inst->ResultId());
+    }
+    return ids;
+}
+
+TEST(GpuAVSpirv, RemoveUnusedAddedValues) {
+    const std::vector<uint32_t> shader = Assemble(R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint GLCompute %main "main"
+               OpExecutionMode %main LocalSize 1 1 1
+       %void = OpTypeVoid
+       %func = OpTypeFunction %void
+       %main = OpFunction %void None %func
+      %label = OpLabel
+               OpReturn
+               OpFunctionEnd
+    )");
+
+    // Stands in for a GLSL helper, it declares more types and constants than its function needs
+    const std::vector<uint32_t> helper = Assemble(R"(
+               OpCapability Shader
+               OpCapability Linkage
+               OpMemoryModel Logical GLSL450
+               OpDecorate %helper LinkageAttributes "helper" Export
+       %uint = OpTypeInt 32 0
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+     %uint_7 = OpConstant %uint 7
+  %uint_1234 = OpConstant %uint 1234
+    %float_2 = OpConstant %float 2
+  %func_uint = OpTypeFunction %uint %uint
+     %helper = OpFunction %uint None %func_uint
+      %param = OpFunctionParameter %uint
+      %entry = OpLabel
+        %sum = OpIAdd %uint %param %uint_7
+               OpReturnValue %sum
+               OpFunctionEnd
+    )");
+    ASSERT_FALSE(shader.empty());
+    ASSERT_FALSE(helper.empty());
+
+    gpu::spirv::Module module(shader, nullptr, GetModuleSettings());
+    const uint32_t function_id = module.TakeNextId();
+    const gpu::spirv::LinkInfo link_info = {helper.data(), static_cast<uint32_t>(helper.size()),
+                                            gpu::spirv::LinkFunctions::inst_buffer_device_address, function_id, "inst_helper"};
+    module.LinkFunction(link_info);
+
+    // All of these were added by linking, only the uint type and the constant used by the helper are needed
+    gpu::spirv::TypeManager &type_manager = module.type_manager_;
+    const gpu::spirv::Type &uint_type = type_manager.GetTypeInt(32, false);
+    const gpu::spirv::Type &float_type = type_manager.GetTypeFloat(32);
+    const uint32_t uint_id = uint_type.Id();
+    const uint32_t float_id = float_type.Id();
+    const uint32_t v4float_id = type_manager.GetTypeVector(float_type, 4).Id();
+    ASSERT_NE(type_manager.FindConstantInt32(uint_id, 7), nullptr);
+    ASSERT_NE(type_manager.FindConstantInt32(uint_id, 1234), nullptr);
+    const uint32_t uint_7_id = type_manager.FindConstantInt32(uint_id, 7)->Id();
+    const uint32_t uint_1234_id = type_manager.FindConstantInt32(uint_id, 1234)->Id();
+    ASSERT_EQ(GlobalResultIds(module).count(float_id), 1u);
+
+    module.PostProcess();
+    std::vector<uint32_t> instrumented;
+    module.ToBinary(instrumented);
+
+    const gpu::spirv::Module output(instrumented, nullptr, GetModuleSettings());
+    const vvl::unordered_set<uint32_t> ids = GlobalResultIds(output);
+    EXPECT_EQ(ids.count(uint_id), 1u);
+    EXPECT_EQ(ids.count(uint_7_id), 1u);
+    EXPECT_EQ(ids.count(float_id), 0u);
+    EXPECT_EQ(ids.count(v4float_id), 0u);
+    EXPECT_EQ(ids.count(uint_1234_id), 0u);
+    for (const auto &inst : output.types_values_constants_) {
+        // The float constant goes with its type
+        EXPECT_NE(inst->Opcode(), spv::OpTypeFloat);
+        EXPECT_NE(inst->TypeId(), float_id);
+    }
+
+    spvtools::SpirvTools tools(kTargetEnv);
+    std::string validation_error;
+    tools.SetMessageConsumer([&validation_error](spv_message_level_t, const char *, const spv_position_t &, const char *message) {
+        validation_error += message;
+    });
+    EXPECT_TRUE(tools.Validate(instrumented)) << validation_error;
+}
@@ -380,3 +380,214 @@ TEST_F(NegativeDescriptorIndexing, SetLayoutBindings) {
     vk::CreateDescriptorSetLayout(m_device->handle(), &create_info, nullptr, &setLayout);
     m_errorMonitor->VerifyFound();
 }
+
+TEST_F(NegativeDescriptorIndexing, UpdateUnusedWhilePendingRevalidate) {
+    TEST_DESCRIPTION("Draw time validation must notice a single element changed after the set was already validated.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    AddRequiredExtensions(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    AddRequiredFeature(vkt::Feature::descriptorBindingUpdateUnusedWhilePending);
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    VkDescriptorBindingFlags binding_flags = VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flags_create_info = vku::InitStructHelper();
+    flags_create_info.bindingCount = 1;
+    flags_create_info.pBindingFlags = &binding_flags;
+
+    OneOffDescriptorSet descriptor_set(m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 4, VK_SHADER_STAGE_ALL, nullptr}}, 0,
+                                       &flags_create_info);
+    // Never written, used as the source of a copy to "un-update" a descriptor
+    OneOffDescriptorSet empty_set(m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 4, VK_SHADER_STAGE_ALL, nullptr}}, 0,
+                                  &flags_create_info);
+    const vkt::PipelineLayout pipeline_layout(*m_device, {&descriptor_set.layout_});
+
+    vkt::Buffer buffer(*m_device, 64, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+    for (uint32_t i = 0; i < 4; ++i) {
+        descriptor_set.WriteDescriptorBufferInfo(0, buffer.handle(), 0, VK_WHOLE_SIZE, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, i);
+    }
+    descriptor_set.UpdateDescriptorSets();
+
+    char const *fs_source = R"glsl(
+        #version 450
+        layout(location=0) out vec4 color;
+        layout(set=0, binding=0) uniform foo { float x; } bar[4];
+        void main(){
+           color = vec4(bar[0].x + bar[2].x);
+        }
+    )glsl";
+    VkShaderObj fs(this, fs_source, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    CreatePipelineHelper pipe(*this);
+    pipe.shader_stages_[1] = fs.GetStageCreateInfo();
+    pipe.gp_ci_.layout = pipeline_layout.handle();
+    pipe.CreateGraphicsPipeline();
+
+    m_command_buffer.begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.Handle());
+    vk::CmdBindDescriptorSets(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                              &descriptor_set.set_, 0, nullptr);
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+
+    VkCopyDescriptorSet copy = vku::InitStructHelper();
+    copy.srcSet = empty_set.set_;
+    copy.srcBinding = 0;
+    copy.srcArrayElement = 2;
+    copy.dstSet = descriptor_set.set_;
+    copy.dstBinding = 0;
+    copy.dstArrayElement = 2;
+    copy.descriptorCount = 1;
+    vk::UpdateDescriptorSets(device(), 0, nullptr, 1, &copy);
+
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-08114");
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+    m_errorMonitor->VerifyFound();
+
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.end();
+}
+
+TEST_F(NegativeDescriptorIndexing, UpdateUnusedWhilePendingPipelineSwitch) {
+    TEST_DESCRIPTION("Binding a pipeline that uses other descriptors must revalidate the whole set, not only the written ones.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    AddRequiredExtensions(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    AddRequiredFeature(vkt::Feature::descriptorBindingUpdateUnusedWhilePending);
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    VkDescriptorBindingFlags binding_flags = VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flags_create_info = vku::InitStructHelper();
+    flags_create_info.bindingCount = 1;
+    flags_create_info.pBindingFlags = &binding_flags;
+
+    OneOffDescriptorSet descriptor_set(m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 4, VK_SHADER_STAGE_ALL, nullptr}}, 0,
+                                       &flags_create_info);
+    const vkt::PipelineLayout pipeline_layout(*m_device, {&descriptor_set.layout_});
+
+    // Element 3 is never written
+    vkt::Buffer buffer(*m_device, 64, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+    descriptor_set.WriteDescriptorBufferInfo(0, buffer.handle(), 0, VK_WHOLE_SIZE, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0);
+    descriptor_set.UpdateDescriptorSets();
+
+    char const *fs_source_0 = R"glsl(
+        #version 450
+        layout(location=0) out vec4 color;
+        layout(set=0, binding=0) uniform foo { float x; } bar[4];
+        void main(){
+           color = vec4(bar[0].x);
+        }
+    )glsl";
+    char const *fs_source_3 = R"glsl(
+        #version 450
+        layout(location=0) out vec4 color;
+        layout(set=0, binding=0) uniform foo { float x; } bar[4];
+        void main(){
+           color = vec4(bar[3].x);
+        }
+    )glsl";
+    VkShaderObj fs_0(this, fs_source_0, VK_SHADER_STAGE_FRAGMENT_BIT);
+    VkShaderObj fs_3(this, fs_source_3, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    CreatePipelineHelper pipe_0(*this);
+    pipe_0.shader_stages_[1] = fs_0.GetStageCreateInfo();
+    pipe_0.gp_ci_.layout = pipeline_layout.handle();
+    pipe_0.CreateGraphicsPipeline();
+
+    CreatePipelineHelper pipe_3(*this);
+    pipe_3.shader_stages_[1] = fs_3.GetStageCreateInfo();
+    pipe_3.gp_ci_.layout = pipeline_layout.handle();
+    pipe_3.CreateGraphicsPipeline();
+
+    m_command_buffer.begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_0.Handle());
+    vk::CmdBindDescriptorSets(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                              &descriptor_set.set_, 0, nullptr);
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+
+    // Only element 1 is dirty now, but the new pipeline reads element 3
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe_3.Handle());
+    descriptor_set.Clear();
+    descriptor_set.WriteDescriptorBufferInfo(0, buffer.handle(), 0, VK_WHOLE_SIZE, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1);
+    descriptor_set.UpdateDescriptorSets();
+
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-08114");
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+    m_errorMonitor->VerifyFound();
+
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.end();
+}
+
+TEST_F(NegativeDescriptorIndexing, UpdateUnusedWhilePendingManyScatteredWrites) {
+    TEST_DESCRIPTION("More scattered writes than the dirty history holds must not hide an element changed after validation.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    AddRequiredExtensions(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    AddRequiredFeature(vkt::Feature::descriptorBindingUpdateUnusedWhilePending);
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    VkDescriptorBindingFlags binding_flags = VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flags_create_info = vku::InitStructHelper();
+    flags_create_info.bindingCount = 1;
+    flags_create_info.pBindingFlags = &binding_flags;
+
+    OneOffDescriptorSet descriptor_set(m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 32, VK_SHADER_STAGE_ALL, nullptr}}, 0,
+                                       &flags_create_info);
+    // Never written, used as the source of a copy to "un-update" a descriptor
+    OneOffDescriptorSet empty_set(m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 32, VK_SHADER_STAGE_ALL, nullptr}}, 0,
+                                  &flags_create_info);
+    const vkt::PipelineLayout pipeline_layout(*m_device, {&descriptor_set.layout_});
+
+    vkt::Buffer buffer(*m_device, 64, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+    for (uint32_t i = 0; i < 32; ++i) {
+        descriptor_set.WriteDescriptorBufferInfo(0, buffer.handle(), 0, VK_WHOLE_SIZE, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, i);
+    }
+    descriptor_set.UpdateDescriptorSets();
+
+    char const *fs_source = R"glsl(
+        #version 450
+        layout(location=0) out vec4 color;
+        layout(set=0, binding=0) uniform foo { float x; } bar[32];
+        void main(){
+           color = vec4(bar[1].x + bar[30].x);
+        }
+    )glsl";
+    VkShaderObj fs(this, fs_source, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    CreatePipelineHelper pipe(*this);
+    pipe.shader_stages_[1] = fs.GetStageCreateInfo();
+    pipe.gp_ci_.layout = pipeline_layout.handle();
+    pipe.CreateGraphicsPipeline();
+
+    m_command_buffer.begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.Handle());
+    vk::CmdBindDescriptorSets(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                              &descriptor_set.set_, 0, nullptr);
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+
+    VkCopyDescriptorSet copy = vku::InitStructHelper();
+    copy.srcSet = empty_set.set_;
+    copy.srcBinding = 0;
+    copy.dstSet = descriptor_set.set_;
+    copy.dstBinding = 0;
+    copy.descriptorCount = 1;
+
+    // Un-update an element the shader uses first, then bury it under more single element writes than the history can hold
+    copy.srcArrayElement = 1;
+    copy.dstArrayElement = 1;
+    vk::UpdateDescriptorSets(device(), 0, nullptr, 1, &copy);
+    for (uint32_t i = 4; i < 28; i += 2) {
+        descriptor_set.Clear();
+        descriptor_set.WriteDescriptorBufferInfo(0, buffer.handle(), 0, VK_WHOLE_SIZE, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, i);
+        descriptor_set.UpdateDescriptorSets();
+    }
+
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-08114");
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+    m_errorMonitor->VerifyFound();
+
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.end();
+}
@@ -1197,3 +1197,86 @@ TEST_F(PositiveDescriptors, ImageSubresourceOverlapBetweenRenderPassAndDescripto
     m_command_buffer.EndRenderPass();
     m_command_buffer.end();
 }
+
+TEST_F(PositiveDescriptors, UpdateTemplateConsecutiveBindings) {
+    TEST_DESCRIPTION("Template entries that roll over into the next binding, with both packed and padded strides.");
+    SetTargetApiVersion(VK_API_VERSION_1_1);
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    OneOffDescriptorSet descriptor_set(m_device, {
+                                                     {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2, VK_SHADER_STAGE_ALL, nullptr},
+                                                     {1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2, VK_SHADER_STAGE_ALL, nullptr},
+                                                     {2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3, VK_SHADER_STAGE_ALL, nullptr},
+                                                 });
+    const vkt::PipelineLayout pipeline_layout(*m_device, {&descriptor_set.layout_});
+    vkt::Buffer buffer(*m_device, 256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+
+    struct PaddedBufferInfo {
+        VkDescriptorBufferInfo info;
+        uint32_t padding;
+    };
+    struct TemplateData {
+        VkDescriptorBufferInfo packed[4];
+        PaddedBufferInfo padded[3];
+    } update_data;
+    for (auto &info : update_data.packed) {
+        info = {buffer.handle(), 0, VK_WHOLE_SIZE};
+    }
+    for (auto &padded : update_data.padded) {
+        padded.info = {buffer.handle(), 0, VK_WHOLE_SIZE};
+    }
+
+    VkDescriptorUpdateTemplateEntry entries[2];
+    // Writes all of binding 0 and rolls over into binding 1
+    entries[0].dstBinding = 0;
+    entries[0].dstArrayElement = 0;
+    entries[0].descriptorCount = 4;
+    entries[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    entries[0].offset = offsetof(TemplateData, packed);
+    entries[0].stride = sizeof(VkDescriptorBufferInfo);
+    entries[1].dstBinding = 2;
+    entries[1].dstArrayElement = 0;
+    entries[1].descriptorCount = 3;
+    entries[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    entries[1].offset = offsetof(TemplateData, padded);
+    entries[1].stride = sizeof(PaddedBufferInfo);
+
+    VkDescriptorUpdateTemplateCreateInfo update_template_ci = vku::InitStructHelper();
+    update_template_ci.descriptorUpdateEntryCount = 2;
+    update_template_ci.pDescriptorUpdateEntries = entries;
+    update_template_ci.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    update_template_ci.descriptorSetLayout = descriptor_set.layout_.handle();
+    VkDescriptorUpdateTemplate update_template = VK_NULL_HANDLE;
+    vk::CreateDescriptorUpdateTemplate(device(), &update_template_ci, nullptr, &update_template);
+
+    vk::UpdateDescriptorSetWithTemplate(device(), descriptor_set.set_, update_template, &update_data);
+
+    char const *fs_source = R"glsl(
+        #version 450
+        layout(location=0) out vec4 color;
+        layout(set=0, binding=0) uniform foo0 { float x; } bar0[2];
+        layout(set=0, binding=1) uniform foo1 { float x; } bar1[2];
+        layout(set=0, binding=2) uniform foo2 { float x; } bar2[3];
+        void main(){
+           color = vec4(bar0[1].x + bar1[1].x + bar2[2].x);
+        }
+    )glsl";
+    VkShaderObj fs(this, fs_source, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    CreatePipelineHelper pipe(*this);
+    pipe.shader_stages_[1] = fs.GetStageCreateInfo();
+    pipe.gp_ci_.layout = pipeline_layout.handle();
+    pipe.CreateGraphicsPipeline();
+
+    m_command_buffer.begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.Handle());
+    vk::CmdBindDescriptorSets(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                              &descriptor_set.set_, 0, nullptr);
+    vk::CmdDraw(m_command_buffer.handle(), 3, 1, 0, 0);
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.end();
+
+    vk::DestroyDescriptorUpdateTemplate(device(), update_template, nullptr);
+}
@@ -1121,6 +1121,71 @@ TEST_F(NegativeGpuAVOOB, Matrix) {
     ComputeStorageBufferTest("VUID-vkCmdDispatch-storageBuffers-06936", cs_source, 30);
 }
 
+TEST_F(NegativeGpuAVOOB, ComputePipelineBatch) {
+    TEST_DESCRIPTION("Shaders of several pipelines created in one call are instrumented together");
+    SetTargetApiVersion(VK_API_VERSION_1_2);
+    AddDisabledFeature(vkt::Feature::robustBufferAccess);
+    RETURN_IF_SKIP(InitGpuAvFramework());
+    RETURN_IF_SKIP(InitState());
+
+    char const *valid_source = R"glsl(
+        #version 450
+        layout(set = 0, binding = 0, std430) buffer foo {
+            float a[4];
+        } in_buffer;
+
+        void main() {
+            in_buffer.a[1] = 0.0;
+        }
+    )glsl";
+    char const *oob_source = R"glsl(
+        #version 450
+        layout(set = 0, binding = 0, std430) buffer foo {
+            float a[4];
+        } in_buffer;
+
+        void main() {
+            in_buffer.a[3] = 0.0;
+        }
+    )glsl";
+
+    CreateComputePipelineHelper pipe(*this);
+    pipe.dsl_bindings_ = {{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr}};
+    pipe.cs_ = std::make_unique<VkShaderObj>(this, valid_source, VK_SHADER_STAGE_COMPUTE_BIT, SPV_ENV_VULKAN_1_2);
+    pipe.LateBindPipelineInfo();
+    VkShaderObj oob_cs(this, oob_source, VK_SHADER_STAGE_COMPUTE_BIT, SPV_ENV_VULKAN_1_2);
+
+    VkComputePipelineCreateInfo oob_ci = pipe.cp_ci_;
+    oob_ci.stage = oob_cs.GetStageCreateInfo();
+    VkComputePipelineCreateInfo create_infos[4] = {oob_ci, pipe.cp_ci_, oob_ci, pipe.cp_ci_};
+    VkPipeline pipelines[4];
+    ASSERT_EQ(VK_SUCCESS, vk::CreateComputePipelines(device(), VK_NULL_HANDLE, 4, create_infos, nullptr, pipelines));
+
+    // too small for a[3]
+    vkt::Buffer in_buffer(*m_device, 8, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    pipe.descriptor_set_->WriteDescriptorBufferInfo(0, in_buffer.handle(), 0, VK_WHOLE_SIZE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    pipe.descriptor_set_->UpdateDescriptorSets();
+
+    m_command_buffer.begin();
+    vk::CmdBindDescriptorSets(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipe.pipeline_layout_.handle(), 0, 1,
+                              &pipe.descriptor_set_->set_, 0, nullptr);
+    for (VkPipeline pipeline : pipelines) {
+        vk::CmdBindPipeline(m_command_buffer.handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vk::CmdDispatch(m_command_buffer.handle(), 1, 1, 1);
+    }
+    m_command_buffer.end();
+
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDispatch-storageBuffers-06936", 2);
+    m_default_queue->Submit(m_command_buffer);
+    m_default_queue->Wait();
+    m_errorMonitor->VerifyFound();
+
+    for (VkPipeline pipeline : pipelines) {
+        vk::DestroyPipeline(device(), pipeline, nullptr);
+    }
+}
+
 TEST_F(NegativeGpuAVOOB, TexelFetch) {
     TEST_DESCRIPTION("index into a texelFetch OOB");
     SetTargetApiVersion(VK_API_VERSION_1_2);
@@ -694,4 +694,51 @@ TEST_F(VkPositiveLayerTest, UnrecognizedFlagOutOfRange2) {
     format_info.type = VK_IMAGE_TYPE_1D;
     format_info.usage = static_cast<VkImageUsageFlags>(0xffffffff);
     vk::GetPhysicalDeviceImageFormatProperties2(gpu(), &format_info, &format_properties);
-}
\ No newline at end of file
+}
+
+TEST_F(VkPositiveLayerTest, ValidationCacheRoundTrip) {
+    TEST_DESCRIPTION("Shaders validated into a cache are kept when the data is loaded into and merged with other caches");
+    AddRequiredExtensions(VK_EXT_VALIDATION_CACHE_EXTENSION_NAME);
+    RETURN_IF_SKIP(Init());
+
+    VkValidationCacheCreateInfoEXT cache_ci = vku::InitStructHelper();
+    VkValidationCacheEXT cache = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &cache_ci, nullptr, &cache));
+
+    VkShaderModuleValidationCacheCreateInfoEXT module_cache_ci = vku::InitStructHelper();
+    module_cache_ci.validationCache = cache;
+    const std::vector<uint32_t> spirv = GLSLToSPV(VK_SHADER_STAGE_COMPUTE_BIT, kMinimalShaderGlsl);
+    VkShaderModuleCreateInfo module_ci = vku::InitStructHelper(&module_cache_ci);
+    module_ci.codeSize = spirv.size() * sizeof(uint32_t);
+    module_ci.pCode = spirv.data();
+    vkt::ShaderModule module(*m_device, module_ci);
+
+    size_t data_size = 0;
+    vk::GetValidationCacheDataEXT(device(), cache, &data_size, nullptr);
+    std::vector<uint8_t> data(data_size);
+    ASSERT_EQ(VK_SUCCESS, vk::GetValidationCacheDataEXT(device(), cache, &data_size, data.data()));
+
+    // Header plus one 128-bit key
+    const size_t header_size = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+    ASSERT_EQ(data_size, header_size + 16u);
+
+    cache_ci.initialDataSize = data.size();
+    cache_ci.pInitialData = data.data();
+    VkValidationCacheEXT loaded_cache = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &cache_ci, nullptr, &loaded_cache));
+
+    cache_ci.initialDataSize = 0;
+    cache_ci.pInitialData = nullptr;
+    VkValidationCacheEXT merged_cache = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &cache_ci, nullptr, &merged_cache));
+    const VkValidationCacheEXT src_caches[2] = {cache, loaded_cache};
+    ASSERT_EQ(VK_SUCCESS, vk::MergeValidationCachesEXT(device(), merged_cache, 2, src_caches));
+
+    size_t merged_size = 0;
+    vk::GetValidationCacheDataEXT(device(), merged_cache, &merged_size, nullptr);
+    ASSERT_EQ(merged_size, data_size);
+
+    vk::DestroyValidationCacheEXT(device(), merged_cache, nullptr);
+    vk::DestroyValidationCacheEXT(device(), loaded_cache, nullptr);
+    vk::DestroyValidationCacheEXT(device(), cache, nullptr);
+}
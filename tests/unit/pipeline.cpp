@@ -996,6 +996,160 @@ TEST_F(NegativePipeline, MissingEntrypoint) {
     }
 }
 
+TEST_F(NegativePipeline, ParallelPipelineValidation) {
+    TEST_DESCRIPTION("Errors from several create infos validated in parallel are all reported");
+    const VkBool32 value = true;
+    const VkLayerSettingEXT setting = {OBJECT_LAYER_NAME, "parallel_pipeline_validation", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1,
+                                       &value};
+    VkLayerSettingsCreateInfoEXT layer_settings_create_info = {VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, 1,
+                                                               &setting};
+    RETURN_IF_SKIP(InitFramework(&layer_settings_create_info));
+    RETURN_IF_SKIP(InitState());
+
+    CreateComputePipelineHelper valid_pipe(*this);
+    valid_pipe.LateBindPipelineInfo();
+    CreateComputePipelineHelper invalid_pipe(*this);
+    invalid_pipe.cs_ = std::make_unique<VkShaderObj>(this, kMinimalShaderGlsl, VK_SHADER_STAGE_COMPUTE_BIT, SPV_ENV_VULKAN_1_0,
+                                                     SPV_SOURCE_GLSL, nullptr, "foo");
+    invalid_pipe.LateBindPipelineInfo();
+
+    VkComputePipelineCreateInfo create_infos[4] = {invalid_pipe.cp_ci_, valid_pipe.cp_ci_, invalid_pipe.cp_ci_,
+                                                   valid_pipe.cp_ci_};
+    VkPipeline pipelines[4];
+    m_errorMonitor->SetDesiredError("VUID-VkPipelineShaderStageCreateInfo-pName-00707", 2);
+    vk::CreateComputePipelines(device(), VK_NULL_HANDLE, 4, create_infos, nullptr, pipelines);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(NegativePipeline, ParallelPipelineValidationMatchesSerial) {
+    TEST_DESCRIPTION("A broken stage reports the same messages whether its create info is validated alone or in parallel");
+    const VkBool32 value = true;
+    const VkLayerSettingEXT setting = {OBJECT_LAYER_NAME, "parallel_pipeline_validation", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1,
+                                       &value};
+    VkLayerSettingsCreateInfoEXT layer_settings_create_info = {VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, 1,
+                                                               &setting};
+    RETURN_IF_SKIP(InitFramework(&layer_settings_create_info));
+    RETURN_IF_SKIP(InitState());
+    InitRenderTarget();
+
+    // Both locations mismatch, but only the first one is reported
+    char const *vsSource = R"glsl(
+        #version 450
+        layout(location=0) out int x;
+        layout(location=1) out int y;
+        void main(){
+           x = 0;
+           y = 0;
+           gl_Position = vec4(1);
+        }
+    )glsl";
+    char const *fsSource = R"glsl(
+        #version 450
+        layout(location=0) in float x;
+        layout(location=1) in float y;
+        layout(location=0) out vec4 color;
+        void main(){
+           color = vec4(x, y, 0, 0);
+        }
+    )glsl";
+    VkShaderObj vs(this, vsSource, VK_SHADER_STAGE_VERTEX_BIT);
+    VkShaderObj fs(this, fsSource, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    CreatePipelineHelper valid_pipe(*this);
+    valid_pipe.LateBindPipelineInfo();
+    CreatePipelineHelper broken_pipe(*this);
+    broken_pipe.shader_stages_ = {vs.GetStageCreateInfo(), fs.GetStageCreateInfo()};
+    broken_pipe.LateBindPipelineInfo();
+
+    // A single create info is validated on the calling thread
+    VkPipeline pipeline;
+    m_errorMonitor->SetDesiredError("VUID-RuntimeSpirv-OpEntryPoint-07754");
+    vk::CreateGraphicsPipelines(device(), VK_NULL_HANDLE, 1, &broken_pipe.gp_ci_, nullptr, &pipeline);
+    m_errorMonitor->VerifyFound();
+
+    VkGraphicsPipelineCreateInfo create_infos[3] = {broken_pipe.gp_ci_, valid_pipe.gp_ci_, broken_pipe.gp_ci_};
+    VkPipeline pipelines[3];
+    m_errorMonitor->SetDesiredError("VUID-RuntimeSpirv-OpEntryPoint-07754", 2);
+    vk::CreateGraphicsPipelines(device(), VK_NULL_HANDLE, 3, create_infos, nullptr, pipelines);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(NegativePipeline, ParallelPipelineValidationCallbackDoesNotSkip) {
+    TEST_DESCRIPTION("When the callbacks don't ask to skip, validating in parallel keeps going as far as serial validation does");
+    const VkBool32 value = true;
+    const VkLayerSettingEXT setting = {OBJECT_LAYER_NAME, "parallel_pipeline_validation", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1,
+                                       &value};
+    VkLayerSettingsCreateInfoEXT layer_settings_create_info = {VK_STRUCTURE_TYPE_LAYER_SETTINGS_CREATE_INFO_EXT, nullptr, 1,
+                                                               &setting};
+    AddRequiredExtensions(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    RETURN_IF_SKIP(InitFramework(&layer_settings_create_info));
+    RETURN_IF_SKIP(InitState());
+    InitRenderTarget();
+
+    // Both callbacks return VK_FALSE for these, so both mismatched locations are reported
+    m_errorMonitor->SetAllowedFailureMsg("VUID-RuntimeSpirv-OpEntryPoint-07754");
+    DebugUtilsLabelCheckData callback_data;
+    callback_data.count = 0;
+    callback_data.callback = [](const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData, DebugUtilsLabelCheckData *data) {
+        if (strstr(pCallbackData->pMessageIdName, "VUID-RuntimeSpirv-OpEntryPoint-07754")) {
+            data->count++;
+        }
+    };
+    VkDebugUtilsMessengerCreateInfoEXT callback_create_info = vku::InitStructHelper();
+    callback_create_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    callback_create_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+    callback_create_info.pfnUserCallback = DebugUtilsCallback;
+    callback_create_info.pUserData = &callback_data;
+    VkDebugUtilsMessengerEXT messenger = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateDebugUtilsMessengerEXT(instance(), &callback_create_info, nullptr, &messenger));
+
+    char const *vsSource = R"glsl(
+        #version 450
+        layout(location=0) out int x;
+        layout(location=1) out int y;
+        void main(){
+           x = 0;
+           y = 0;
+           gl_Position = vec4(1);
+        }
+    )glsl";
+    char const *fsSource = R"glsl(
+        #version 450
+        layout(location=0) in float x;
+        layout(location=1) in float y;
+        layout(location=0) out vec4 color;
+        void main(){
+           color = vec4(x, y, 0, 0);
+        }
+    )glsl";
+    VkShaderObj vs(this, vsSource, VK_SHADER_STAGE_VERTEX_BIT);
+    VkShaderObj fs(this, fsSource, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    CreatePipelineHelper valid_pipe(*this);
+    valid_pipe.LateBindPipelineInfo();
+    CreatePipelineHelper broken_pipe(*this);
+    broken_pipe.shader_stages_ = {vs.GetStageCreateInfo(), fs.GetStageCreateInfo()};
+    broken_pipe.LateBindPipelineInfo();
+
+    // A single create info is validated on the calling thread
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    vk::CreateGraphicsPipelines(device(), VK_NULL_HANDLE, 1, &broken_pipe.gp_ci_, nullptr, &pipeline);
+    const size_t serial_count = callback_data.count;
+    ASSERT_EQ(serial_count, 2u);
+    vk::DestroyPipeline(device(), pipeline, nullptr);
+
+    callback_data.count = 0;
+    VkGraphicsPipelineCreateInfo create_infos[3] = {broken_pipe.gp_ci_, valid_pipe.gp_ci_, broken_pipe.gp_ci_};
+    VkPipeline pipelines[3] = {};
+    vk::CreateGraphicsPipelines(device(), VK_NULL_HANDLE, 3, create_infos, nullptr, pipelines);
+    ASSERT_EQ(callback_data.count, 2 * serial_count);
+    for (VkPipeline created : pipelines) {
+        vk::DestroyPipeline(device(), created, nullptr);
+    }
+
+    vk::DestroyDebugUtilsMessengerEXT(instance(), messenger, nullptr);
+}
+
 TEST_F(NegativePipeline, DepthStencilRequired) {
     m_errorMonitor->SetDesiredError("VUID-VkGraphicsPipelineCreateInfo-renderPass-09028");
 
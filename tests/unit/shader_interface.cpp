@@ -366,6 +366,35 @@ TEST_F(NegativeShaderInterface, FragmentInputNotProvided) {
     CreatePipelineHelper::OneshotTest(*this, set_info, kErrorBit, "VUID-RuntimeSpirv-OpEntryPoint-08743");
 }
 
+TEST_F(NegativeShaderInterface, FragmentInputNotProvidedRepeated) {
+    TEST_DESCRIPTION("Interface mismatches are reported for every pipeline using the same pair of shaders");
+
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    char const *fsSource = R"glsl(
+        #version 450
+        layout(location=0) in float x;
+        layout(location=0) out vec4 color;
+        void main(){
+           color = vec4(x);
+        }
+    )glsl";
+    VkShaderObj fs(this, fsSource, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    const auto set_info = [&](CreatePipelineHelper &helper) {
+        helper.shader_stages_ = {helper.vs_->GetStageCreateInfo(), fs.GetStageCreateInfo()};
+    };
+    CreatePipelineHelper::OneshotTest(*this, set_info, kErrorBit, "VUID-RuntimeSpirv-OpEntryPoint-08743");
+    CreatePipelineHelper::OneshotTest(*this, set_info, kErrorBit, "VUID-RuntimeSpirv-OpEntryPoint-08743");
+
+    // A matching pair is remembered, using it again is still fine
+    CreatePipelineHelper pipe(*this);
+    pipe.CreateGraphicsPipeline();
+    CreatePipelineHelper pipe2(*this);
+    pipe2.CreateGraphicsPipeline();
+}
+
 TEST_F(NegativeShaderInterface, FragmentInputNotProvidedInBlock) {
     TEST_DESCRIPTION(
         "Test that an error is produced for a fragment shader input within an interface block, which is not present in the outputs "
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "containers/callback_stream.h"
+
+TEST(CustomContainer, CallbackStreamOrder) {
+    vvl::BumpArena arena;
+    vvl::CallbackStream<void(std::vector<int> &)> stream(arena);
+    for (int i = 0; i < 1000; ++i) {
+        stream.emplace_back([i](std::vector<int> &out) { out.push_back(i); });
+    }
+    ASSERT_EQ(stream.size(), 1000u);
+
+    std::vector<int> out;
+    for (const auto &callback : stream) {
+        callback(out);
+    }
+    ASSERT_EQ(out.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(out[i], i);
+    }
+}
+
+TEST(CustomContainer, CallbackStreamLargeCapture) {
+    vvl::BumpArena arena(64);
+    vvl::CallbackStream<int()> stream(arena);
+    std::array<int, 256> values{};
+    values[255] = 42;
+    stream.emplace_back([values]() { return values[255]; });
+    stream.emplace_back([]() { return 7; });
+
+    std::vector<int> results;
+    for (const auto &callback : stream) {
+        results.push_back(callback());
+    }
+    ASSERT_EQ(results, (std::vector<int>{42, 7}));
+}
+
+TEST(CustomContainer, CallbackStreamDestroysCaptures) {
+    vvl::BumpArena arena;
+    auto shared = std::make_shared<int>(1);
+    {
+        vvl::CallbackStream<int()> stream(arena);
+        stream.emplace_back([shared]() { return *shared; });
+        ASSERT_EQ(shared.use_count(), 2);
+        stream.clear();
+        ASSERT_EQ(shared.use_count(), 1);
+        ASSERT_TRUE(stream.empty());
+
+        stream.emplace_back([shared]() { return *shared; });
+        ASSERT_EQ(shared.use_count(), 2);
+    }
+    ASSERT_EQ(shared.use_count(), 1);
+    arena.Reset();
+}
+
+TEST(CustomContainer, CallbackStreamAppendSplice) {
+    vvl::BumpArena arena;
+    vvl::BumpArena other_arena;
+    vvl::CallbackStream<void(std::vector<int> &)> a(arena);
+    vvl::CallbackStream<void(std::vector<int> &)> b(arena);
+    vvl::CallbackStream<void(std::vector<int> &)> c(other_arena);
+
+    a.emplace_back([](std::vector<int> &out) { out.push_back(0); });
+    b.emplace_back([](std::vector<int> &out) { out.push_back(1); });
+    c.emplace_back([](std::vector<int> &out) { out.push_back(2); });
+
+    a.Splice(b);
+    ASSERT_TRUE(b.empty());
+    a.Append(c);
+    ASSERT_EQ(c.size(), 1u);
+    ASSERT_EQ(a.size(), 3u);
+
+    std::vector<int> out;
+    for (const auto &callback : a) {
+        callback(out);
+    }
+    ASSERT_EQ(out, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(CustomContainer, BumpArenaResetKeepsHighWater) {
+    vvl::BumpArena arena(256);
+    for (int i = 0; i < 16; ++i) {
+        arena.Allocate(128, 8);
+    }
+    const size_t reserved = arena.BytesReserved();
+    ASSERT_EQ(reserved, 8u * 256u);
+
+    // Same amount of data again, no new blocks are needed
+    arena.Reset();
+    for (int i = 0; i < 16; ++i) {
+        arena.Allocate(128, 8);
+    }
+    ASSERT_EQ(arena.BytesReserved(), reserved);
+
+    // A smaller cycle only lets go of part of the blocks it didn't need
+    arena.Reset();
+    arena.Allocate(128, 8);
+    arena.Reset();
+    ASSERT_EQ(arena.BytesReserved(), 6u * 256u);
+
+    // Going back to the larger cycle regrows only what was let go
+    for (int i = 0; i < 16; ++i) {
+        arena.Allocate(128, 8);
+    }
+    arena.Reset();
+    ASSERT_EQ(arena.BytesReserved(), reserved);
+
+    // Small cycles in a row decay towards what they use
+    for (int cycle = 0; cycle < 5; ++cycle) {
+        arena.Allocate(128, 8);
+        arena.Reset();
+    }
+    ASSERT_EQ(arena.BytesReserved(), 256u);
+
+    // Back to back resets don't trim
+    arena.Reset();
+    ASSERT_EQ(arena.BytesReserved(), 256u);
+
+    // Oversized requests are counted until the next reset frees them
+    arena.Allocate(1024, 8);
+    ASSERT_EQ(arena.BytesReserved(), 256u + 1024u + 7u);
+    arena.Reset();
+    ASSERT_EQ(arena.BytesReserved(), 256u);
+
+    arena.Release();
+    ASSERT_EQ(arena.BytesReserved(), 0u);
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <spirv-tools/libspirv.hpp>
+
+#include "state_tracker/shader_module.h"
+
+static std::string ReflectionCacheTestPath(const char *name) {
+    const std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::remove(path.c_str());
+    return path;
+}
+
+// A sampled image read in the entry point, and a storage image read and written from a function it calls
+static std::vector<uint32_t> ReflectionTestShader() {
+    spvtools::SpirvTools tools(SPV_ENV_VULKAN_1_0);
+    std::vector<uint32_t> words;
+    EXPECT_TRUE(tools.Assemble(R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint GLCompute %main "main"
+               OpExecutionMode %main LocalSize 1 1 1
+               OpDecorate %sampled DescriptorSet 0
+               OpDecorate %sampled Binding 0
+               OpDecorate %storage DescriptorSet 0
+               OpDecorate %storage Binding 1
+               OpDecorate %unused DescriptorSet 0
+               OpDecorate %unused Binding 2
+       %void = OpTypeVoid
+       %func = OpTypeFunction %void
+      %float = OpTypeFloat 32
+        %int = OpTypeInt 32 1
+    %v2float = OpTypeVector %float 2
+    %v4float = OpTypeVector %float 4
+      %v2int = OpTypeVector %int 2
+    %float_0 = OpConstant %float 0
+      %int_0 = OpConstant %int 0
+  %v2float_0 = OpConstantComposite %v2float %float_0 %float_0
+    %v2int_0 = OpConstantComposite %v2int %int_0 %int_0
+   %image_2d = OpTypeImage %float 2D 0 0 0 1 Unknown
+ %sampled_2d = OpTypeSampledImage %image_2d
+%ptr_sampled = OpTypePointer UniformConstant %sampled_2d
+ %storage_2d = OpTypeImage %float 2D 0 0 0 2 R32f
+%ptr_storage = OpTypePointer UniformConstant %storage_2d
+    %sampled = OpVariable %ptr_sampled UniformConstant
+    %storage = OpVariable %ptr_storage UniformConstant
+     %unused = OpVariable %ptr_storage UniformConstant
+       %main = OpFunction %void None %func
+      %entry = OpLabel
+%load_sampled = OpLoad %sampled_2d %sampled
+      %texel = OpImageSampleExplicitLod %v4float %load_sampled %v2float_0 Lod %float_0
+       %call = OpFunctionCall %void %write_storage
+               OpReturn
+               OpFunctionEnd
+%write_storage = OpFunction %void None %func
+%write_entry = OpLabel
+%load_storage = OpLoad %storage_2d %storage
+       %read = OpImageRead %v4float %load_storage %v2int_0
+               OpImageWrite %load_storage %v2int_0 %read
+               OpReturn
+               OpFunctionEnd
+    )",
+                               &words));
+    return words;
+}
+
+static void ExpectSameInstructions(const std::vector<const spirv::Instruction *> &a,
+                                   const std::vector<const spirv::Instruction *> &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i]->ResultId(), b[i]->ResultId());
+    }
+}
+
+TEST(ShaderReflectionCache, RestoresEntryPointsAndImageAccesses) {
+    const std::string path = ReflectionCacheTestPath("vvl_shader_reflection_cache.bin");
+    const std::vector<uint32_t> spirv = ReflectionTestShader();
+    ASSERT_FALSE(spirv.empty());
+    const size_t code_size = spirv.size() * sizeof(uint32_t);
+    const hash_util::Hash128 key = hash_util::ShaderHash128(spirv.data(), code_size);
+
+    // Computed from scratch, the record is only encoded once the image accesses are walked
+    auto cache = std::make_shared<spirv::StaticDataCache>();
+    cache->LoadReflection(path);
+    spirv::StatelessData stateless_data;
+    const spirv::Module computed(code_size, spirv.data(), &stateless_data, cache.get());
+    ASSERT_EQ(cache->FindReflection(key), nullptr);
+    const spirv::ImageAccessMap &computed_accesses = computed.static_data_.GetImageAccessMap(computed);
+    ASSERT_NE(cache->FindReflection(key), nullptr);
+    ASSERT_TRUE(cache->SaveReflection(path));
+
+    // The next run of the application
+    auto reloaded_cache = std::make_shared<spirv::StaticDataCache>();
+    reloaded_cache->LoadReflection(path);
+    const auto record = reloaded_cache->FindReflection(key);
+    ASSERT_NE(record, nullptr);
+    spirv::StatelessData reloaded_stateless_data;
+    const spirv::Module restored(code_size, spirv.data(), &reloaded_stateless_data, reloaded_cache.get());
+    const spirv::ImageAccessMap &restored_accesses = restored.static_data_.GetImageAccessMap(restored);
+    // A record that failed to decode would have been computed and encoded again
+    ASSERT_EQ(reloaded_cache->FindReflection(key), record);
+
+    const auto &computed_entry_points = computed.static_data_.entry_points;
+    const auto &restored_entry_points = restored.static_data_.entry_points;
+    ASSERT_EQ(computed_entry_points.size(), 1u);
+    ASSERT_EQ(computed_entry_points.size(), restored_entry_points.size());
+    for (size_t i = 0; i < computed_entry_points.size(); ++i) {
+        EXPECT_EQ(computed_entry_points[i]->name, restored_entry_points[i]->name);
+        EXPECT_EQ(computed_entry_points[i]->emit_vertex_geometry, restored_entry_points[i]->emit_vertex_geometry);
+        EXPECT_EQ(computed_entry_points[i]->accessible_ids, restored_entry_points[i]->accessible_ids);
+    }
+
+    // Both images are accessed, the unused one isn't
+    ASSERT_EQ(computed_accesses.size(), 2u);
+    ASSERT_EQ(computed_accesses.size(), restored_accesses.size());
+    for (const auto &[variable_id, computed_list] : computed_accesses) {
+        auto restored_it = restored_accesses.find(variable_id);
+        ASSERT_NE(restored_it, restored_accesses.end());
+        const auto &restored_list = restored_it->second;
+        ASSERT_EQ(computed_list.size(), restored_list.size());
+        for (size_t i = 0; i < computed_list.size(); ++i) {
+            const spirv::ImageAccess &a = *computed_list[i];
+            const spirv::ImageAccess &b = *restored_list[i];
+            EXPECT_EQ(a.image_insn.ResultId(), b.image_insn.ResultId());
+            EXPECT_EQ(a.image_insn.Opcode(), b.image_insn.Opcode());
+            ExpectSameInstructions(a.variable_image_insn, b.variable_image_insn);
+            ExpectSameInstructions(a.variable_sampler_insn, b.variable_sampler_insn);
+            EXPECT_EQ(a.valid_access, b.valid_access);
+            EXPECT_EQ(a.is_dref, b.is_dref);
+            EXPECT_EQ(a.is_sampler_implicitLod_dref_proj, b.is_sampler_implicitLod_dref_proj);
+            EXPECT_EQ(a.is_sampler_sampled, b.is_sampler_sampled);
+            EXPECT_EQ(a.is_not_sampler_sampled, b.is_not_sampler_sampled);
+            EXPECT_EQ(a.is_sampler_bias_offset, b.is_sampler_bias_offset);
+            EXPECT_EQ(a.is_sampler_offset, b.is_sampler_offset);
+            EXPECT_EQ(a.is_sign_extended, b.is_sign_extended);
+            EXPECT_EQ(a.is_zero_extended, b.is_zero_extended);
+            EXPECT_EQ(a.access_mask, b.access_mask);
+            EXPECT_EQ(a.image_access_chain_index, b.image_access_chain_index);
+            EXPECT_EQ(a.sampler_access_chain_index, b.sampler_access_chain_index);
+            EXPECT_EQ(a.texel_component_count, b.texel_component_count);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(ShaderReflectionCache, IgnoresRecordsFromOtherBuilds) {
+    const std::string path = ReflectionCacheTestPath("vvl_shader_reflection_cache_build.bin");
+    const std::vector<uint32_t> spirv = ReflectionTestShader();
+    ASSERT_FALSE(spirv.empty());
+    const size_t code_size = spirv.size() * sizeof(uint32_t);
+    const hash_util::Hash128 key = hash_util::ShaderHash128(spirv.data(), code_size);
+    {
+        auto cache = std::make_shared<spirv::StaticDataCache>();
+        cache->LoadReflection(path);
+        spirv::StatelessData stateless_data;
+        const spirv::Module module(code_size, spirv.data(), &stateless_data, cache.get());
+        module.static_data_.GetImageAccessMap(module);
+        ASSERT_TRUE(cache->SaveReflection(path));
+    }
+    {
+        // The build key follows the magic
+        std::fstream file(path.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t other_build = 0;
+        file.seekp(sizeof(uint32_t));
+        file.write(reinterpret_cast<const char *>(&other_build), sizeof(other_build));
+    }
+
+    auto cache = std::make_shared<spirv::StaticDataCache>();
+    cache->LoadReflection(path);
+    ASSERT_EQ(cache->FindReflection(key), nullptr);
+    std::remove(path.c_str());
+}
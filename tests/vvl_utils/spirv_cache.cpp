@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "utils/hash_util.h"
+#include "utils/spirv_cache.h"
+
+static std::string SpirvCacheTestPath(const char *name) {
+    const std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::remove(path.c_str());
+    return path;
+}
+
+TEST(SpirvCache, PersistsAcrossInstances) {
+    const std::string path = SpirvCacheTestPath("vvl_spirv_cache_persist.bin");
+    const std::vector<uint32_t> spirv = {0x07230203, 0x00010000, 1, 2, 3, 4};
+    uint64_t key = 0;
+    {
+        vvl::SpirvCache cache;
+        cache.SetKeySeed(42);
+        ASSERT_TRUE(cache.AttachFile(path));
+        key = cache.MakeKey(spirv.data(), spirv.size() * sizeof(uint32_t));
+        cache.Add(key, spirv);
+    }
+
+    vvl::SpirvCache cache;
+    cache.SetKeySeed(42);
+    ASSERT_TRUE(cache.AttachFile(path));
+    ASSERT_EQ(key, cache.MakeKey(spirv.data(), spirv.size() * sizeof(uint32_t)));
+    std::vector<uint32_t> read_spirv;
+    ASSERT_TRUE(cache.Get(key, read_spirv));
+    ASSERT_EQ(spirv, read_spirv);
+    ASSERT_FALSE(cache.Get(key + 1, read_spirv));
+    std::remove(path.c_str());
+}
+
+TEST(SpirvCache, RecoversFromTornTail) {
+    const std::string path = SpirvCacheTestPath("vvl_spirv_cache_torn.bin");
+    const std::vector<uint32_t> first = {0x07230203, 0x00010000, 10, 11};
+    const std::vector<uint32_t> second = {0x07230203, 0x00010000, 20, 21, 22};
+    {
+        vvl::SpirvCache cache;
+        ASSERT_TRUE(cache.AttachFile(path));
+        cache.Add(1, first);
+    }
+    {
+        // A writer that crashed part way through a record: a header claiming more SPIR-V than follows
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+        const uint64_t key = 3;
+        const uint32_t dword_count = 64;
+        const uint32_t checksum = 0;
+        file.write(reinterpret_cast<const char *>(&key), sizeof(key));
+        file.write(reinterpret_cast<const char *>(&dword_count), sizeof(dword_count));
+        file.write(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+        file.write(reinterpret_cast<const char *>(second.data()), 3 * sizeof(uint32_t));
+    }
+    {
+        vvl::SpirvCache cache;
+        ASSERT_TRUE(cache.AttachFile(path));
+        std::vector<uint32_t> read_spirv;
+        ASSERT_TRUE(cache.Get(1, read_spirv));
+        ASSERT_EQ(first, read_spirv);
+        ASSERT_FALSE(cache.Get(3, read_spirv));
+        // Appended where the torn record was cut off
+        cache.Add(2, second);
+        ASSERT_TRUE(cache.Get(2, read_spirv));
+        ASSERT_EQ(second, read_spirv);
+    }
+
+    vvl::SpirvCache cache;
+    ASSERT_TRUE(cache.AttachFile(path));
+    std::vector<uint32_t> read_spirv;
+    ASSERT_TRUE(cache.Get(1, read_spirv));
+    ASSERT_EQ(first, read_spirv);
+    ASSERT_TRUE(cache.Get(2, read_spirv));
+    ASSERT_EQ(second, read_spirv);
+    std::remove(path.c_str());
+}
+
+TEST(SpirvCache, CompactsDuplicateRecords) {
+    const std::string path = SpirvCacheTestPath("vvl_spirv_cache_compact.bin");
+    const std::vector<uint32_t> spirv = {0x07230203, 0x00010000, 30, 31, 32};
+    const std::vector<uint32_t> other_spirv = {0x07230203, 0x00010000, 40};
+    vvl::SpirvCache attached_cache;
+    {
+        vvl::SpirvCache cache;
+        ASSERT_TRUE(cache.AttachFile(path));
+        cache.Add(1, spirv);
+        cache.Add(2, other_spirv);
+        ASSERT_TRUE(attached_cache.AttachFile(path));
+    }
+    {
+        // Records that went missing and were appended again, over and over
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+        const uint64_t key = 1;
+        const uint32_t dword_count = static_cast<uint32_t>(spirv.size());
+        const uint32_t checksum = hash_util::ShaderHash(spirv.data(), spirv.size() * sizeof(uint32_t));
+        for (uint32_t i = 0; i < 256; ++i) {
+            file.write(reinterpret_cast<const char *>(&key), sizeof(key));
+            file.write(reinterpret_cast<const char *>(&dword_count), sizeof(dword_count));
+            file.write(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+            file.write(reinterpret_cast<const char *>(spirv.data()), spirv.size() * sizeof(uint32_t));
+        }
+    }
+    const auto duplicated_size = std::filesystem::file_size(path);
+
+    vvl::SpirvCache cache;
+    ASSERT_TRUE(cache.AttachFile(path));
+    ASSERT_LT(std::filesystem::file_size(path), duplicated_size);
+    std::vector<uint32_t> read_spirv;
+    ASSERT_TRUE(cache.Get(1, read_spirv));
+    ASSERT_EQ(spirv, read_spirv);
+    ASSERT_TRUE(cache.Get(2, read_spirv));
+    ASSERT_EQ(other_spirv, read_spirv);
+    // Indexed before the file was compacted under it, the newest copy of the first record now comes last
+    ASSERT_TRUE(attached_cache.Get(1, read_spirv));
+    ASSERT_EQ(spirv, read_spirv);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 The Khronos Group Inc.
+ * Copyright (c) 2024 Valve Corporation
+ * Copyright (c) 2024 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <atomic>
+#include <vector>
+
+#include "utils/thread_pool.h"
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce) {
+    vvl::ThreadPool pool(3);
+    std::vector<std::atomic<uint32_t>> visits(1000);
+    pool.ParallelFor(static_cast<uint32_t>(visits.size()), [&visits](uint32_t index) { visits[index]++; });
+    for (const auto &count : visits) {
+        ASSERT_EQ(count.load(), 1u);
+    }
+}
+
+TEST(ThreadPool, ParallelForWithoutWorkers) {
+    vvl::ThreadPool pool(0);
+    uint32_t sum = 0;
+    pool.ParallelFor(10, [&sum](uint32_t index) { sum += index; });
+    ASSERT_EQ(sum, 45u);
+}
+
+TEST(ThreadPool, DestructorRunsPostedTasks) {
+    std::atomic<uint32_t> done{0};
+    {
+        vvl::ThreadPool pool(2);
+        for (uint32_t i = 0; i < 64; ++i) {
+            pool.Post([&done]() { done++; });
+        }
+    }
+    ASSERT_EQ(done.load(), 64u);
+}
+
+TEST(ThreadPool, WaitIdle) {
+    vvl::ThreadPool pool(2);
+    std::atomic<uint32_t> done{0};
+    for (uint32_t i = 0; i < 64; ++i) {
+        pool.Post([&done]() { done++; });
+    }
+    pool.WaitIdle();
+    ASSERT_EQ(done.load(), 64u);
+
+    // Nothing queued, returns right away
+    pool.WaitIdle();
+}